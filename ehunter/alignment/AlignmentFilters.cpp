@@ -43,25 +43,25 @@ namespace ehunter
 {
 
 bool checkIfLocallyPlacedReadPair(
-    boost::optional<GraphAlignment> readAlignment, boost::optional<GraphAlignment> mateAlignment,
+    const boost::optional<AlignmentSummary>& readSummary, const boost::optional<AlignmentSummary>& mateSummary,
     int kMinNonRepeatAlignmentScore)
 {
     int nonRepeatAlignmentScore = 0;
 
-    if (readAlignment)
+    if (readSummary)
     {
-        nonRepeatAlignmentScore += scoreAlignmentToNonloopNodes(*readAlignment);
+        nonRepeatAlignmentScore += readSummary->scoreToNonloopNodes();
     }
 
-    if (mateAlignment)
+    if (mateSummary)
     {
-        nonRepeatAlignmentScore += scoreAlignmentToNonloopNodes(*mateAlignment);
+        nonRepeatAlignmentScore += mateSummary->scoreToNonloopNodes();
     }
 
     return nonRepeatAlignmentScore >= kMinNonRepeatAlignmentScore;
 }
 
-bool checkIfUpstreamAlignmentIsGood(NodeId nodeId, GraphAlignment alignment)
+bool checkIfUpstreamAlignmentIsGood(NodeId nodeId, const GraphAlignment& alignment)
 {
     const list<int> repeatNodeIndexes = alignment.getIndexesOfNode(nodeId);
 
@@ -84,7 +84,7 @@ bool checkIfUpstreamAlignmentIsGood(NodeId nodeId, GraphAlignment alignment)
     return score >= kScoreCutoff;
 }
 
-bool checkIfDownstreamAlignmentIsGood(NodeId nodeId, GraphAlignment alignment)
+bool checkIfDownstreamAlignmentIsGood(NodeId nodeId, const GraphAlignment& alignment)
 {
     const list<int> repeatNodeIndexes = alignment.getIndexesOfNode(nodeId);
 
@@ -27,6 +27,8 @@
 
 #include "graphalign/GraphAlignment.hh"
 
+#include "alignment/AlignmentSummary.hh"
+
 namespace ehunter
 {
 
@@ -36,20 +38,20 @@ namespace ehunter
  * The check is performed by verifying that the alignment score to non-repeat nodes (combined for both mates) is
  * sufficiently high.
  *
- * @param readAlignment: Alignment of a read
- * @param mateAlignment: Alignment of read's mate
+ * @param readSummary: Summary of the alignment of a read
+ * @param mateSummary: Summary of the alignment of read's mate
  * @param kMinNonRepeatAlignmentScore: Score threshold
  * @return true if the alignment score to non-repeat nodes exceeds the threshold
  */
 bool checkIfLocallyPlacedReadPair(
-    boost::optional<graphtools::GraphAlignment> readAlignment,
-    boost::optional<graphtools::GraphAlignment> mateAlignment, int kMinNonRepeatAlignmentScore);
+    const boost::optional<AlignmentSummary>& readSummary, const boost::optional<AlignmentSummary>& mateSummary,
+    int kMinNonRepeatAlignmentScore);
 
 // Checks if alignment upstream of a given node is high quality
-bool checkIfUpstreamAlignmentIsGood(graphtools::NodeId nodeId, graphtools::GraphAlignment alignment);
+bool checkIfUpstreamAlignmentIsGood(graphtools::NodeId nodeId, const graphtools::GraphAlignment& alignment);
 
 // Checks if alignment downstream of a given node is high quality
-bool checkIfDownstreamAlignmentIsGood(graphtools::NodeId nodeId, graphtools::GraphAlignment alignment);
+bool checkIfDownstreamAlignmentIsGood(graphtools::NodeId nodeId, const graphtools::GraphAlignment& alignment);
 
 bool checkIfPassesAlignmentFilters(const graphtools::GraphAlignment& alignment);
 
@@ -0,0 +1,203 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "alignment/AlignmentSummary.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include "graphalign/LinearAlignmentParameters.hh"
+
+using graphtools::GraphAlignment;
+using graphtools::NodeId;
+using graphtools::Operation;
+using graphtools::OperationType;
+
+namespace ehunter
+{
+
+const NodeId AlignmentSummary::kEndOfGraph = std::numeric_limits<NodeId>::max();
+
+AlignmentSummary::AlignmentSummary(const GraphAlignment& alignment)
+    : firstNodeId_(alignment.path().getNodeIdByIndex(0))
+    , startPosition_(alignment.path().startPosition())
+{
+    const graphtools::Graph& graph = *alignment.path().graphRawPtr();
+    nodeFeatures_.resize(graph.numNodes());
+
+    const int numIndexes = static_cast<int>(alignment.size());
+    cumulativeScores_.reserve(numIndexes + 1);
+    cumulativeIndels_.reserve(numIndexes + 1);
+    cumulativeMatches_.reserve(numIndexes + 1);
+    cumulativeScores_.push_back(0);
+    cumulativeIndels_.push_back(0);
+    cumulativeMatches_.push_back(0);
+
+    const LinearAlignmentParameters parameters;
+    for (int nodeIndex = 0; nodeIndex != numIndexes; ++nodeIndex)
+    {
+        int score = 0;
+        int numIndels = 0;
+        int numMatches = 0;
+        int referenceSpan = 0;
+        for (const Operation& operation : alignment[nodeIndex])
+        {
+            const int operationReferenceLength = operation.referenceLength();
+            const int operationQueryLength = operation.queryLength();
+            referenceSpan += operationReferenceLength;
+            queryLength_ += operationQueryLength;
+
+            switch (operation.type())
+            {
+            case OperationType::kMatch:
+                score += parameters.matchScore * operationReferenceLength;
+                numMatches += operationReferenceLength;
+                break;
+            case OperationType::kMismatch:
+                score += parameters.mismatchScore * operationReferenceLength;
+                break;
+            case OperationType::kInsertionToRef:
+                score += parameters.gapOpenScore * operationQueryLength;
+                numIndels += operationQueryLength;
+                break;
+            case OperationType::kDeletionFromRef:
+                score += parameters.gapOpenScore * operationReferenceLength;
+                numIndels += operationReferenceLength;
+                break;
+            default:
+                break;
+            }
+        }
+
+        const NodeId nodeId = alignment.getNodeIdByIndex(nodeIndex);
+        NodeFeatures& features = nodeFeatures_[nodeId];
+        ++features.numVisits;
+        features.referenceSpan += referenceSpan;
+        features.score += score;
+        if (features.firstIndex == -1)
+        {
+            features.firstIndex = nodeIndex;
+        }
+        features.lastIndex = nodeIndex;
+
+        cumulativeScores_.push_back(cumulativeScores_.back() + score);
+        cumulativeIndels_.push_back(cumulativeIndels_.back() + numIndels);
+        cumulativeMatches_.push_back(cumulativeMatches_.back() + numMatches);
+    }
+
+    for (NodeId nodeId = 0; nodeId != nodeFeatures_.size(); ++nodeId)
+    {
+        if (nodeFeatures_[nodeId].numVisits != 0 && !graph.hasEdge(nodeId, nodeId))
+        {
+            scoreToNonloopNodes_ += nodeFeatures_[nodeId].score;
+        }
+    }
+
+    const Operation& firstOperation = alignment.alignments().front().operations().front();
+    if (firstOperation.type() == OperationType::kSoftclip)
+    {
+        leftSoftclipLength_ = firstOperation.queryLength();
+    }
+
+    const Operation& lastOperation = alignment.alignments().back().operations().back();
+    if (lastOperation.type() == OperationType::kSoftclip)
+    {
+        rightSoftclipLength_ = lastOperation.queryLength();
+    }
+}
+
+const AlignmentSummary::NodeFeatures* AlignmentSummary::findNodeFeatures(NodeId nodeId) const
+{
+    return nodeId < nodeFeatures_.size() ? &nodeFeatures_[nodeId] : nullptr;
+}
+
+int AlignmentSummary::numVisitsToNode(NodeId nodeId) const
+{
+    const NodeFeatures* features = findNodeFeatures(nodeId);
+    return features ? features->numVisits : 0;
+}
+
+int AlignmentSummary::firstIndexOfNode(NodeId nodeId) const
+{
+    const NodeFeatures* features = findNodeFeatures(nodeId);
+    return features ? features->firstIndex : -1;
+}
+
+int AlignmentSummary::lastIndexOfNode(NodeId nodeId) const
+{
+    const NodeFeatures* features = findNodeFeatures(nodeId);
+    return features ? features->lastIndex : -1;
+}
+
+int AlignmentSummary::numVisitsToNodes(NodeId beginNodeId, NodeId endNodeId) const
+{
+    int numVisits = 0;
+    const NodeId clippedEndNodeId = std::min<NodeId>(endNodeId, nodeFeatures_.size());
+    for (NodeId nodeId = beginNodeId; nodeId < clippedEndNodeId; ++nodeId)
+    {
+        numVisits += nodeFeatures_[nodeId].numVisits;
+    }
+    return numVisits;
+}
+
+int AlignmentSummary::referenceSpanOnNodes(NodeId beginNodeId, NodeId endNodeId) const
+{
+    int referenceSpan = 0;
+    const NodeId clippedEndNodeId = std::min<NodeId>(endNodeId, nodeFeatures_.size());
+    for (NodeId nodeId = beginNodeId; nodeId < clippedEndNodeId; ++nodeId)
+    {
+        referenceSpan += nodeFeatures_[nodeId].referenceSpan;
+    }
+    return referenceSpan;
+}
+
+int AlignmentSummary::scoreOnNodes(NodeId beginNodeId, NodeId endNodeId) const
+{
+    int score = 0;
+    const NodeId clippedEndNodeId = std::min<NodeId>(endNodeId, nodeFeatures_.size());
+    for (NodeId nodeId = beginNodeId; nodeId < clippedEndNodeId; ++nodeId)
+    {
+        score += nodeFeatures_[nodeId].score;
+    }
+    return score;
+}
+
+int AlignmentSummary::scoreOfIndexes(int beginIndex, int endIndex) const
+{
+    return cumulativeScores_[endIndex] - cumulativeScores_[beginIndex];
+}
+
+int AlignmentSummary::numIndelsOfIndexes(int beginIndex, int endIndex) const
+{
+    return cumulativeIndels_[endIndex] - cumulativeIndels_[beginIndex];
+}
+
+int AlignmentSummary::numMatchesOfIndexes(int beginIndex, int endIndex) const
+{
+    return cumulativeMatches_[endIndex] - cumulativeMatches_[beginIndex];
+}
+
+bool AlignmentSummary::areVisitsToNodeConsecutive(NodeId nodeId) const
+{
+    const NodeFeatures* features = findNodeFeatures(nodeId);
+    return features && features->numVisits == features->lastIndex - features->firstIndex + 1;
+}
+
+}
@@ -0,0 +1,100 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graphalign/GraphAlignment.hh"
+#include "graphcore/Graph.hh"
+
+namespace ehunter
+{
+
+/// \brief Features of a graph alignment collected in a single pass over it
+///
+/// Read filters, variant classifiers, and locus statistics all look at the same alignments; sharing one summary keeps
+/// them from walking each alignment once per consumer. Scores are computed with the default linear alignment
+/// parameters, which is also the scoring scheme used to find consistent STR alignments.
+///
+class AlignmentSummary
+{
+public:
+    static const graphtools::NodeId kEndOfGraph;
+
+    explicit AlignmentSummary(const graphtools::GraphAlignment& alignment);
+
+    graphtools::NodeId firstNodeId() const { return firstNodeId_; }
+    int64_t startPosition() const { return startPosition_; }
+    int queryLength() const { return queryLength_; }
+    int numMatches() const { return cumulativeMatches_.back(); }
+    int leftSoftclipLength() const { return leftSoftclipLength_; }
+    int rightSoftclipLength() const { return rightSoftclipLength_; }
+
+    /// Score of the alignment to the nodes without self-loops
+    int scoreToNonloopNodes() const { return scoreToNonloopNodes_; }
+
+    int numVisitsToNode(graphtools::NodeId nodeId) const;
+
+    /// Indexes of the first and the last visit to the node along the path, or -1 if the node is not visited
+    int firstIndexOfNode(graphtools::NodeId nodeId) const;
+    int lastIndexOfNode(graphtools::NodeId nodeId) const;
+
+    /// Sums over the nodes with ids in the half-open range [beginNodeId, endNodeId); ids past the last node of the
+    /// graph are ignored, so kEndOfGraph can be used to cover all nodes downstream of a given one
+    int numVisitsToNodes(graphtools::NodeId beginNodeId, graphtools::NodeId endNodeId) const;
+    int referenceSpanOnNodes(graphtools::NodeId beginNodeId, graphtools::NodeId endNodeId) const;
+    int scoreOnNodes(graphtools::NodeId beginNodeId, graphtools::NodeId endNodeId) const;
+
+    /// Sums over the path indexes in the half-open range [beginIndex, endIndex)
+    int scoreOfIndexes(int beginIndex, int endIndex) const;
+    int numIndelsOfIndexes(int beginIndex, int endIndex) const;
+    int numMatchesOfIndexes(int beginIndex, int endIndex) const;
+
+    /// True if all visits to the node form a single run of consecutive path indexes
+    bool areVisitsToNodeConsecutive(graphtools::NodeId nodeId) const;
+
+private:
+    struct NodeFeatures
+    {
+        int numVisits = 0;
+        int referenceSpan = 0;
+        int score = 0;
+        int firstIndex = -1;
+        int lastIndex = -1;
+    };
+
+    const NodeFeatures* findNodeFeatures(graphtools::NodeId nodeId) const;
+
+    graphtools::NodeId firstNodeId_;
+    int64_t startPosition_;
+    int queryLength_ = 0;
+    int leftSoftclipLength_ = 0;
+    int rightSoftclipLength_ = 0;
+    int scoreToNonloopNodes_ = 0;
+
+    std::vector<NodeFeatures> nodeFeatures_;
+    std::vector<int> cumulativeScores_;
+    std::vector<int> cumulativeIndels_;
+    std::vector<int> cumulativeMatches_;
+};
+
+}
@@ -70,25 +70,26 @@ ClassifierOfAlignmentsToVariant::ClassifierOfAlignmentsToVariant(vector<NodeId>
 
 void ClassifierOfAlignmentsToVariant::classify(const graphtools::GraphAlignment& graphAlignment)
 {
-    bool pathStartsUpstream = false;
-    bool pathEndsDownstream = false;
+    classify(AlignmentSummary(graphAlignment));
+}
+
+void ClassifierOfAlignmentsToVariant::classify(const AlignmentSummary& summary)
+{
+    const bool pathStartsUpstream = summary.numVisitsToNodes(0, firstBundleNode_) != 0;
+    const bool pathEndsDownstream = summary.numVisitsToNodes(lastBundleNode_ + 1, AlignmentSummary::kEndOfGraph) != 0;
+
+    // The overlapped target node is the one visited last along the path
     bool pathOverlapsTargetNode = false;
     NodeId targetNodeOverlapped = kInvalidNodeId;
-
-    for (auto pathNode : graphAlignment.path().nodeIds())
+    int lastTargetNodeIndex = -1;
+    for (NodeId targetNode = firstBundleNode_; targetNode <= lastBundleNode_; ++targetNode)
     {
-        if (pathNode < firstBundleNode_)
-        {
-            pathStartsUpstream = true;
-        }
-        else if (lastBundleNode_ < pathNode)
-        {
-            pathEndsDownstream = true;
-        }
-        else if (firstBundleNode_ <= pathNode && pathNode <= lastBundleNode_)
+        const int lastIndex = summary.lastIndexOfNode(targetNode);
+        if (lastIndex > lastTargetNodeIndex)
         {
             pathOverlapsTargetNode = true;
-            targetNodeOverlapped = pathNode;
+            targetNodeOverlapped = targetNode;
+            lastTargetNodeIndex = lastIndex;
         }
     }
 
@@ -27,6 +27,7 @@
 #include "graphalign/GraphAlignment.hh"
 #include "graphcore/Graph.hh"
 
+#include "alignment/AlignmentSummary.hh"
 #include "core/CountTable.hh"
 
 namespace ehunter
@@ -40,6 +41,7 @@ public:
     ClassifierOfAlignmentsToVariant(std::vector<graphtools::NodeId> targetNodes);
 
     void classify(const graphtools::GraphAlignment& graphAlignment);
+    void classify(const AlignmentSummary& summary);
 
     const CountTable& countsOfReadsFlankingUpstream() const { return countsOfReadsFlankingUpstream_; }
     const CountTable& countsOfReadsFlankingDownstream() const { return countsOfReadsFlankingDownstream_; }
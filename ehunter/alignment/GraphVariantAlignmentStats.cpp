@@ -68,7 +68,12 @@ GraphVariantAlignmentStatsCalculator::GraphVariantAlignmentStatsCalculator(std::
 
 void GraphVariantAlignmentStatsCalculator::inspect(const GraphAlignment& alignment)
 {
-    switch (classify(alignment))
+    inspect(AlignmentSummary(alignment));
+}
+
+void GraphVariantAlignmentStatsCalculator::inspect(const AlignmentSummary& summary)
+{
+    switch (classify(summary))
     {
     case Flank::kLeft:
         ++numReadsSpanningLeftBreakpoint_;
@@ -86,31 +91,11 @@ void GraphVariantAlignmentStatsCalculator::inspect(const GraphAlignment& alignme
 }
 
 GraphVariantAlignmentStatsCalculator::Flank
-GraphVariantAlignmentStatsCalculator::classify(const GraphAlignment& alignment) const
+GraphVariantAlignmentStatsCalculator::classify(const AlignmentSummary& summary) const
 {
-    int leftFlankSpan = 0;
-    int variantSpan = 0;
-    int rightFlankSpan = 0;
-
-    for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.path().numNodes()); ++nodeIndex)
-    {
-        const auto node = alignment.path().getNodeIdByIndex(nodeIndex);
-        const auto& alignmentToNode = alignment.alignments().at(nodeIndex);
-        int nodeSpan = alignmentToNode.referenceLength();
-
-        if (node < firstVariantNode_)
-        {
-            leftFlankSpan += nodeSpan;
-        }
-        else if ((firstVariantNode_ <= node) && (node <= lastVariantNode_))
-        {
-            variantSpan += nodeSpan;
-        }
-        else if (lastVariantNode_ < node)
-        {
-            rightFlankSpan += nodeSpan;
-        }
-    }
+    const int leftFlankSpan = summary.referenceSpanOnNodes(0, firstVariantNode_);
+    const int variantSpan = summary.referenceSpanOnNodes(firstVariantNode_, lastVariantNode_ + 1);
+    const int rightFlankSpan = summary.referenceSpanOnNodes(lastVariantNode_ + 1, AlignmentSummary::kEndOfGraph);
 
     const bool supportsLeftBreakpoint = (leftFlankSpan >= minSpan_) && (variantSpan + rightFlankSpan >= minSpan_);
 
@@ -28,6 +28,8 @@
 #include "graphalign/GraphAlignment.hh"
 #include "graphcore/Graph.hh"
 
+#include "alignment/AlignmentSummary.hh"
+
 namespace ehunter
 {
 
@@ -54,6 +56,7 @@ public:
     explicit GraphVariantAlignmentStatsCalculator(std::vector<graphtools::NodeId> variantNodes);
 
     void inspect(const graphtools::GraphAlignment& alignment);
+    void inspect(const AlignmentSummary& summary);
     GraphVariantAlignmentStats getStats() const;
 
 private:
@@ -65,7 +68,7 @@ private:
         kNeither
     };
 
-    Flank classify(const graphtools::GraphAlignment& alignment) const;
+    Flank classify(const AlignmentSummary& summary) const;
 
     std::vector<graphtools::NodeId> variantNodes_;
     graphtools::NodeId firstVariantNode_;
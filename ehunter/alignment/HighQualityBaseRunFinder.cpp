@@ -29,54 +29,56 @@ using std::string;
 namespace ehunter
 {
 
-template <typename Iter> static int countGoodBases(Iter begin, Iter end)
+// Computes the probability of a run from its base counts exactly as it was computed when each run was rescanned, so
+// that the change point chosen does not depend on the order of floating point operations
+static double calculateBaseRunProb(double goodBaseProb, int numGoodBasesInRun, int numBadBasesInRun)
+{
+    return numGoodBasesInRun * goodBaseProb + numBadBasesInRun * (1.0 - goodBaseProb);
+}
+
+// Finds the change point maximizing the combined probability of the two runs it separates in a single pass over the
+// bases: the base counts of the first run are accumulated as the change point advances and the counts of the second run
+// are derived from the totals
+template <typename Iter>
+static Iter findTopChangePoint(double probOfGoodBaseInFirstRun, double probOfGoodBaseInSecondRun, Iter start, Iter end)
 {
     int numGoodBases = 0;
-    for (; begin != end; ++begin)
+    for (auto baseIter = start; baseIter != end; ++baseIter)
     {
-        if (isupper(*begin))
+        if (isupper(*baseIter))
         {
             ++numGoodBases;
         }
     }
+    const int numBadBases = static_cast<int>(end - start) - numGoodBases;
 
-    return numGoodBases;
-}
-
-template <typename Iter> static double calculateBaseRunProb(double goodBaseProb, Iter begin, Iter end)
-{
-    const int runLength = end - begin;
-    const int numGoodBasesInRun = countGoodBases(begin, end);
-    const int numBadBasesInRun = runLength - numGoodBasesInRun;
-    return numGoodBasesInRun * goodBaseProb + numBadBasesInRun * (1.0 - goodBaseProb);
-}
-
-template <typename Iter>
-static double calculateRunProbability(
-    double probOfGoodBaseInFirstRun, double probOfGoodBaseInSecondRun, Iter start, Iter changePoint, Iter end)
-{
-    const double firstRunProb = calculateBaseRunProb(probOfGoodBaseInFirstRun, start, changePoint);
-    const double secondRunProb = calculateBaseRunProb(probOfGoodBaseInSecondRun, changePoint, end);
-
-    return firstRunProb + secondRunProb;
-}
-
-template <typename Iter>
-static Iter findTopChangePoint(double probOfGoodBaseInFirstRun, double probOfGoodBaseInSecondRun, Iter start, Iter end)
-{
     double topRunProb = 0;
     auto topChangePoint = start;
 
+    int numGoodBasesInFirstRun = 0;
+    int numBadBasesInFirstRun = 0;
     for (auto changePoint = start; changePoint != end; ++changePoint)
     {
         const double currentRunProb
-            = calculateRunProbability(probOfGoodBaseInFirstRun, probOfGoodBaseInSecondRun, start, changePoint, end);
+            = calculateBaseRunProb(probOfGoodBaseInFirstRun, numGoodBasesInFirstRun, numBadBasesInFirstRun)
+            + calculateBaseRunProb(
+                  probOfGoodBaseInSecondRun, numGoodBases - numGoodBasesInFirstRun,
+                  numBadBases - numBadBasesInFirstRun);
 
         if (topRunProb < currentRunProb)
         {
             topRunProb = currentRunProb;
             topChangePoint = changePoint;
         }
+
+        if (isupper(*changePoint))
+        {
+            ++numGoodBasesInFirstRun;
+        }
+        else
+        {
+            ++numBadBasesInFirstRun;
+        }
     }
 
     return topChangePoint;
@@ -32,6 +32,8 @@ using StringIterPair = std::pair<std::string::const_iterator, std::string::const
 /**
  * Searches for the first sufficiently-long run of high-quality bases
  *
+ * High-quality bases are upper-case. The search takes time linear in the length of the query.
+ *
  * @param query: any query sequence
  * @param probOfGoodBaseInBadRun: probability of observing a high-quality base in a low quality stretch of bases
  * @param probOfGoodBaseInGoodRun: probability of observing a high-quality base in a good quality stretch of bases
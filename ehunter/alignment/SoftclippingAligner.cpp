@@ -33,30 +33,39 @@ namespace ehunter
 {
 
 SoftclippingAligner::SoftclippingAligner(
-    const Graph* graphPtr, int kmerLenForAlignment, int paddingLength, int seedAffixTrimLength)
+    const Graph* graphPtr, int kmerLenForAlignment, int paddingLength, int seedAffixTrimLength,
+    bool trimLowQualityEnds)
     : aligner_(graphPtr, kmerLenForAlignment, paddingLength, seedAffixTrimLength)
+    , kmerLenForAlignment_(kmerLenForAlignment)
+    , trimLowQualityEnds_(trimLowQualityEnds)
 {
 }
 
 list<GraphAlignment> SoftclippingAligner::align(const string& query, graphtools::AlignerSelector& alignerSelector) const
 {
-    /*
-    HighQualityBaseRunFinder goodBaseFinder(6, 2, query.size() / 2);
-    const auto goodBasesRange = goodBaseFinder.find(query);
-    const auto goodBases = string(goodBasesRange.first, goodBasesRange.second);
+    if (!trimLowQualityEnds_)
+    {
+        return aligner_.align(query, alignerSelector);
+    }
+
+    const auto goodBasesRange = findHighQualityBaseRun(query);
+    const int numBasesTrimmedFromLeft = goodBasesRange.first - query.begin();
+    const int numBasesTrimmedFromRight = query.end() - goodBasesRange.second;
+    const int numGoodBases = goodBasesRange.second - goodBasesRange.first;
 
-    int numBasesTrimmedFromLeft = goodBasesRange.first - query.begin();
-    int numBasesTrimmedFromRight = query.end() - goodBasesRange.second;
+    const bool isTrimmed = numBasesTrimmedFromLeft != 0 || numBasesTrimmedFromRight != 0;
+    if (!isTrimmed || numGoodBases < kmerLenForAlignment_)
+    {
+        return aligner_.align(query, alignerSelector);
+    }
 
     list<GraphAlignment> extendedAlignments;
-    for (const auto& alignment : aligner_.align(goodBases))
+    for (const auto& alignment : aligner_.align(string(goodBasesRange.first, goodBasesRange.second), alignerSelector))
     {
-        const auto extendedAlignment = extendWithSoftclip(alignment, numBasesTrimmedFromLeft, numBasesTrimmedFromRight);
-        extendedAlignments.push_back(extendedAlignment);
+        extendedAlignments.push_back(extendWithSoftclip(alignment, numBasesTrimmedFromLeft, numBasesTrimmedFromRight));
     }
-    */
 
-    return aligner_.align(query, alignerSelector);
+    return extendedAlignments;
 }
 
 }
@@ -31,16 +31,25 @@
 namespace ehunter
 {
 
+/// \brief Graph aligner that can restrict alignment to the high-quality core of each query
+///
+/// When trimming is enabled, low-quality (lower-case) ends of a query located by findHighQualityBaseRun are removed
+/// before alignment and re-attached to the resulting alignments as softclips. Queries whose core is shorter than the
+/// kmer length used for seeding are aligned in full.
+///
 class SoftclippingAligner
 {
 public:
     SoftclippingAligner(
-        const graphtools::Graph* graphPtr, int kmerLenForAlignment, int paddingLength, int seedAffixTrimLength);
+        const graphtools::Graph* graphPtr, int kmerLenForAlignment, int paddingLength, int seedAffixTrimLength,
+        bool trimLowQualityEnds = false);
     std::list<graphtools::GraphAlignment>
     align(const std::string& query, graphtools::AlignerSelector& alignerSelector) const;
 
 private:
     graphtools::GappedGraphAligner aligner_;
+    int kmerLenForAlignment_;
+    bool trimLowQualityEnds_;
 };
 
 }
@@ -24,47 +24,36 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+
 // clang-format off
 // Note that spdlog.h must be included before ostr.h
 #include "spdlog/spdlog.h"
 //#include "thirdparty/spdlog/include/spdlog/fmt/ostr.h"
 // clang-format on
 
+#include "spdlog/sinks/stdout_color_sinks.h"
+
 #include "app/Version.hh"
 #include "core/Parameters.hh"
-#include "io/BamletWriter.hh"
 #include "io/CatalogLoading.hh"
-#include "io/JsonWriter.hh"
 #include "io/ParameterLoading.hh"
 #include "io/SampleStats.hh"
-#include "io/VcfWriter.hh"
-#include "locus/VariantFindings.hh"
-#include "sample/HtsSeekingSampleAnalysis.hh"
+#include "sample/AnalysisServer.hh"
 #include "sample/HtsStreamingSampleAnalysis.hh"
+#include "sample/SampleAnalysis.hh"
 
 namespace spd = spdlog;
 
 using namespace ehunter;
 
-template <typename T> static void writeToFile(std::string fileName, T streamable)
-{
-    std::ofstream out;
-
-    out.open(fileName.c_str());
-    if (!out.is_open())
-    {
-        throw std::runtime_error("Failed to open " + fileName + " for writing (" + strerror(errno) + ")");
-    }
-
-    out << streamable;
-}
-
 void setLogLevel(LogLevel logLevel)
 {
     switch (logLevel)
@@ -87,14 +76,31 @@ void setLogLevel(LogLevel logLevel)
     }
 }
 
+// An alignment cache can be genotyped without its alignment file, in which case the contigs of the reference are used
+ReferenceContigInfo
+extractSampleContigInfo(const InputPaths& inputPaths, const htshelpers::HtsFileStreamer* readStreamer)
+{
+    if (readStreamer)
+    {
+        return readStreamer->contigInfo();
+    }
+
+    const bool isAlignmentFileAbsent = inputPaths.alignmentCache() && !isURL(inputPaths.htsFile())
+        && !boost::filesystem::exists(inputPaths.htsFile());
+    if (isAlignmentFileAbsent)
+    {
+        return extractFastaContigInfo(inputPaths.reference());
+    }
+
+    return extractReferenceContigInfo(inputPaths.htsFile());
+}
+
 int main(int argc, char** argv)
 {
     spdlog::set_pattern("%Y-%m-%dT%H:%M:%S,[%v]");
 
     try
     {
-        spdlog::info("Starting {}", kProgramVersion);
-
         auto optionalProgramParameters = tryLoadingProgramParameters(argc, argv);
         if (!optionalProgramParameters)
         {
@@ -102,53 +108,43 @@ int main(int argc, char** argv)
         }
         const ProgramParameters& params = *optionalProgramParameters;
 
-        setLogLevel(params.logLevel());
-
-        const SampleParameters& sampleParams = params.sample();
+        // The standard output of a server is reserved for job responses
+        if (params.server)
+        {
+            spdlog::set_default_logger(spdlog::stderr_color_mt("server"));
+        }
 
-        spdlog::info("Analyzing sample {}", sampleParams.id());
+        spdlog::info("Starting {}", kProgramVersion);
+        setLogLevel(params.logLevel());
+        graphtools::setValidationLevel(params.alignmentValidation);
 
         const InputPaths& inputPaths = params.inputPaths();
 
+        // Input that can only be read once is opened up front so that its header provides the reference contigs
+        std::unique_ptr<htshelpers::HtsFileStreamer> readStreamer;
+        if (isStreamOnlyPath(inputPaths.htsFile()))
+        {
+            spdlog::info("Opening alignment stream {}", inputPaths.htsFile());
+            readStreamer = openAlignmentStream(inputPaths, params.threadCount);
+        }
+
         spdlog::info("Initializing reference {}", inputPaths.reference());
-        FastaReference reference(inputPaths.reference(), extractReferenceContigInfo(inputPaths.htsFile()));
+        FastaReference reference(inputPaths.reference(), extractSampleContigInfo(inputPaths, readStreamer.get()));
 
         spdlog::info("Loading variant catalog from disk {}", inputPaths.catalog());
         const HeuristicParameters& heuristicParams = params.heuristics();
-        const RegionCatalog regionCatalog = loadLocusCatalogFromDisk(inputPaths.catalog(), heuristicParams, reference);
+        const RegionCatalog regionCatalog = loadLocusCatalogFromDisk(
+            inputPaths.catalog(), heuristicParams, reference, params.locusSelection());
 
-        const OutputPaths& outputPaths = params.outputPaths();
-
-        locus::AlignWriterPtr bamletWriter;
-        if (params.disableBamletOutput)
+        if (params.server)
         {
-            bamletWriter.reset(new graphtools::BlankAlignmentWriter());
+            runAnalysisServer(params, reference, regionCatalog, std::cin, std::cout);
         }
         else
         {
-            bamletWriter.reset(new BamletWriter(outputPaths.bamlet(), reference.contigInfo(), regionCatalog));
+            spdlog::info("Analyzing sample {}", params.sample().id());
+            analyzeSample(params, reference, regionCatalog, readStreamer.get());
         }
-
-        SampleFindings sampleFindings;
-        if (params.analysisMode() == AnalysisMode::kSeeking)
-        {
-            spdlog::info("Running sample analysis in seeking mode");
-            sampleFindings = htsSeekingSampleAnalysis(
-                inputPaths, sampleParams.sex(), heuristicParams, params.threadCount, regionCatalog, bamletWriter);
-        }
-        else
-        {
-            spdlog::info("Running sample analysis in streaming mode");
-            sampleFindings = htsStreamingSampleAnalysis(
-                inputPaths, sampleParams.sex(), heuristicParams, params.threadCount, regionCatalog, bamletWriter);
-        }
-
-        spdlog::info("Writing output to disk");
-        VcfWriter vcfWriter(sampleParams.id(), reference, regionCatalog, sampleFindings);
-        writeToFile(outputPaths.vcf(), vcfWriter);
-
-        JsonWriter jsonWriter(sampleParams, reference.contigInfo(), regionCatalog, sampleFindings);
-        writeToFile(outputPaths.json(), jsonWriter);
     }
     catch (const std::exception& e)
     {
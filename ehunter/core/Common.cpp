@@ -25,6 +25,8 @@
 
 #include <regex>
 
+#include <boost/filesystem.hpp>
+
 using std::string;
 
 namespace ehunter
@@ -105,4 +107,29 @@ bool isURL(const std::string& path)
     return std::regex_match(path, url_regex);
 }
 
+bool isStreamOnlyPath(const std::string& path)
+{
+    if (path == kStandardInputPath)
+    {
+        return true;
+    }
+
+    boost::system::error_code errorCode;
+    return boost::filesystem::status(path, errorCode).type() == boost::filesystem::fifo_file;
+}
+
+uint64_t computeStableHash(const std::string& data)
+{
+    const uint64_t kOffsetBasis = 14695981039346656037ull;
+    const uint64_t kPrime = 1099511628211ull;
+
+    uint64_t hash = kOffsetBasis;
+    for (const char character : data)
+    {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= kPrime;
+    }
+    return hash;
+}
+
 }
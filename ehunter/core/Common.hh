@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <ostream>
 #include <sstream>
@@ -55,6 +56,9 @@ enum class ChromType
 
 Sex decodeSampleSex(const std::string& encoding);
 
+// Sex encoding requesting the sex of the sample to be inferred from its reads
+const std::string kInferredSexEncoding = "auto";
+
 enum class AlleleCount
 {
     kOne = 1,
@@ -121,4 +125,19 @@ std::ostream& operator<<(std::ostream& out, NumericInterval numericInterval);
 ///
 bool isURL(const std::string& path);
 
+/// Path of the alignment file denoting the standard input
+const std::string kStandardInputPath = "-";
+
+/// \brief Returns true if the path refers to input that can only be read once from start to end
+///
+/// This is the case for the standard input and named pipes
+///
+bool isStreamOnlyPath(const std::string& path);
+
+/// \brief 64-bit FNV-1a hash of the data
+///
+/// Unlike std::hash, the value does not depend on the platform or the build, so it can be stored in files
+///
+uint64_t computeStableHash(const std::string& data);
+
 }
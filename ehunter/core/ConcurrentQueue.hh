@@ -22,19 +22,33 @@
 #pragma once
 
 #include <condition_variable>
+#include <cstddef>
 #include <mutex>
 #include <queue>
 
 namespace ehunter
 {
 
+/// \brief Thread-safe FIFO queue
+///
+/// If the queue is constructed with a non-zero capacity, push blocks while the queue is full
+///
 template <typename T> class ConcurrentQueue
 {
 public:
+    explicit ConcurrentQueue(std::size_t capacity = 0)
+        : capacity_(capacity)
+    {
+    }
+
     void push(T const& data)
     {
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::unique_lock<std::mutex> lock(mutex_);
+            while ((capacity_ != 0) && (queue_.size() >= capacity_))
+            {
+                notFullCv_.wait(lock);
+            }
             queue_.push(data);
         }
         cv_.notify_one();
@@ -48,20 +62,24 @@ public:
 
     void pop(T& value)
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        while (queue_.empty())
         {
-            cv_.wait(lock);
-        }
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (queue_.empty())
+            {
+                cv_.wait(lock);
+            }
 
-        value = queue_.front();
-        queue_.pop();
+            value = queue_.front();
+            queue_.pop();
+        }
+        notFullCv_.notify_one();
     }
 
 private:
+    std::size_t capacity_;
     std::queue<T> queue_;
     mutable std::mutex mutex_;
     std::condition_variable cv_;
+    std::condition_variable notFullCv_;
 };
-
 }
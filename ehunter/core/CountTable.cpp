@@ -22,6 +22,8 @@
 
 #include "core/CountTable.hh"
 
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 
 using std::string;
@@ -31,22 +33,80 @@ using std::vector;
 namespace ehunter
 {
 
+CountTable::const_iterator::const_iterator(const CountTable* table, size_t index)
+    : table_(table)
+    , index_(index)
+{
+    skipZeroCounts();
+}
+
+CountTable::const_iterator& CountTable::const_iterator::operator++()
+{
+    ++index_;
+    skipZeroCounts();
+    return *this;
+}
+
+CountTable::const_iterator CountTable::const_iterator::operator++(int)
+{
+    const_iterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+void CountTable::const_iterator::skipZeroCounts()
+{
+    const vector<int32_t>& counts = table_->counts_;
+    while (index_ < counts.size() && counts[index_] == 0)
+    {
+        ++index_;
+    }
+
+    if (index_ < counts.size())
+    {
+        elementAndCount_ = std::make_pair(table_->firstElement_ + static_cast<int32_t>(index_), counts[index_]);
+    }
+}
+
+CountTable::CountTable(const std::map<int32_t, int32_t>& elementsToCounts)
+{
+    if (!elementsToCounts.empty())
+    {
+        reserveElement(elementsToCounts.begin()->first);
+        reserveElement(elementsToCounts.rbegin()->first);
+    }
+
+    for (const auto& elementAndCount : elementsToCounts)
+    {
+        counts_[elementAndCount.first - firstElement_] = elementAndCount.second;
+    }
+}
+
+void CountTable::clear()
+{
+    firstElement_ = 0;
+    counts_.clear();
+}
+
 int32_t CountTable::countOf(int32_t element) const
 {
-    if (elementsToCounts_.find(element) == elementsToCounts_.end())
+    const int64_t offset = static_cast<int64_t>(element) - firstElement_;
+    if (offset < 0 || offset >= static_cast<int64_t>(counts_.size()))
     {
         return 0;
     }
-    return elementsToCounts_.at(element);
+    return counts_[offset];
 }
 
 void CountTable::setCountOf(int32_t element, int32_t count)
 {
-    elementsToCounts_[element] = count;
-    if (count == 0)
+    if (count == 0 && countOf(element) == 0)
     {
-        elementsToCounts_.erase(element);
+        return;
     }
+
+    reserveElement(element);
+    counts_[element - firstElement_] = count;
 }
 
 void CountTable::incrementCountOf(int32_t element, int32_t increment)
@@ -56,43 +116,98 @@ void CountTable::incrementCountOf(int32_t element, int32_t increment)
         throw std::logic_error("CountTables require positive increments");
     }
 
-    elementsToCounts_[element] += increment;
+    reserveElement(element);
+    counts_[element - firstElement_] += increment;
 }
 
 vector<int32_t> CountTable::getElementsWithNonzeroCounts() const
 {
     vector<int32_t> elements;
-    for (const auto& element_count : elementsToCounts_)
+    for (const auto& elementAndCount : *this)
     {
-        elements.push_back(element_count.first);
+        elements.push_back(elementAndCount.first);
     }
 
     return elements;
 }
 
+int32_t CountTable::countOfElementsUpTo(int32_t upperBound) const
+{
+    const int64_t endOffset = std::min(
+        static_cast<int64_t>(upperBound) - firstElement_ + 1, static_cast<int64_t>(counts_.size()));
+
+    int32_t totalCount = 0;
+    for (int64_t offset = 0; offset < endOffset; ++offset)
+    {
+        totalCount += counts_[offset];
+    }
+
+    return totalCount;
+}
+
 CountTable& CountTable::operator=(const CountTable& other)
 {
     if (this != &other)
     {
-        elementsToCounts_ = other.elementsToCounts_;
+        firstElement_ = other.firstElement_;
+        counts_ = other.counts_;
     }
 
     return *this;
 }
 
+bool CountTable::operator==(const CountTable& other) const
+{
+    const_iterator iter = begin();
+    const_iterator otherIter = other.begin();
+    for (; iter != end() && otherIter != other.end(); ++iter, ++otherIter)
+    {
+        if (*iter != *otherIter)
+        {
+            return false;
+        }
+    }
+
+    return iter == end() && otherIter == other.end();
+}
+
+void CountTable::reserveElement(int32_t element)
+{
+    if (counts_.empty())
+    {
+        firstElement_ = element;
+        counts_.push_back(0);
+        return;
+    }
+
+    const int64_t offset = static_cast<int64_t>(element) - firstElement_;
+    if (offset < 0)
+    {
+        // Extending the front by at least the current size keeps repeated extensions amortized constant time
+        const int64_t newFirstElement = std::max(
+            static_cast<int64_t>(firstElement_) - std::max(-offset, static_cast<int64_t>(counts_.size())),
+            static_cast<int64_t>(std::numeric_limits<int32_t>::min()));
+        counts_.insert(counts_.begin(), firstElement_ - newFirstElement, 0);
+        firstElement_ = static_cast<int32_t>(newFirstElement);
+    }
+    else if (offset >= static_cast<int64_t>(counts_.size()))
+    {
+        counts_.resize(offset + 1, 0);
+    }
+}
+
 std::ostream& operator<<(std::ostream& out, const CountTable& count_table)
 {
     string encoding;
 
-    for (int32_t element : count_table.getElementsWithNonzeroCounts())
+    for (const auto& elementAndCount : count_table)
     {
-
         if (!encoding.empty())
         {
             encoding += ", ";
         }
 
-        encoding += "(" + to_string(element) + ", " + to_string(count_table.countOf(element)) + ")";
+        encoding += "(" + to_string(elementAndCount.first) + ", " + to_string(elementAndCount.second) + ")";
     }
 
     if (encoding.empty())
@@ -114,9 +229,10 @@ CountTable collapseTopElements(const CountTable& countTable, int upperBound)
 
     CountTable truncatedTable;
 
-    for (auto element : countTable.getElementsWithNonzeroCounts())
+    for (const auto& elementAndCount : countTable)
     {
-        auto count = countTable.countOf(element);
+        const int32_t element = elementAndCount.first;
+        const int32_t count = elementAndCount.second;
 
         if (element < upperBound)
         {
@@ -23,38 +23,79 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace ehunter
 {
 
+/// \brief Counts of integer elements such as repeat sizes or node ids
+///
+/// Counts are stored in a contiguous array indexed by the offset of an element from the smallest stored element, so
+/// the table is intended for elements spanning a compact range. Elements with zero counts are never reported.
+///
 class CountTable
 {
 public:
-    using const_iterator = std::map<int32_t, int32_t>::const_iterator;
-    const_iterator begin() const { return elementsToCounts_.begin(); }
-    const_iterator end() const { return elementsToCounts_.end(); }
+    /// Iterates over (element, count) pairs of elements with nonzero counts in increasing order of elements
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<int32_t, int32_t>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator(const CountTable* table, size_t index);
+
+        reference operator*() const { return elementAndCount_; }
+        pointer operator->() const { return &elementAndCount_; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        void skipZeroCounts();
+
+        const CountTable* table_;
+        size_t index_;
+        value_type elementAndCount_;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, counts_.size()); }
 
     CountTable() = default;
-    explicit CountTable(std::map<int32_t, int32_t> elementsToCounts)
-        : elementsToCounts_(std::move(elementsToCounts)) {};
+    explicit CountTable(const std::map<int32_t, int32_t>& elementsToCounts);
     CountTable(const CountTable& other) = default;
 
-    void clear() { elementsToCounts_.clear(); }
+    void clear();
 
     int32_t countOf(int32_t element) const;
     void incrementCountOf(int32_t element, int32_t increment = 1);
     void setCountOf(int32_t element, int32_t count);
     std::vector<int32_t> getElementsWithNonzeroCounts() const;
 
+    /// Sum of the counts of all elements not exceeding the given bound
+    int32_t countOfElementsUpTo(int32_t upperBound) const;
+
     CountTable& operator=(const CountTable& other);
-    bool operator==(const CountTable& other) const { return elementsToCounts_ == other.elementsToCounts_; }
+    bool operator==(const CountTable& other) const;
 
 private:
-    std::map<int32_t, int32_t> elementsToCounts_;
+    /// Extends the stored range of elements to include the given element
+    void reserveElement(int32_t element);
+
+    int32_t firstElement_ = 0;
+    std::vector<int32_t> counts_;
 };
 
 std::ostream& operator<<(std::ostream& out, const CountTable& count_table);
@@ -157,5 +157,15 @@ ReferenceContigInfo decodeContigInfo(bam_hdr_t* htsHeaderPtr)
     return ReferenceContigInfo(contigNamesAndSizes);
 }
 
+bool isCoordinateSorted(bam_hdr_t* htsHeaderPtr)
+{
+    kstring_t sortOrder = { 0, 0, nullptr };
+    const bool isSortOrderFound = sam_hdr_find_tag_hd(htsHeaderPtr, "SO", &sortOrder) == 0;
+    const bool isSortedByCoordinate = isSortOrderFound && string(sortOrder.s) == "coordinate";
+    free(sortOrder.s);
+
+    return isSortedByCoordinate;
+}
+
 } // namespace htshelpers
 }
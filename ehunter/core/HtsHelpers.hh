@@ -42,6 +42,9 @@ bool isPrimaryAlignment(bam1_t* htsAlignPtr);
 Read decodeRead(bam1_t* htsAlignPtr);
 ReferenceContigInfo decodeContigInfo(bam_hdr_t* htsHeaderPtr);
 
+/// True if the header declares the alignment file to be sorted by coordinate (@HD SO:coordinate)
+bool isCoordinateSorted(bam_hdr_t* htsHeaderPtr);
+
 } // namespace htshelpers
 
 }
@@ -31,15 +31,49 @@ using graphtools::GraphAlignment;
 namespace ehunter
 {
 
+namespace
+{
+// Local depths are capped at this multiple of the index depth
+const double kMaxPlausibleDepthRatio = 100;
+}
+
+double reconcileLocusDepth(double localDepth, double indexDepth)
+{
+    if (indexDepth <= 0)
+    {
+        return localDepth;
+    }
+
+    return std::min(localDepth, kMaxPlausibleDepthRatio * indexDepth);
+}
+
+void LocusStats::setIndexDepth(double indexDepth)
+{
+    indexDepth_ = indexDepth;
+    depth_ = reconcileLocusDepth(localDepth_, indexDepth);
+}
+
+void LocusStats::useIndexDepth(double indexDepth)
+{
+    indexDepth_ = indexDepth;
+    depth_ = indexDepth;
+}
+
 bool LocusStats::operator==(const LocusStats& other) const
 {
     return alleleCount_ == other.alleleCount_ && meanReadLen_ == other.meanReadLen_
-        && medianFragLen_ == other.medianFragLen_ && depth_ == other.depth_;
+        && medianFragLen_ == other.medianFragLen_ && depth_ == other.depth_ && localDepth_ == other.localDepth_
+        && indexDepth_ == other.indexDepth_;
 }
 
 std::ostream& operator<<(std::ostream& out, const LocusStats& stats)
 {
-    out << "LocusStats(meanReadLength=" << stats.meanReadLength() << ", depth=" << stats.depth() << ")";
+    out << "LocusStats(meanReadLength=" << stats.meanReadLength() << ", depth=" << stats.depth();
+    if (stats.indexDepth())
+    {
+        out << ", localDepth=" << stats.localDepth() << ", indexDepth=" << *stats.indexDepth();
+    }
+    out << ")";
     return out;
 }
 
@@ -56,14 +90,21 @@ LocusStatsCalculator::LocusStatsCalculator(ChromType chromType, const graphtools
 
 void LocusStatsCalculator::inspect(const GraphAlignment& readAlign, const GraphAlignment& mateAlign)
 {
-    recordReadLen(readAlign);
-    recordReadLen(mateAlign);
-    recordFragLen(readAlign, mateAlign);
+    inspect(AlignmentSummary(readAlign), AlignmentSummary(mateAlign));
+}
+
+void LocusStatsCalculator::inspect(const AlignmentSummary& readSummary, const AlignmentSummary& mateSummary)
+{
+    recordReadLen(readSummary);
+    recordReadLen(mateSummary);
+    recordFragLen(readSummary, mateSummary);
 }
 
 void LocusStatsCalculator::inspectRead(const GraphAlignment& readAlign) { recordReadLen(readAlign); }
 
-static AlleleCount determineExpectedAlleleCount(ChromType chromType, Sex sex)
+void LocusStatsCalculator::inspectRead(const AlignmentSummary& readSummary) { recordReadLen(readSummary); }
+
+AlleleCount determineExpectedAlleleCount(ChromType chromType, Sex sex)
 {
     switch (chromType)
     {
@@ -111,10 +152,19 @@ void LocusStatsCalculator::recordReadLen(const GraphAlignment& readAlign)
     }
 }
 
-void LocusStatsCalculator::recordFragLen(const GraphAlignment& readAlign, const GraphAlignment& mateAlign)
+void LocusStatsCalculator::recordReadLen(const AlignmentSummary& readSummary)
+{
+    const graphtools::NodeId firstNode = readSummary.firstNodeId();
+    if (firstNode == leftFlankId_ || firstNode == rightFlankId_)
+    {
+        readLengthAccumulator_(readSummary.queryLength());
+    }
+}
+
+void LocusStatsCalculator::recordFragLen(const AlignmentSummary& readSummary, const AlignmentSummary& mateSummary)
 {
-    const auto readStartNode = readAlign.path().getNodeIdByIndex(0);
-    const auto mateStartNode = mateAlign.path().getNodeIdByIndex(0);
+    const auto readStartNode = readSummary.firstNodeId();
+    const auto mateStartNode = mateSummary.firstNodeId();
     const bool matesStartOnLeftFlank = readStartNode == leftFlankId_ && mateStartNode == leftFlankId_;
     const bool matesStartOnRightFlank = readStartNode == rightFlankId_ && mateStartNode == rightFlankId_;
 
@@ -123,11 +173,11 @@ void LocusStatsCalculator::recordFragLen(const GraphAlignment& readAlign, const
         return;
     }
 
-    const int readStart = readAlign.path().startPosition();
-    const int readEnd = readStart + static_cast<int>(readAlign.queryLength());
+    const int readStart = readSummary.startPosition();
+    const int readEnd = readStart + readSummary.queryLength();
 
-    const int mateStart = mateAlign.path().startPosition();
-    const int mateEnd = mateStart + static_cast<int>(mateAlign.queryLength());
+    const int mateStart = mateSummary.startPosition();
+    const int mateEnd = mateStart + mateSummary.queryLength();
 
     if (readEnd < mateEnd)
     {
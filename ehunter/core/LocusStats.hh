@@ -27,10 +27,12 @@
 
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics.hpp>
+#include <boost/optional.hpp>
 
 #include "graphalign/GraphAlignment.hh"
 #include "graphcore/Graph.hh"
 
+#include "alignment/AlignmentSummary.hh"
 #include "core/Common.hh"
 #include "core/GenomicRegion.hh"
 #include "core/Reference.hh"
@@ -47,14 +49,23 @@ public:
         , meanReadLen_(meanReadLen)
         , medianFragLen_(medianFragLen)
         , depth_(depth)
+        , localDepth_(depth)
     {
     }
 
     AlleleCount alleleCount() const { return alleleCount_; }
     int meanReadLength() const { return meanReadLen_; }
     int medianFragLength() const { return medianFragLen_; }
+    /// Depth used for genotyping
     double depth() const { return depth_; }
-    void setDepth(double depth) { depth_ = depth; }
+    /// Depth estimated from the reads at the locus
+    double localDepth() const { return localDepth_; }
+    /// Depth estimated from the alignment file index, if one was provided
+    const boost::optional<double>& indexDepth() const { return indexDepth_; }
+    /// Record the index-based depth and cap the local depth with it (see reconcileLocusDepth)
+    void setIndexDepth(double indexDepth);
+    /// Record the index-based depth and genotype with it in place of the local depth
+    void useIndexDepth(double indexDepth);
 
     bool operator==(const LocusStats& other) const;
 
@@ -63,10 +74,24 @@ private:
     int meanReadLen_;
     int medianFragLen_;
     double depth_;
+    double localDepth_;
+    boost::optional<double> indexDepth_;
 };
 
 std::ostream& operator<<(std::ostream& out, const LocusStats& stats);
 
+/// Number of alleles expected at loci on the given type of chromosome in a sample of the given sex
+AlleleCount determineExpectedAlleleCount(ChromType chromType, Sex sex);
+
+/// \brief Combine the depth estimated from the reads at a locus with the depth estimated from the index
+///
+/// The local depth is kept unless it is implausibly far above the index depth, in which case it is capped. Low local
+/// depths are never raised so that loci with few reads remain subject to the minimum coverage check. The cap is
+/// generous because the index depth averages over whole chromosomes and so falls far below the on-target depth of
+/// targeted sequencing data.
+///
+double reconcileLocusDepth(double localDepth, double indexDepth);
+
 // Computes read and coverage statistics for each locus from reads aligning to the flanks
 class LocusStatsCalculator
 {
@@ -74,17 +99,20 @@ public:
     LocusStatsCalculator(ChromType chromType, const graphtools::Graph& graph);
 
     void inspect(const graphtools::GraphAlignment& readAlign, const graphtools::GraphAlignment& mateAlign);
+    void inspect(const AlignmentSummary& readSummary, const AlignmentSummary& mateSummary);
     void inspectRead(const graphtools::GraphAlignment& readAlign);
+    void inspectRead(const AlignmentSummary& readSummary);
 
     LocusStats estimate(Sex sampleSex);
     void recordReadLen(const graphtools::GraphAlignment& readAlign);
+    void recordReadLen(const AlignmentSummary& readSummary);
 
 private:
     using AccumulatorStats
         = boost::accumulators::features<boost::accumulators::tag::count, boost::accumulators::tag::mean>;
     using Accumulator = boost::accumulators::accumulator_set<int, AccumulatorStats>;
 
-    void recordFragLen(const graphtools::GraphAlignment& readAlign, const graphtools::GraphAlignment& mateAlign);
+    void recordFragLen(const AlignmentSummary& readSummary, const AlignmentSummary& mateSummary);
 
     ChromType chromType_;
     Accumulator readLengthAccumulator_;
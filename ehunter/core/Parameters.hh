@@ -26,9 +26,12 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <boost/optional.hpp>
 
+#include "graphalign/ValidationLevel.hh"
+
 #include "alignment/SoftclippingAligner.hh"
 #include "core/Common.hh"
 #include "core/GenomicRegion.hh"
@@ -40,7 +43,15 @@ namespace ehunter
 enum class AnalysisMode
 {
     kSeeking,
-    kStreaming
+    kStreaming,
+    kExtract
+};
+
+// Source of the read depth used for genotyping each locus
+enum class DepthSource
+{
+    kLocus, // Reads aligned to the locus flanks
+    kIndex // Mapped read counts of the alignment file index
 };
 
 enum class LogLevel
@@ -55,41 +66,76 @@ enum class LogLevel
 class InputPaths
 {
 public:
-    InputPaths(std::string htsFile, std::string reference, std::string catalog)
+    InputPaths(
+        std::string htsFile, std::string reference, std::string catalog,
+        boost::optional<std::string> alignmentCache = boost::none)
         : htsFile_(std::move(htsFile))
         , reference_(std::move(reference))
         , catalog_(std::move(catalog))
+        , alignmentCache_(std::move(alignmentCache))
     {
     }
 
     const std::string& htsFile() const { return htsFile_; }
     const std::string& reference() const { return reference_; }
     const std::string& catalog() const { return catalog_; }
+    // Alignment cache written by an earlier run; when set, reads are loaded from the cache instead of the hts file
+    const boost::optional<std::string>& alignmentCache() const { return alignmentCache_; }
 
 private:
     std::string htsFile_;
     std::string reference_;
     std::string catalog_;
+    boost::optional<std::string> alignmentCache_;
 };
 
 class OutputPaths
 {
 public:
-    OutputPaths(std::string vcf, std::string json, std::string bamlet)
+    OutputPaths(
+        std::string vcf, std::string json, std::string bamlet, std::string alignmentCache, std::string evidence)
         : vcf_(vcf)
         , json_(json)
         , bamlet_(bamlet)
+        , alignmentCache_(alignmentCache)
+        , evidence_(evidence)
     {
     }
 
     const std::string& vcf() const { return vcf_; }
     const std::string& json() const { return json_; }
     const std::string& bamlet() const { return bamlet_; }
+    const std::string& alignmentCache() const { return alignmentCache_; }
+    // Evidence alignment file written in extract mode
+    const std::string& evidence() const { return evidence_; }
 
 private:
     std::string vcf_;
     std::string json_;
     std::string bamlet_;
+    std::string alignmentCache_;
+    std::string evidence_;
+};
+
+// Subset of catalog loci to analyze; loci matching any of the ids or overlapping any of the regions are selected
+class LocusSelection
+{
+public:
+    LocusSelection(std::vector<std::string> locusIds = {}, std::vector<std::string> regionEncodings = {})
+        : locusIds_(std::move(locusIds))
+        , regionEncodings_(std::move(regionEncodings))
+    {
+    }
+
+    const std::vector<std::string>& locusIds() const { return locusIds_; }
+    // Regions are decoded once the reference contigs are known
+    const std::vector<std::string>& regionEncodings() const { return regionEncodings_; }
+    // An empty selection includes the whole catalog
+    bool empty() const { return locusIds_.empty() && regionEncodings_.empty(); }
+
+private:
+    std::vector<std::string> locusIds_;
+    std::vector<std::string> regionEncodings_;
 };
 
 class SampleParameters
@@ -140,6 +186,21 @@ public:
     int orientationPredictorKmerLen() const { return orientationPredictorKmerLen_; }
     int orientationPredictorMinKmerCount() const { return orientationPredictorMinKmerCount_; }
 
+    /// True if low-quality read ends are trimmed before alignment and re-attached as softclips
+    bool trimLowQualityEnds() const { return trimLowQualityEnds_; }
+    void setTrimLowQualityEnds(bool trimLowQualityEnds) { trimLowQualityEnds_ = trimLowQualityEnds; }
+
+    /// Maximum number of read sequences whose alignments are memoized at each locus; memoization is off if zero
+    int alignmentMemoSize() const { return alignmentMemoSize_; }
+    void setAlignmentMemoSize(int alignmentMemoSize) { alignmentMemoSize_ = alignmentMemoSize; }
+
+    /// True if reads tiling a repeat motif are aligned without the graph aligner whenever the outcome is certain
+    bool alignInRepeatReadsDirectly() const { return alignInRepeatReadsDirectly_; }
+    void setAlignInRepeatReadsDirectly(bool alignInRepeatReadsDirectly)
+    {
+        alignInRepeatReadsDirectly_ = alignInRepeatReadsDirectly;
+    }
+
 private:
     int regionExtensionLength_;
     int minLocusCoverage_;
@@ -151,6 +212,9 @@ private:
     int seedAffixTrimLength_;
     int orientationPredictorKmerLen_;
     int orientationPredictorMinKmerCount_;
+    bool trimLowQualityEnds_ = false;
+    int alignmentMemoSize_ = 0;
+    bool alignInRepeatReadsDirectly_ = false;
 };
 
 // Per-locus parameters (settable from variant catalog) controlling genotyping
@@ -175,15 +239,21 @@ class ProgramParameters
 public:
     ProgramParameters(
         InputPaths inputPaths, OutputPaths outputPaths, SampleParameters sample, HeuristicParameters heuristics,
-        AnalysisMode analysisMode, LogLevel logLevel, const int initThreadCount, const bool initDisableBamletOutput)
+        AnalysisMode analysisMode, LogLevel logLevel, const int initThreadCount, const bool initDisableBamletOutput,
+        const bool initWriteAlignmentCache, const bool initResume, const bool initServer = false,
+        LocusSelection locusSelection = LocusSelection())
         : threadCount(initThreadCount)
         , disableBamletOutput(initDisableBamletOutput)
+        , writeAlignmentCache(initWriteAlignmentCache)
+        , resume(initResume)
+        , server(initServer)
         , inputPaths_(std::move(inputPaths))
         , outputPaths_(std::move(outputPaths))
         , sample_(std::move(sample))
         , heuristics_(std::move(heuristics))
         , analysisMode_(analysisMode)
         , logLevel_(logLevel)
+        , locusSelection_(std::move(locusSelection))
     {
     }
 
@@ -193,9 +263,24 @@ public:
     const HeuristicParameters& heuristics() const { return heuristics_; }
     AnalysisMode analysisMode() const { return analysisMode_; }
     LogLevel logLevel() const { return logLevel_; }
+    const LocusSelection& locusSelection() const { return locusSelection_; }
 
     int threadCount;
     bool disableBamletOutput;
+    bool writeAlignmentCache;
+    // Reuse loci completed by an interrupted run from its alignment cache
+    bool resume;
+    // Serve analysis jobs read from the standard input instead of analyzing a single sample
+    bool server;
+    // Level of the consistency checks performed by the graph aligner
+    graphtools::ValidationLevel alignmentValidation = graphtools::ValidationLevel::kFull;
+    DepthSource depthSource = DepthSource::kLocus;
+    // Infer the sex of the sample from its reads instead of using the sex in the sample parameters
+    bool inferSampleSex = false;
+    // Pin worker threads to CPUs spread over the NUMA nodes of the machine
+    bool pinThreads = false;
+    // Number of loci ahead of the worker threads whose alignment file blocks are prefetched in seeking mode
+    int prefetchLoci = 0;
 
 private:
     InputPaths inputPaths_;
@@ -204,6 +289,7 @@ private:
     HeuristicParameters heuristics_;
     AnalysisMode analysisMode_;
     LogLevel logLevel_;
+    LocusSelection locusSelection_;
 };
 
 }
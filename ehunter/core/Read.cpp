@@ -23,6 +23,7 @@
 
 #include "core/Read.hh"
 
+#include <cstdlib>
 #include <stdexcept>
 
 using std::string;
@@ -62,6 +63,13 @@ std::ostream& operator<<(std::ostream& out, const LinearAlignmentStats& alignmen
     return out;
 }
 
+bool checkIfMatesWereMappedNearby(const LinearAlignmentStats& alignmentStats)
+{
+    const int kMaxMateDistance = 1000;
+    return alignmentStats.chromId == alignmentStats.mateChromId
+        && std::abs(alignmentStats.pos - alignmentStats.matePos) < kMaxMateDistance;
+}
+
 std::ostream& operator<<(std::ostream& out, const ReadId& readId)
 {
     out << readId.fragmentId() << "/" << static_cast<int>(readId.mateNumber());
@@ -134,6 +134,9 @@ struct LinearAlignmentStats
 
 std::ostream& operator<<(std::ostream& out, const LinearAlignmentStats& alignmentStats);
 
+/// True if the mate of the read is mapped close enough to it to be found without a separate lookup in seeking mode
+bool checkIfMatesWereMappedNearby(const LinearAlignmentStats& alignmentStats);
+
 using ReadIdToLinearAlignmentStats = std::unordered_map<std::string, LinearAlignmentStats>;
 
 bool operator==(const Read& read, const Read& mate);
@@ -22,32 +22,9 @@
 
 #include "core/ReadSupportCalculator.hh"
 
-#include <algorithm>
-
 namespace ehunter
 {
 
-namespace
-{
-int countConsistentReads(const CountTable& table, int alleleSize)
-{
-    int readCount = 0;
-
-    for (const auto& sizeAndCount : table)
-    {
-        const int size = sizeAndCount.first;
-        const int count = sizeAndCount.second;
-
-        if (size <= alleleSize)
-        {
-            readCount += count;
-        }
-    }
-
-    return readCount;
-}
-}
-
 int ReadSupportCalculator::getCountOfConsistentSpanningReads(int alleleSize) const
 {
     return spanningReadCounts_.countOf(alleleSize);
@@ -55,12 +32,12 @@ int ReadSupportCalculator::getCountOfConsistentSpanningReads(int alleleSize) con
 
 int ReadSupportCalculator::getCountOfConsistentFlankingReads(int alleleSize) const
 {
-    return countConsistentReads(flankingReadCounts_, alleleSize);
+    return flankingReadCounts_.countOfElementsUpTo(alleleSize);
 }
 
 int ReadSupportCalculator::getCountOfConsistentRepeatReads(int alleleSize) const
 {
-    return countConsistentReads(inrepeatReadCounts_, alleleSize);
+    return inrepeatReadCounts_.countOfElementsUpTo(alleleSize);
 }
 
 }
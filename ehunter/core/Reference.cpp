@@ -91,4 +91,22 @@ string FastaReference::getSequence(const GenomicRegion& region) const
     return getSequence(bamHeaderContigInfo_.getContigName(region.contigIndex()), region.start(), region.end());
 }
 
+ReferenceContigInfo extractFastaContigInfo(const string& referencePath)
+{
+    std::unique_ptr<faidx_t, decltype(&fai_destroy)> htsFastaIndexPtr(fai_load(referencePath.c_str()), fai_destroy);
+    if (!htsFastaIndexPtr)
+    {
+        throw std::runtime_error("Failed to load index of " + referencePath);
+    }
+
+    std::vector<std::pair<std::string, int64_t>> namesAndSizes;
+    for (int contigIndex = 0; contigIndex != faidx_nseq(htsFastaIndexPtr.get()); ++contigIndex)
+    {
+        const char* sequenceName = faidx_iseq(htsFastaIndexPtr.get(), contigIndex);
+        namesAndSizes.emplace_back(sequenceName, faidx_seq_len(htsFastaIndexPtr.get(), sequenceName));
+    }
+
+    return ReferenceContigInfo(namesAndSizes);
+}
+
 }
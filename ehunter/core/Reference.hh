@@ -81,4 +81,7 @@ private:
     ReferenceContigInfo bamHeaderContigInfo_;
 };
 
+/// Contig names and sizes listed in the FASTA index of the reference
+ReferenceContigInfo extractFastaContigInfo(const std::string& referencePath);
+
 }
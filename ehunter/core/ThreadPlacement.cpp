@@ -0,0 +1,283 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "core/ThreadPlacement.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <boost/algorithm/string.hpp>
+
+#include "spdlog/spdlog.h"
+
+using std::string;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace
+{
+
+const string kNodeDirectory = "/sys/devices/system/node/";
+
+bool tryReadLine(const string& path, string& line)
+{
+    std::ifstream file(path);
+    return file && std::getline(file, line);
+}
+
+vector<int> getCpusOfProcess()
+{
+    vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+    {
+        for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpuSet))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty())
+    {
+        const int cpuCount = std::max(1u, std::thread::hardware_concurrency());
+        for (int cpu = 0; cpu != cpuCount; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+}
+
+vector<int> parseCpuList(const string& encoding)
+{
+    vector<int> cpus;
+    const string trimmedEncoding = boost::algorithm::trim_copy(encoding);
+    if (trimmedEncoding.empty())
+    {
+        return cpus;
+    }
+
+    vector<string> ranges;
+    boost::split(ranges, trimmedEncoding, boost::is_any_of(","));
+    for (const string& range : ranges)
+    {
+        vector<string> bounds;
+        boost::split(bounds, range, boost::is_any_of("-"));
+        try
+        {
+            const int first = std::stoi(bounds.front());
+            const int last = std::stoi(bounds.back());
+            if (bounds.size() > 2 || first < 0 || last < first)
+            {
+                throw std::invalid_argument(range);
+            }
+            for (int cpu = first; cpu <= last; ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        catch (const std::logic_error&)
+        {
+            throw std::invalid_argument("Malformed CPU list: " + encoding);
+        }
+    }
+
+    return cpus;
+}
+
+CpuTopology::CpuTopology(const vector<vector<int>>& nodeCpus)
+{
+    for (const auto& cpus : nodeCpus)
+    {
+        if (!cpus.empty())
+        {
+            nodeCpus_.push_back(cpus);
+        }
+    }
+
+    if (nodeCpus_.empty())
+    {
+        throw std::invalid_argument("CPU topology must contain at least one CPU");
+    }
+}
+
+CpuTopology CpuTopology::detect()
+{
+    const vector<int> processCpus = getCpusOfProcess();
+
+    string onlineNodeEncoding;
+    if (!tryReadLine(kNodeDirectory + "online", onlineNodeEncoding))
+    {
+        return CpuTopology({ processCpus });
+    }
+
+    vector<vector<int>> nodeCpus;
+    try
+    {
+        for (const int node : parseCpuList(onlineNodeEncoding))
+        {
+            string cpuListEncoding;
+            if (!tryReadLine(kNodeDirectory + "node" + std::to_string(node) + "/cpulist", cpuListEncoding))
+            {
+                continue;
+            }
+
+            vector<int> cpus;
+            for (const int cpu : parseCpuList(cpuListEncoding))
+            {
+                if (std::find(processCpus.begin(), processCpus.end(), cpu) != processCpus.end())
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            nodeCpus.push_back(cpus);
+        }
+    }
+    catch (const std::invalid_argument& e)
+    {
+        spdlog::warn("Unable to determine NUMA layout ({}); all CPUs are treated as one node", e.what());
+        return CpuTopology({ processCpus });
+    }
+
+    const bool hasCpus = std::any_of(
+        nodeCpus.begin(), nodeCpus.end(), [](const vector<int>& cpus) { return !cpus.empty(); });
+    return hasCpus ? CpuTopology(nodeCpus) : CpuTopology({ processCpus });
+}
+
+ThreadPlacement::ThreadPlacement(int threadCount)
+    : domainFirstThreads_({ 0 })
+    , threadCpus_(threadCount, -1)
+{
+}
+
+ThreadPlacement::ThreadPlacement(int threadCount, const CpuTopology& topology)
+{
+    const auto& nodeCpus = topology.nodeCpus();
+
+    // Each thread goes to the node with the fewest threads per CPU, so nodes are filled in proportion to their size
+    vector<int> nodeThreadCounts(nodeCpus.size(), 0);
+    for (int threadIndex = 0; threadIndex != threadCount; ++threadIndex)
+    {
+        size_t selectedNode = 0;
+        for (size_t node = 1; node != nodeCpus.size(); ++node)
+        {
+            const int64_t load = static_cast<int64_t>(nodeThreadCounts[node]) * nodeCpus[selectedNode].size();
+            const int64_t selectedLoad = static_cast<int64_t>(nodeThreadCounts[selectedNode]) * nodeCpus[node].size();
+            if (load < selectedLoad)
+            {
+                selectedNode = node;
+            }
+        }
+        ++nodeThreadCounts[selectedNode];
+    }
+
+    for (size_t node = 0; node != nodeCpus.size(); ++node)
+    {
+        if (nodeThreadCounts[node] == 0)
+        {
+            continue;
+        }
+
+        domainFirstThreads_.push_back(threadCpus_.size());
+        for (int nodeThreadIndex = 0; nodeThreadIndex != nodeThreadCounts[node]; ++nodeThreadIndex)
+        {
+            threadCpus_.push_back(nodeCpus[node][nodeThreadIndex % nodeCpus[node].size()]);
+        }
+    }
+
+    if (domainFirstThreads_.empty())
+    {
+        domainFirstThreads_.push_back(0);
+    }
+}
+
+int ThreadPlacement::threadCountOfDomain(int domainIndex) const
+{
+    const int domainEnd = domainIndex + 1 < domainCount() ? domainFirstThreads_[domainIndex + 1] : threadCount();
+    return domainEnd - domainFirstThreads_[domainIndex];
+}
+
+void ThreadPlacement::pinCurrentThread(int threadIndex) const
+{
+    const int cpu = threadCpus_[threadIndex];
+    if (cpu == -1)
+    {
+        return;
+    }
+
+    // Worker threads run many tasks, so each thread is only pinned once
+    thread_local int currentThreadCpu = -1;
+    if (currentThreadCpu == cpu)
+    {
+        return;
+    }
+
+    bool isPinned = false;
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    isPinned = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#endif
+
+    if (isPinned)
+    {
+        currentThreadCpu = cpu;
+    }
+    else
+    {
+        static std::once_flag warningFlag;
+        std::call_once(warningFlag, [cpu]() { spdlog::warn("Unable to pin worker threads to CPUs (CPU {})", cpu); });
+    }
+}
+
+ThreadPlacement makeThreadPlacement(int threadCount, bool pinThreads)
+{
+    if (!pinThreads)
+    {
+        return ThreadPlacement(threadCount);
+    }
+
+    const CpuTopology topology = CpuTopology::detect();
+    ThreadPlacement placement(threadCount, topology);
+    spdlog::info(
+        "Pinning {} worker threads to CPUs of {} of {} NUMA nodes", threadCount, placement.domainCount(),
+        topology.nodeCpus().size());
+    return placement;
+}
+
+}
@@ -0,0 +1,84 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ehunter
+{
+
+/// Parse a CPU list in the format used by Linux (for example, "0-3,8,10-11")
+std::vector<int> parseCpuList(const std::string& encoding);
+
+/// CPUs available to the process grouped by NUMA node
+class CpuTopology
+{
+public:
+    /// \param[in] nodeCpus CPUs of each node; nodes without CPUs are dropped
+    explicit CpuTopology(const std::vector<std::vector<int>>& nodeCpus);
+
+    /// \brief Detect the NUMA nodes of the CPUs in the affinity mask of the process
+    ///
+    /// All CPUs are assigned to a single node if the node layout is not available
+    ///
+    static CpuTopology detect();
+
+    const std::vector<std::vector<int>>& nodeCpus() const { return nodeCpus_; }
+
+private:
+    std::vector<std::vector<int>> nodeCpus_;
+};
+
+/// \brief Assignment of worker threads to NUMA domains and CPUs
+///
+/// Threads are numbered consecutively within each domain. Work that should stay on one node, such as the reads of a
+/// locus in streaming mode, is routed to the threads of a single domain.
+///
+class ThreadPlacement
+{
+public:
+    /// All threads form a single domain and are not pinned
+    explicit ThreadPlacement(int threadCount);
+
+    /// Threads are spread over the nodes in proportion to their CPU counts and pinned to CPUs of their node
+    ThreadPlacement(int threadCount, const CpuTopology& topology);
+
+    int threadCount() const { return static_cast<int>(threadCpus_.size()); }
+    int domainCount() const { return static_cast<int>(domainFirstThreads_.size()); }
+    int firstThreadOfDomain(int domainIndex) const { return domainFirstThreads_[domainIndex]; }
+    int threadCountOfDomain(int domainIndex) const;
+
+    /// CPU of the thread or -1 if threads are not pinned
+    int cpuOfThread(int threadIndex) const { return threadCpus_[threadIndex]; }
+
+    /// Pin the calling thread to the CPU of the given thread; has no effect if threads are not pinned
+    void pinCurrentThread(int threadIndex) const;
+
+private:
+    std::vector<int> domainFirstThreads_;
+    std::vector<int> threadCpus_;
+};
+
+/// Placement of the given number of worker threads, pinned to the detected NUMA topology if requested
+ThreadPlacement makeThreadPlacement(int threadCount, bool pinThreads);
+
+}
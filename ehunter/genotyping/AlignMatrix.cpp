@@ -60,27 +60,35 @@ StrAlign AlignMatrix::getAlign(int readIndex, int alleleSize) const
 
 void AlignMatrix::add(const GraphAlignment& read, const GraphAlignment& mate)
 {
-    const int numMotifsInRead = std::count(read.path().begin(), read.path().end(), strNode_);
-    const int numMorifsInMate = std::count(mate.path().begin(), mate.path().end(), strNode_);
+    add(read, AlignmentSummary(read), mate, AlignmentSummary(mate));
+}
+
+void AlignMatrix::add(
+    const GraphAlignment& read, const AlignmentSummary& readSummary, const GraphAlignment& mate,
+    const AlignmentSummary& mateSummary)
+{
+    const int numMotifsInRead = readSummary.numVisitsToNode(strNode_);
+    const int numMorifsInMate = mateSummary.numVisitsToNode(strNode_);
 
     if (numMotifsInRead != 0 || numMorifsInMate != 0)
     {
-        add(read);
-        add(mate);
+        add(read, readSummary);
+        add(mate, mateSummary);
     }
 }
 
-void AlignMatrix::add(const graphtools::GraphAlignment& graphAlign)
+void AlignMatrix::add(const GraphAlignment& graphAlign, const AlignmentSummary& summary)
 {
     vector<StrAlign> strAligns;
-    const int numMotifsInAlign = std::count(graphAlign.path().begin(), graphAlign.path().end(), strNode_);
-    StrAlign alignToMostConsistentAllele = alignmentCalculator_.findConsistentAlignment(numMotifsInAlign, graphAlign);
+    const int numMotifsInAlign = summary.numVisitsToNode(strNode_);
+    StrAlign alignToMostConsistentAllele
+        = alignmentCalculator_.findConsistentAlignment(numMotifsInAlign, graphAlign, summary);
 
     bestAlignsByRead_.push_back(alignToMostConsistentAllele);
 
     for (int numMotifs = numMotifsInAlign - 1; numMotifs != -1; --numMotifs)
     {
-        StrAlign align = alignmentCalculator_.findConsistentAlignment(numMotifs, graphAlign);
+        StrAlign align = alignmentCalculator_.findConsistentAlignment(numMotifs, graphAlign, summary);
         strAligns.emplace_back(align);
     }
     std::reverse(strAligns.begin(), strAligns.end());
@@ -88,7 +96,7 @@ void AlignMatrix::add(const graphtools::GraphAlignment& graphAlign)
     StrAlign previousAlign = strAligns.back();
     for (int numMotifs = numMotifsInAlign + 1;; ++numMotifs)
     {
-        StrAlign align = alignmentCalculator_.findConsistentAlignment(numMotifs, graphAlign);
+        StrAlign align = alignmentCalculator_.findConsistentAlignment(numMotifs, graphAlign, summary);
         if (align.type() == previousAlign.type() && align.score() == previousAlign.score())
         {
             break;
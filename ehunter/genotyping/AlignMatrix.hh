@@ -27,6 +27,7 @@
 
 #include "graphalign/GraphAlignment.hh"
 
+#include "alignment/AlignmentSummary.hh"
 #include "genotyping/StrAlign.hh"
 
 namespace ehunter
@@ -40,6 +41,9 @@ public:
     explicit AlignMatrix(int strNode);
     int numReads() const { return alignScoreMatrix_.size(); }
     void add(const graphtools::GraphAlignment& read, const graphtools::GraphAlignment& mate);
+    void add(
+        const graphtools::GraphAlignment& read, const AlignmentSummary& readSummary,
+        const graphtools::GraphAlignment& mate, const AlignmentSummary& mateSummary);
     void remove(int readIndex);
     StrAlign getAlign(int readIndex, int alleleSize) const;
     StrAlign getBestAlign(int readIndex) const;
@@ -49,7 +53,7 @@ public:
     friend void addIrrPairsIfPossibleExpansion(int maxMotifsInRead, AlignMatrix& alignMatrix, int numIrrPairs);
 
 private:
-    void add(const graphtools::GraphAlignment& graphAlign);
+    void add(const graphtools::GraphAlignment& graphAlign, const AlignmentSummary& summary);
     int strNode_;
     ConsistentAlignmentCalculator alignmentCalculator_;
     std::vector<StrAlign> bestAlignsByRead_;
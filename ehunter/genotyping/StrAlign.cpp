@@ -97,12 +97,11 @@ void scoreAlignment(
     }
 }
 
-StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, const GraphAlignment& alignment) const
+ConsistentAlignmentCalculator::RepeatScores ConsistentAlignmentCalculator::scoreMotifs(
+    const GraphAlignment& alignment, int beginMotifIndex, int endMotifIndex) const
 {
-    int leftFlankScore = 0, strScore = 0, rightFlankScore = 0;
-    int strIndelCount = 0;
-    int numMotifsInAlignment = std::count(alignment.path().begin(), alignment.path().end(), strNodeId_);
-    int numMotifsLeft = numMotifsInAlignment;
+    RepeatScores scores;
+    int motifIndex = 0;
     for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.size()); ++nodeIndex)
     {
         int node = alignment.getNodeIdByIndex(nodeIndex);
@@ -113,27 +112,82 @@ StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, cons
 
         if (node < strNodeId_)
         {
-            leftFlankScore += nodeScore;
+            scores.leftFlankScore += nodeScore;
         }
         else if (strNodeId_ < node)
         {
-            rightFlankScore += nodeScore;
-        }
-        else if (numMotifsLeft <= numMotifsInAllele)
-        {
-            strScore += nodeScore;
-            strIndelCount += nodeIndelCount;
-            --numMotifsLeft;
+            scores.rightFlankScore += nodeScore;
         }
         else
         {
-            --numMotifsLeft;
+            if (beginMotifIndex <= motifIndex && motifIndex < endMotifIndex)
+            {
+                scores.strScore += nodeScore;
+                scores.strIndelCount += nodeIndelCount;
+            }
+            ++motifIndex;
         }
     }
 
+    scores.numMotifsInAlignment = motifIndex;
+    return scores;
+}
+
+ConsistentAlignmentCalculator::RepeatScores ConsistentAlignmentCalculator::scoreMotifs(
+    const GraphAlignment& alignment, const AlignmentSummary& summary, int beginMotifIndex, int endMotifIndex) const
+{
+    const int numMotifsInAlignment = summary.numVisitsToNode(strNodeId_);
+    if (numMotifsInAlignment != 0 && !summary.areVisitsToNodeConsecutive(strNodeId_))
+    {
+        return scoreMotifs(alignment, beginMotifIndex, endMotifIndex);
+    }
+
+    RepeatScores scores;
+    scores.leftFlankScore = summary.scoreOnNodes(0, strNodeId_);
+    scores.rightFlankScore = summary.scoreOnNodes(strNodeId_ + 1, AlignmentSummary::kEndOfGraph);
+    scores.numMotifsInAlignment = numMotifsInAlignment;
+
+    beginMotifIndex = std::max(beginMotifIndex, 0);
+    endMotifIndex = std::min(endMotifIndex, numMotifsInAlignment);
+    if (beginMotifIndex < endMotifIndex)
+    {
+        const int firstMotifNodeIndex = summary.firstIndexOfNode(strNodeId_);
+        const int beginNodeIndex = firstMotifNodeIndex + beginMotifIndex;
+        const int endNodeIndex = firstMotifNodeIndex + endMotifIndex;
+        scores.strScore = summary.scoreOfIndexes(beginNodeIndex, endNodeIndex);
+        scores.strIndelCount = summary.numIndelsOfIndexes(beginNodeIndex, endNodeIndex);
+    }
+
+    return scores;
+}
+
+StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, const GraphAlignment& alignment) const
+{
+    const int numMotifsInAlignment = std::count(alignment.path().begin(), alignment.path().end(), strNodeId_);
+    const int beginMotifIndex = numMotifsInAlignment - numMotifsInAllele;
+    return summarizeLeftClipped(
+        numMotifsInAllele, scoreMotifs(alignment, beginMotifIndex, numMotifsInAlignment), alignment);
+}
+
+StrAlign ConsistentAlignmentCalculator::clipFromLeft(
+    int numMotifsInAllele, const GraphAlignment& alignment, const AlignmentSummary& summary) const
+{
+    const int numMotifsInAlignment = summary.numVisitsToNode(strNodeId_);
+    const int beginMotifIndex = numMotifsInAlignment - numMotifsInAllele;
+    return summarizeLeftClipped(
+        numMotifsInAllele, scoreMotifs(alignment, summary, beginMotifIndex, numMotifsInAlignment), alignment);
+}
+
+StrAlign ConsistentAlignmentCalculator::summarizeLeftClipped(
+    int numMotifsInAllele, RepeatScores scores, const GraphAlignment& alignment) const
+{
+    const int numMotifsInAlignment = scores.numMotifsInAlignment;
+    const int strScore = scores.strScore;
+    const int strIndelCount = scores.strIndelCount;
+
     // Zero out negative scores
-    leftFlankScore = std::max(leftFlankScore, 0);
-    rightFlankScore = std::max(rightFlankScore, 0);
+    const int leftFlankScore = std::max(scores.leftFlankScore, 0);
+    const int rightFlankScore = std::max(scores.rightFlankScore, 0);
 
     // Alignment does not overlap the repeat
     if (numMotifsInAlignment == 0 && (leftFlankScore == 0 || rightFlankScore == 0))
@@ -192,46 +246,26 @@ StrAlign ConsistentAlignmentCalculator::clipFromLeft(int numMotifsInAllele, cons
 StrAlign
 ConsistentAlignmentCalculator::clipFromRight(int numMotifsInAllele, const graphtools::GraphAlignment& alignment) const
 {
-    int leftFlankScore = 0, strScore = 0, rightFlankScore = 0;
-    int strIndelCount = 0;
-
-    int motifIndex = 0;
-    for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.size()); ++nodeIndex)
-    {
-        int node = alignment.getNodeIdByIndex(nodeIndex);
-        const auto& nodeAlign = alignment.alignments()[nodeIndex];
+    return summarizeRightClipped(numMotifsInAllele, scoreMotifs(alignment, 0, numMotifsInAllele), alignment);
+}
 
-        int nodeScore = 0;
-        int nodeIndelCount = 0;
-        scoreAlignment(nodeAlign, matchScore_, mismatchScore_, gapOpenScore_, nodeScore, nodeIndelCount);
+StrAlign ConsistentAlignmentCalculator::clipFromRight(
+    int numMotifsInAllele, const GraphAlignment& alignment, const AlignmentSummary& summary) const
+{
+    return summarizeRightClipped(numMotifsInAllele, scoreMotifs(alignment, summary, 0, numMotifsInAllele), alignment);
+}
 
-        if (node < strNodeId_)
-        {
-            leftFlankScore += nodeScore;
-        }
-        else if (strNodeId_ < node)
-        {
-            rightFlankScore += nodeScore;
-        }
-        else if (motifIndex + 1 <= numMotifsInAllele)
-        {
-            assert(node == strNodeId_);
-            strScore += nodeScore;
-            strIndelCount += nodeIndelCount;
-            ++motifIndex;
-        }
-        else
-        {
-            assert(node == strNodeId_);
-            ++motifIndex;
-        }
-    }
+StrAlign ConsistentAlignmentCalculator::summarizeRightClipped(
+    int numMotifsInAllele, RepeatScores scores, const GraphAlignment& alignment) const
+{
+    const int numMotifsInAlignment = scores.numMotifsInAlignment;
+    const int strScore = scores.strScore;
+    const int strIndelCount = scores.strIndelCount;
 
     // Zero out negative scores
-    leftFlankScore = std::max(leftFlankScore, 0);
-    rightFlankScore = std::max(rightFlankScore, 0);
+    const int leftFlankScore = std::max(scores.leftFlankScore, 0);
+    const int rightFlankScore = std::max(scores.rightFlankScore, 0);
 
-    int numMotifsInAlignment = std::count(alignment.path().begin(), alignment.path().end(), strNodeId_);
     // Alignment does not overlap the repeat
     if (numMotifsInAlignment == 0 && (leftFlankScore == 0 || rightFlankScore == 0))
     {
@@ -292,56 +326,37 @@ ConsistentAlignmentCalculator::clipFromRight(int numMotifsInAllele, const grapht
 
 StrAlign ConsistentAlignmentCalculator::removeStutter(int numMotifsInAllele, const GraphAlignment& alignment) const
 {
-    int leftFlankScore = 0, strScore = 0, rightFlankScore = 0;
-    int strIndelCount = 0;
-    int motifIndex = 0;
-    for (int nodeIndex = 0; nodeIndex != static_cast<int>(alignment.size()); ++nodeIndex)
-    {
-        int node = alignment.getNodeIdByIndex(nodeIndex);
-        const auto& nodeAlign = alignment.alignments()[nodeIndex];
-        int nodeScore = 0;
-        int nodeIndelCount = 0;
-        scoreAlignment(nodeAlign, matchScore_, mismatchScore_, gapOpenScore_, nodeScore, nodeIndelCount);
+    return summarizeStutterFree(numMotifsInAllele, scoreMotifs(alignment, 0, numMotifsInAllele), alignment);
+}
 
-        if (node < strNodeId_)
-        {
-            leftFlankScore += nodeScore;
-        }
-        else if (strNodeId_ < node)
-        {
-            rightFlankScore += nodeScore;
-        }
-        else if (motifIndex + 1 <= numMotifsInAllele)
-        {
-            strScore += nodeScore;
-            strIndelCount += nodeIndelCount;
-            ++motifIndex;
-        }
-        else
-        {
-            ++motifIndex;
-        }
-    }
+StrAlign ConsistentAlignmentCalculator::removeStutter(
+    int numMotifsInAllele, const GraphAlignment& alignment, const AlignmentSummary& summary) const
+{
+    return summarizeStutterFree(numMotifsInAllele, scoreMotifs(alignment, summary, 0, numMotifsInAllele), alignment);
+}
 
+StrAlign ConsistentAlignmentCalculator::summarizeStutterFree(
+    int numMotifsInAllele, RepeatScores scores, const GraphAlignment& alignment) const
+{
     // Zero out negative scores
-    leftFlankScore = std::max(leftFlankScore, 0);
-    rightFlankScore = std::max(rightFlankScore, 0);
+    const int leftFlankScore = std::max(scores.leftFlankScore, 0);
+    const int rightFlankScore = std::max(scores.rightFlankScore, 0);
 
     if (leftFlankScore == 0 || rightFlankScore == 0)
     {
         return { StrAlign::Type::kOutside, 0, 0, 0 };
     }
 
-    const int numMotifsInAlignment = std::count(alignment.path().begin(), alignment.path().end(), strNodeId_);
+    const int numMotifsInAlignment = scores.numMotifsInAlignment;
     const int numDiscrepantMotifs = std::abs(numMotifsInAlignment - numMotifsInAllele);
     const int motifLength = alignment.path().graphRawPtr()->nodeSeq(strNodeId_).length();
     const int discrepantLength = motifLength * numDiscrepantMotifs;
     const int gapOpenScore = -24;
     const int gapExtendScore = -12;
     int penaltyScore = numDiscrepantMotifs > 0 ? gapOpenScore + gapExtendScore * (discrepantLength - 1) : 0;
-    const int alignmentScore = std::max(leftFlankScore + strScore + penaltyScore + rightFlankScore, 0);
+    const int alignmentScore = std::max(leftFlankScore + scores.strScore + penaltyScore + rightFlankScore, 0);
 
-    return { StrAlign::Type::kSpanning, numMotifsInAllele, alignmentScore, strIndelCount };
+    return { StrAlign::Type::kSpanning, numMotifsInAllele, alignmentScore, scores.strIndelCount };
 }
 
 StrAlign
@@ -359,4 +374,19 @@ ConsistentAlignmentCalculator::findConsistentAlignment(int numMotifsInAllele, co
     return (leftClipAlign.score() > rightClipAlign.score() ? leftClipAlign : rightClipAlign);
 }
 
+StrAlign ConsistentAlignmentCalculator::findConsistentAlignment(
+    int numMotifsInAllele, const GraphAlignment& alignment, const AlignmentSummary& summary) const
+{
+    StrAlign stutterFreeAlign = removeStutter(numMotifsInAllele, alignment, summary);
+    StrAlign leftClipAlign = clipFromLeft(numMotifsInAllele, alignment, summary);
+    StrAlign rightClipAlign = clipFromRight(numMotifsInAllele, alignment, summary);
+
+    if (stutterFreeAlign.score() > leftClipAlign.score() && stutterFreeAlign.score() > rightClipAlign.score())
+    {
+        return stutterFreeAlign;
+    }
+
+    return (leftClipAlign.score() > rightClipAlign.score() ? leftClipAlign : rightClipAlign);
+}
+
 }
@@ -25,6 +25,8 @@
 
 #include "graphalign/GraphAlignment.hh"
 
+#include "alignment/AlignmentSummary.hh"
+
 namespace ehunter
 {
 
@@ -139,7 +141,43 @@ public:
 
     StrAlign findConsistentAlignment(int numMotifsInAllele, const graphtools::GraphAlignment& alignment) const;
 
+    // Same as above but the scores are looked up in the summary of the alignment instead of being recomputed for
+    // each allele; the summary must describe the given alignment
+    StrAlign clipFromLeft(
+        int numMotifsInAllele, const graphtools::GraphAlignment& alignment, const AlignmentSummary& summary) const;
+    StrAlign clipFromRight(
+        int numMotifsInAllele, const graphtools::GraphAlignment& alignment, const AlignmentSummary& summary) const;
+    StrAlign removeStutter(
+        int numMotifsInAllele, const graphtools::GraphAlignment& alignment, const AlignmentSummary& summary) const;
+    StrAlign findConsistentAlignment(
+        int numMotifsInAllele, const graphtools::GraphAlignment& alignment, const AlignmentSummary& summary) const;
+
 private:
+    // Scores of the flanks and of a range of motifs of an alignment
+    struct RepeatScores
+    {
+        int leftFlankScore = 0;
+        int strScore = 0;
+        int strIndelCount = 0;
+        int rightFlankScore = 0;
+        int numMotifsInAlignment = 0;
+    };
+
+    // Scores the flanks and the motifs with indexes in [beginMotifIndex, endMotifIndex) counting along the path
+    RepeatScores
+    scoreMotifs(const graphtools::GraphAlignment& alignment, int beginMotifIndex, int endMotifIndex) const;
+    RepeatScores scoreMotifs(
+        const graphtools::GraphAlignment& alignment, const AlignmentSummary& summary, int beginMotifIndex,
+        int endMotifIndex) const;
+
+    StrAlign summarizeLeftClipped(
+        int numMotifsInAllele, RepeatScores scores, const graphtools::GraphAlignment& alignment) const;
+    StrAlign summarizeRightClipped(
+        int numMotifsInAllele, RepeatScores scores, const graphtools::GraphAlignment& alignment) const;
+    StrAlign summarizeStutterFree(
+        int numMotifsInAllele, RepeatScores scores, const graphtools::GraphAlignment& alignment) const;
+
+    // Matches the default linear alignment parameters used to score alignment summaries
     int matchScore_ = 5;
     int mismatchScore_ = -4;
     int gapOpenScore_ = -8;
@@ -0,0 +1,361 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "io/AlignmentCache.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include "graphalign/GraphAlignmentOperations.hh"
+
+using ehunter::locus::AlignedRead;
+using ehunter::locus::LocusAlignmentRecord;
+using graphtools::decodeGraphAlignment;
+using graphtools::Graph;
+using std::string;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace
+{
+
+const string kIndexExtension = ".idx";
+const string kSampleFingerprintTag = "##SampleFingerprint\t";
+
+void writeAlignedRead(std::ostream& out, const AlignedRead& alignedRead)
+{
+    const Read& read = alignedRead.read;
+    out << read.fragmentId() << '\t' << static_cast<int>(read.mateNumber()) << '\t' << (read.isReversed() ? 1 : 0)
+        << '\t' << read.sequence() << '\t' << alignedRead.alignment.path().startPosition() << '\t'
+        << alignedRead.alignment.generateCigar() << '\n';
+}
+
+string getNextLine(std::istream& in, const string& locusId)
+{
+    string line;
+    if (!std::getline(in, line))
+    {
+        throw std::runtime_error("Alignment cache record of " + locusId + " is truncated");
+    }
+    return line;
+}
+
+AlignedRead readAlignedRead(std::istream& in, const string& locusId, const Graph& graph)
+{
+    const string line = getNextLine(in, locusId);
+    vector<string> fields;
+    boost::split(fields, line, boost::is_any_of("\t"));
+
+    const int kFieldCount = 6;
+    const bool isValidLine = fields.size() == kFieldCount && (fields[1] == "1" || fields[1] == "2")
+        && (fields[2] == "0" || fields[2] == "1");
+    if (!isValidLine)
+    {
+        throw std::runtime_error("Malformed alignment cache line in record of " + locusId + ": " + line);
+    }
+
+    const MateNumber mateNumber = fields[1] == "1" ? MateNumber::kFirstMate : MateNumber::kSecondMate;
+    const bool isReversed = fields[2] == "1";
+    Read read(ReadId(fields[0], mateNumber), fields[3], isReversed);
+    auto alignment = decodeGraphAlignment(std::stoi(fields[4]), fields[5], &graph);
+
+    return { std::move(read), std::move(alignment) };
+}
+
+/// Returns the offset just past the locus block starting at the given offset
+int64_t findEndOfRecord(std::istream& in, const int64_t offset, const string& locusId)
+{
+    in.seekg(offset);
+    const string header = getNextLine(in, locusId);
+    vector<string> fields;
+    boost::split(fields, header, boost::is_any_of("\t"));
+
+    const int kFieldCount = 4;
+    if (fields.size() != kFieldCount || fields[0] != "#" + locusId)
+    {
+        throw std::runtime_error("Expected alignment cache record of " + locusId + " but found: " + header);
+    }
+
+    const int lineCount = 2 * std::stoi(fields[1]) + std::stoi(fields[2]);
+    for (int lineIndex(0); lineIndex < lineCount; ++lineIndex)
+    {
+        getNextLine(in, locusId);
+    }
+    return in.tellg();
+}
+
+/// Reads the sample fingerprint from the header of the cache; returns none if the cache has no complete header
+boost::optional<string> readSampleFingerprint(std::istream& in)
+{
+    string line;
+    const bool isHeader = std::getline(in, line) && !in.eof()
+        && line.compare(0, kSampleFingerprintTag.size(), kSampleFingerprintTag) == 0;
+    if (!isHeader)
+    {
+        return boost::none;
+    }
+    return line.substr(kSampleFingerprintTag.size());
+}
+
+/// \brief Discard the partial writes of an interrupted run
+///
+/// Truncates the index after its last complete line and the cache after the last block listed in the index, so that
+/// appended records and index lines are not joined to incomplete ones
+///
+void discardInterruptedWrites(const string& cachePath)
+{
+    const string indexPath = cachePath + kIndexExtension;
+    std::ifstream indexFile(indexPath, std::ios::binary);
+    const string index((std::istreambuf_iterator<char>(indexFile)), std::istreambuf_iterator<char>());
+    indexFile.close();
+
+    const size_t lastNewline = index.rfind('\n');
+    const size_t completeIndexLength = lastNewline == string::npos ? 0 : lastNewline + 1;
+
+    int64_t lastRecordOffset = -1;
+    string lastRecordLocusId;
+    std::istringstream completeIndex(index.substr(0, completeIndexLength));
+    string line;
+    while (std::getline(completeIndex, line))
+    {
+        vector<string> fields;
+        boost::split(fields, line, boost::is_any_of("\t"));
+        if (fields.size() != 2 && fields.size() != 3)
+        {
+            throw std::runtime_error("Malformed alignment cache index " + indexPath + ": " + line);
+        }
+
+        const int64_t offset = std::stoll(fields[1]);
+        if (offset > lastRecordOffset)
+        {
+            lastRecordOffset = offset;
+            lastRecordLocusId = fields[0];
+        }
+    }
+
+    int64_t completeCacheLength = 0;
+    std::ifstream cacheFile(cachePath, std::ios::binary);
+    if (lastRecordOffset != -1)
+    {
+        completeCacheLength = findEndOfRecord(cacheFile, lastRecordOffset, lastRecordLocusId);
+    }
+    else if (readSampleFingerprint(cacheFile))
+    {
+        completeCacheLength = cacheFile.tellg();
+    }
+    cacheFile.close();
+
+    if (completeIndexLength != index.size())
+    {
+        boost::filesystem::resize_file(indexPath, completeIndexLength);
+    }
+    if (static_cast<uintmax_t>(completeCacheLength) != boost::filesystem::file_size(cachePath))
+    {
+        boost::filesystem::resize_file(cachePath, completeCacheLength);
+    }
+}
+
+}
+
+void writeLocusAlignmentRecord(std::ostream& out, const string& locusId, const LocusAlignmentRecord& record)
+{
+    out << '#' << locusId << '\t' << record.alignedPairs.size() << '\t' << record.alignedSingleReads.size() << '\t'
+        << record.irrPairCount << '\n';
+
+    for (const auto& alignedPair : record.alignedPairs)
+    {
+        writeAlignedRead(out, alignedPair.first);
+        writeAlignedRead(out, alignedPair.second);
+    }
+
+    for (const auto& alignedRead : record.alignedSingleReads)
+    {
+        writeAlignedRead(out, alignedRead);
+    }
+}
+
+LocusAlignmentRecord readLocusAlignmentRecord(std::istream& in, const string& locusId, const Graph& graph)
+{
+    const string header = getNextLine(in, locusId);
+    vector<string> fields;
+    boost::split(fields, header, boost::is_any_of("\t"));
+
+    const int kFieldCount = 4;
+    if (fields.size() != kFieldCount || fields[0] != "#" + locusId)
+    {
+        throw std::runtime_error("Expected alignment cache record of " + locusId + " but found: " + header);
+    }
+
+    const int pairCount = std::stoi(fields[1]);
+    const int singleReadCount = std::stoi(fields[2]);
+
+    LocusAlignmentRecord record;
+    record.irrPairCount = std::stoi(fields[3]);
+
+    record.alignedPairs.reserve(pairCount);
+    for (int pairIndex(0); pairIndex < pairCount; ++pairIndex)
+    {
+        AlignedRead read = readAlignedRead(in, locusId, graph);
+        AlignedRead mate = readAlignedRead(in, locusId, graph);
+        record.alignedPairs.emplace_back(std::move(read), std::move(mate));
+    }
+
+    record.alignedSingleReads.reserve(singleReadCount);
+    for (int readIndex(0); readIndex < singleReadCount; ++readIndex)
+    {
+        record.alignedSingleReads.push_back(readAlignedRead(in, locusId, graph));
+    }
+
+    return record;
+}
+
+AlignmentCacheWriter::AlignmentCacheWriter(
+    const string& cachePath, const bool append, AlignmentCacheKeys locusKeys, const string& sampleFingerprint)
+    : locusKeys_(std::move(locusKeys))
+{
+    if (append && isAlignmentCachePresent(cachePath))
+    {
+        discardInterruptedWrites(cachePath);
+    }
+
+    cacheFile_.open(cachePath, append ? std::ios::binary | std::ios::app : std::ios::binary);
+    indexFile_.open(cachePath + kIndexExtension, append ? std::ios::app : std::ios::out);
+    if (!cacheFile_.is_open() || !indexFile_.is_open())
+    {
+        throw std::runtime_error("Failed to open " + cachePath + " for writing (" + strerror(errno) + ")");
+    }
+
+    cacheFile_.seekp(0, std::ios::end);
+    if (cacheFile_.tellp() == 0 && !sampleFingerprint.empty())
+    {
+        cacheFile_ << kSampleFingerprintTag << sampleFingerprint << '\n';
+        cacheFile_.flush();
+    }
+}
+
+void AlignmentCacheWriter::write(const string& locusId, const LocusAlignmentRecord& record)
+{
+    // Encode the record before taking the lock to keep the critical section short
+    std::ostringstream encoding;
+    writeLocusAlignmentRecord(encoding, locusId, record);
+
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
+    cacheFile_.seekp(0, std::ios::end);
+    const int64_t offset = cacheFile_.tellp();
+    cacheFile_ << encoding.str();
+    cacheFile_.flush();
+    indexFile_ << locusId << '\t' << offset;
+    const auto keyIterator = locusKeys_.find(locusId);
+    if (keyIterator != locusKeys_.end())
+    {
+        indexFile_ << '\t' << keyIterator->second;
+    }
+    indexFile_ << '\n';
+    indexFile_.flush();
+
+    if (!cacheFile_ || !indexFile_)
+    {
+        throw std::runtime_error("Failed to write alignment cache record of " + locusId);
+    }
+}
+
+bool isAlignmentCachePresent(const string& cachePath)
+{
+    return std::ifstream(cachePath).good() && std::ifstream(cachePath + kIndexExtension).good();
+}
+
+AlignmentCacheReader::AlignmentCacheReader(const string& cachePath)
+    : cachePath_(cachePath)
+    , cacheFile_(cachePath, std::ios::binary)
+{
+    std::ifstream indexFile(cachePath + kIndexExtension);
+    if (!cacheFile_.is_open() || !indexFile.is_open())
+    {
+        throw std::runtime_error("Failed to open alignment cache " + cachePath + " (" + strerror(errno) + ")");
+    }
+    sampleFingerprint_ = readSampleFingerprint(cacheFile_);
+
+    string line;
+    while (std::getline(indexFile, line))
+    {
+        // A final line without a newline was cut short by an interrupted run and its block may be incomplete
+        if (indexFile.eof())
+        {
+            break;
+        }
+
+        vector<string> fields;
+        boost::split(fields, line, boost::is_any_of("\t"));
+        if (fields.size() != 2 && fields.size() != 3)
+        {
+            throw std::runtime_error("Malformed alignment cache index " + cachePath + kIndexExtension + ": " + line);
+        }
+
+        const string& locusId = fields[0];
+        locusOffsets_[locusId] = std::stoll(fields[1]);
+        if (fields.size() == 3)
+        {
+            locusKeys_[locusId] = fields[2];
+        }
+        else
+        {
+            locusKeys_.erase(locusId);
+        }
+    }
+}
+
+bool AlignmentCacheReader::contains(const string& locusId, const string& locusKey) const
+{
+    const auto keyIterator = locusKeys_.find(locusId);
+    return keyIterator != locusKeys_.end() && keyIterator->second == locusKey;
+}
+
+boost::optional<string> AlignmentCacheReader::locusKey(const string& locusId) const
+{
+    const auto keyIterator = locusKeys_.find(locusId);
+    if (keyIterator == locusKeys_.end())
+    {
+        return boost::none;
+    }
+    return keyIterator->second;
+}
+
+boost::optional<LocusAlignmentRecord> AlignmentCacheReader::read(const string& locusId, const Graph& graph)
+{
+    const auto offsetIterator = locusOffsets_.find(locusId);
+    if (offsetIterator == locusOffsets_.end())
+    {
+        return boost::none;
+    }
+
+    cacheFile_.clear();
+    cacheFile_.seekg(offsetIterator->second);
+    return readLocusAlignmentRecord(cacheFile_, locusId, graph);
+}
+
+}
@@ -0,0 +1,129 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include "graphcore/Graph.hh"
+
+#include "locus/LocusAlignmentRecord.hh"
+
+namespace ehunter
+{
+
+// The alignment cache stores the graph alignments of all reads used to analyze each locus of a sample. The cache is a
+// text file consisting of one block per locus:
+//
+//   #<locus id>\t<aligned pair count>\t<aligned single read count>\t<IRR pair count>
+//   <fragment id>\t<mate number>\t<is reversed>\t<read sequence>\t<alignment start>\t<graph cigar>
+//   ...
+//
+// where the pair lines list the first and then the second member of each pair. Block offsets are stored in a
+// companion index file with the ".idx" extension, so that individual loci can be loaded without scanning the cache.
+//
+// Each index line is written only after its block has been flushed, so the cache doubles as a journal of completed
+// loci: after an interrupted run, every locus listed on a complete index line has a complete block. Before records are
+// appended to an existing cache, a partial final index line and any bytes following the last indexed block are removed.
+//
+// Index lines may carry a third field with a key identifying the inputs the record was computed from (the locus
+// definition and the alignment settings). If a locus is recorded more than once, the last record wins.
+//
+// The cache may start with a header line identifying the alignment file that all of its records were computed from:
+//
+//   ##SampleFingerprint\t<fingerprint>
+
+/// Maps locus ids to the keys of their alignment cache records
+using AlignmentCacheKeys = std::unordered_map<std::string, std::string>;
+
+void writeLocusAlignmentRecord(
+    std::ostream& out, const std::string& locusId, const locus::LocusAlignmentRecord& record);
+
+/// \brief Read a locus block written by writeLocusAlignmentRecord
+///
+/// \param[in] graph Graph of the locus used to decode the alignments
+///
+locus::LocusAlignmentRecord
+readLocusAlignmentRecord(std::istream& in, const std::string& locusId, const graphtools::Graph& graph);
+
+class AlignmentCacheWriter : private boost::noncopyable
+{
+public:
+    /// \param[in] append Add records to an existing cache instead of replacing it; partial writes of an interrupted run
+    /// are discarded first
+    /// \param[in] locusKeys Keys stored in the index alongside the records of the given loci
+    /// \param[in] sampleFingerprint Identifies the alignment file in the header written to an empty cache; a cache
+    /// that is appended to keeps its header
+    explicit AlignmentCacheWriter(
+        const std::string& cachePath, bool append = false, AlignmentCacheKeys locusKeys = AlignmentCacheKeys(),
+        const std::string& sampleFingerprint = "");
+
+    /// Thread safe
+    void write(const std::string& locusId, const locus::LocusAlignmentRecord& record);
+
+private:
+    std::mutex writeMutex_;
+    std::ofstream cacheFile_;
+    std::ofstream indexFile_;
+    AlignmentCacheKeys locusKeys_;
+};
+
+using AlignmentCacheWriterPtr = std::shared_ptr<AlignmentCacheWriter>;
+
+/// True if both the cache and its index exist
+bool isAlignmentCachePresent(const std::string& cachePath);
+
+/// Not thread safe; each thread is expected to use its own reader
+class AlignmentCacheReader : private boost::noncopyable
+{
+public:
+    explicit AlignmentCacheReader(const std::string& cachePath);
+
+    bool contains(const std::string& locusId) const { return locusOffsets_.find(locusId) != locusOffsets_.end(); }
+
+    /// True if the cache contains a record of the locus stored with the given key
+    bool contains(const std::string& locusId, const std::string& locusKey) const;
+
+    /// Key stored with the record of the given locus; returns none if the locus is absent or its record has no key
+    boost::optional<std::string> locusKey(const std::string& locusId) const;
+
+    /// Fingerprint of the alignment file stored in the cache header, if the cache has one
+    const boost::optional<std::string>& sampleFingerprint() const { return sampleFingerprint_; }
+
+    /// Load the record of the given locus; returns none if the locus is absent from the cache
+    boost::optional<locus::LocusAlignmentRecord> read(const std::string& locusId, const graphtools::Graph& graph);
+
+private:
+    std::string cachePath_;
+    std::ifstream cacheFile_;
+    std::unordered_map<std::string, int64_t> locusOffsets_;
+    AlignmentCacheKeys locusKeys_;
+    boost::optional<std::string> sampleFingerprint_;
+};
+
+}
@@ -0,0 +1,210 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "io/CatalogIndex.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "thirdparty/json/json.hpp"
+
+using boost::optional;
+using std::string;
+using std::vector;
+
+using Json = nlohmann::json;
+
+namespace ehunter
+{
+
+namespace
+{
+
+/// Byte ranges of locus records, which are either elements of the top-level array or the only top-level object
+vector<std::pair<std::size_t, std::size_t>> findRecordBoundaries(const string& catalogText)
+{
+    const auto firstCharacterPosition = catalogText.find_first_not_of(" \t\r\n");
+    if (firstCharacterPosition == string::npos)
+    {
+        return {};
+    }
+    const int recordDepth = catalogText[firstCharacterPosition] == '[' ? 1 : 0;
+
+    vector<std::pair<std::size_t, std::size_t>> recordBoundaries;
+    int depth = 0;
+    bool isInString = false;
+    bool isEscaped = false;
+    std::size_t recordStart = 0;
+    for (std::size_t position = firstCharacterPosition; position != catalogText.size(); ++position)
+    {
+        const char character = catalogText[position];
+        if (isInString)
+        {
+            if (isEscaped)
+            {
+                isEscaped = false;
+            }
+            else if (character == '\\')
+            {
+                isEscaped = true;
+            }
+            else if (character == '"')
+            {
+                isInString = false;
+            }
+            continue;
+        }
+
+        if (character == '"')
+        {
+            isInString = true;
+        }
+        else if (character == '{' || character == '[')
+        {
+            if (character == '{' && depth == recordDepth)
+            {
+                recordStart = position;
+            }
+            ++depth;
+        }
+        else if (character == '}' || character == ']')
+        {
+            --depth;
+            if (depth < 0)
+            {
+                throw std::runtime_error("Catalog contains unbalanced brackets");
+            }
+            if (character == '}' && depth == recordDepth)
+            {
+                recordBoundaries.emplace_back(recordStart, position + 1 - recordStart);
+            }
+        }
+    }
+
+    if (depth != 0 || isInString)
+    {
+        throw std::runtime_error("Catalog is truncated");
+    }
+
+    return recordBoundaries;
+}
+
+CatalogEntry
+decodeEntry(const string& catalogText, std::size_t offset, std::size_t length, const ReferenceContigInfo& contigInfo)
+{
+    // Only the fields needed for the index are kept; the rest of the record is skipped by the parser
+    const Json::parser_callback_t keepIndexedFields = [](int depth, Json::parse_event_t event, Json& parsed)
+    {
+        if (event == Json::parse_event_t::key && depth == 1)
+        {
+            return parsed == "LocusId" || parsed == "ReferenceRegion";
+        }
+        return true;
+    };
+
+    const auto recordStart = catalogText.begin() + offset;
+    const Json record = Json::parse(recordStart, recordStart + length, keepIndexedFields);
+
+    if (!record.contains("LocusId") || !record.contains("ReferenceRegion"))
+    {
+        throw std::logic_error(
+            "Fields LocusId and ReferenceRegion must be present in " + string(recordStart, recordStart + length));
+    }
+
+    CatalogEntry entry;
+    entry.locusId = record["LocusId"].get<string>();
+    entry.offset = offset;
+    entry.length = length;
+
+    const Json& regionEncodings = record["ReferenceRegion"];
+    if (regionEncodings.is_array())
+    {
+        for (const auto& encoding : regionEncodings)
+        {
+            entry.referenceRegions.push_back(decode(contigInfo, encoding.get<string>()));
+        }
+    }
+    else
+    {
+        entry.referenceRegions.push_back(decode(contigInfo, regionEncodings.get<string>()));
+    }
+
+    return entry;
+}
+
+}
+
+CatalogIndex::CatalogIndex(const string& catalogText, const ReferenceContigInfo& contigInfo)
+{
+    std::unordered_map<int32_t, vector<Interval<int64_t, std::size_t>>> contigToIntervals;
+
+    for (const auto& boundaries : findRecordBoundaries(catalogText))
+    {
+        const std::size_t entryIndex = entries_.size();
+        entries_.push_back(decodeEntry(catalogText, boundaries.first, boundaries.second, contigInfo));
+        const CatalogEntry& entry = entries_.back();
+
+        if (!locusIdToEntryIndex_.emplace(entry.locusId, entryIndex).second)
+        {
+            throw std::logic_error("Catalog contains multiple loci with id " + entry.locusId);
+        }
+
+        for (const auto& region : entry.referenceRegions)
+        {
+            contigToIntervals[region.contigIndex()].emplace_back(region.start(), region.end(), entryIndex);
+        }
+    }
+
+    for (auto& contigAndIntervals : contigToIntervals)
+    {
+        intervalTrees_.emplace(contigAndIntervals.first, EntryIntervalTree(std::move(contigAndIntervals.second)));
+    }
+}
+
+optional<std::size_t> CatalogIndex::findLocus(const string& locusId) const
+{
+    const auto entryIterator = locusIdToEntryIndex_.find(locusId);
+    if (entryIterator == locusIdToEntryIndex_.end())
+    {
+        return boost::none;
+    }
+    return entryIterator->second;
+}
+
+vector<std::size_t> CatalogIndex::findOverlappingLoci(const GenomicRegion& region) const
+{
+    const auto treeIterator = intervalTrees_.find(region.contigIndex());
+    if (treeIterator == intervalTrees_.end())
+    {
+        return {};
+    }
+
+    // Consistent with GenomicRegion::overlaps, regions sharing an endpoint are considered overlapping
+    vector<std::size_t> entryIndexes;
+    for (const auto& interval : treeIterator->second.findOverlapping(region.start(), region.end()))
+    {
+        entryIndexes.push_back(interval.value);
+    }
+
+    std::sort(entryIndexes.begin(), entryIndexes.end());
+    entryIndexes.erase(std::unique(entryIndexes.begin(), entryIndexes.end()), entryIndexes.end());
+    return entryIndexes;
+}
+
+}
@@ -0,0 +1,74 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "thirdparty/intervaltree/IntervalTree.h"
+
+#include "core/GenomicRegion.hh"
+#include "core/ReferenceContigInfo.hh"
+
+namespace ehunter
+{
+
+/// Location of a single locus record within the text of a catalog file
+struct CatalogEntry
+{
+    std::string locusId;
+    std::vector<GenomicRegion> referenceRegions;
+    std::size_t offset;
+    std::size_t length;
+};
+
+/// \brief Index of catalog records by locus id and reference region
+///
+/// The index is built by scanning the catalog text for the boundaries of locus records and extracting only the id and
+/// the reference regions of each record, so that a subset of loci can be decoded without processing the whole catalog
+///
+class CatalogIndex
+{
+public:
+    /// \param[in] catalogText Content of a catalog file
+    /// \param[in] contigInfo Contigs used to decode the reference regions
+    CatalogIndex(const std::string& catalogText, const ReferenceContigInfo& contigInfo);
+
+    const std::vector<CatalogEntry>& entries() const { return entries_; }
+
+    /// Index of the entry with the given locus id or none if the catalog does not contain the locus
+    boost::optional<std::size_t> findLocus(const std::string& locusId) const;
+
+    /// Indexes of entries with a reference region overlapping the query region in catalog order
+    std::vector<std::size_t> findOverlappingLoci(const GenomicRegion& region) const;
+
+private:
+    using EntryIntervalTree = IntervalTree<int64_t, std::size_t>;
+
+    std::vector<CatalogEntry> entries_;
+    std::unordered_map<std::string, std::size_t> locusIdToEntryIndex_;
+    std::unordered_map<int32_t, EntryIntervalTree> intervalTrees_;
+};
+
+}
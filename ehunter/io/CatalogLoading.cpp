@@ -38,6 +38,7 @@
 
 #include "core/Common.hh"
 #include "core/Reference.hh"
+#include "io/CatalogIndex.hh"
 #include "io/LocusSpecDecoding.hh"
 
 using boost::optional;
@@ -223,11 +224,58 @@ static LocusDescriptionFromUser loadUserDescription(Json& locusJson, const Refer
         }
     }
 
+    static const std::string motifCompositionAnalysisKey("MotifCompositionAnalysis");
+    if (checkIfFieldExists(locusJson, motifCompositionAnalysisKey))
+    {
+        const Json& record(locusJson[motifCompositionAnalysisKey]);
+        if (record.type() != Json::value_t::boolean)
+        {
+            std::stringstream out;
+            out << record;
+            throw std::logic_error(
+                "Key '" + motifCompositionAnalysisKey + "' must have a boolean value type, observed value is '"
+                + out.str() + "'");
+        }
+        userDescription.useMotifCompositionAnalysis = record.get<bool>();
+    }
+
     return userDescription;
 }
 
+static vector<std::size_t> selectCatalogEntries(
+    const CatalogIndex& catalogIndex, const LocusSelection& locusSelection, const ReferenceContigInfo& contigInfo)
+{
+    vector<std::size_t> entryIndexes;
+    for (const auto& locusId : locusSelection.locusIds())
+    {
+        const auto entryIndex = catalogIndex.findLocus(locusId);
+        if (!entryIndex)
+        {
+            throw std::invalid_argument("Locus " + locusId + " is not present in the catalog");
+        }
+        entryIndexes.push_back(*entryIndex);
+    }
+
+    for (const auto& regionEncoding : locusSelection.regionEncodings())
+    {
+        const GenomicRegion region = decode(contigInfo, regionEncoding);
+        const vector<std::size_t> overlappingEntryIndexes = catalogIndex.findOverlappingLoci(region);
+        if (overlappingEntryIndexes.empty())
+        {
+            spd::warn("No catalog loci overlap region {}", regionEncoding);
+        }
+        entryIndexes.insert(entryIndexes.end(), overlappingEntryIndexes.begin(), overlappingEntryIndexes.end());
+    }
+
+    // Selected loci are kept in catalog order
+    std::sort(entryIndexes.begin(), entryIndexes.end());
+    entryIndexes.erase(std::unique(entryIndexes.begin(), entryIndexes.end()), entryIndexes.end());
+    return entryIndexes;
+}
+
 RegionCatalog loadLocusCatalogFromDisk(
-    const string& catalogPath, const HeuristicParameters& heuristicParams, const Reference& reference)
+    const string& catalogPath, const HeuristicParameters& heuristicParams, const Reference& reference,
+    const LocusSelection& locusSelection)
 {
     std::ifstream inputStream(catalogPath.c_str());
 
@@ -236,11 +284,34 @@ RegionCatalog loadLocusCatalogFromDisk(
         throw std::runtime_error("Failed to open catalog file " + catalogPath);
     }
 
+    RegionCatalog catalog;
+    if (!locusSelection.empty())
+    {
+        std::stringstream catalogStream;
+        catalogStream << inputStream.rdbuf();
+        const string catalogText = catalogStream.str();
+
+        const CatalogIndex catalogIndex(catalogText, reference.contigInfo());
+        const vector<std::size_t> entryIndexes
+            = selectCatalogEntries(catalogIndex, locusSelection, reference.contigInfo());
+        spd::info("Selected {} of {} catalog loci", entryIndexes.size(), catalogIndex.entries().size());
+
+        catalog.reserve(entryIndexes.size());
+        for (const std::size_t entryIndex : entryIndexes)
+        {
+            const CatalogEntry& entry = catalogIndex.entries()[entryIndex];
+            Json locusJson = Json::parse(catalogText.substr(entry.offset, entry.length));
+            LocusDescriptionFromUser userDescription = loadUserDescription(locusJson, reference.contigInfo());
+            catalog.push_back(decodeLocusSpecification(userDescription, reference, heuristicParams));
+        }
+
+        return catalog;
+    }
+
     Json catalogJson;
     inputStream >> catalogJson;
     makeArray(catalogJson);
 
-    RegionCatalog catalog;
     catalog.reserve(catalogJson.size());
     for (auto& locusJson : catalogJson)
     {
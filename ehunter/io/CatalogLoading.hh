@@ -32,7 +32,13 @@
 namespace ehunter
 {
 
+/// \brief Load the catalog file and build the specifications of its loci
+///
+/// \param[in] locusSelection If not empty, only the selected loci are decoded; the remaining records are skipped
+/// without being fully parsed
+///
 RegionCatalog loadLocusCatalogFromDisk(
-    const std::string& catalogPath, const HeuristicParameters& heuristicParams, const Reference& reference);
+    const std::string& catalogPath, const HeuristicParameters& heuristicParams, const Reference& reference,
+    const LocusSelection& locusSelection = LocusSelection());
 
 }
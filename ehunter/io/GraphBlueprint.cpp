@@ -107,48 +107,115 @@ vector<string> tokenizeRegex(const string& regex)
     return tokens;
 }
 
-TokenParser::TokenParser()
-    : skippableRepeatRegex_("^\\([ACGTBDHKMNSRVWY]+\\)\\*$")
-    , unskippableRepeatRegex_("^\\([ACGTBDHKMNSRVWY]+\\)\\+$")
-    , insertionOrDeletionRegex_("^\\([ACGTBDHKMNSRVWY]+\\)\\?$")
-    , swapRegex_("^\\([ACGTBDHKMNSRVWY]+\\|[ACGTBDHKMNSRVWY]+\\)$")
-    , interruptionRegex_("^[ACGTBDHKMNSRVWY]+$")
+namespace
 {
-}
 
-FeatureTypeAndSequences TokenParser::parse(const string& token) const
+const string kBaseSymbols("ACGTBDHKMNSRVWY");
+
+bool isBase(char symbol) { return kBaseSymbols.find(symbol) != string::npos; }
+
+// Single-pass parser of locus structures; each feature is parsed from the position where the previous one ended
+class LocusStructureParser
 {
-    if (std::regex_match(token, insertionOrDeletionRegex_))
+public:
+    explicit LocusStructureParser(const string& structure)
+        : structure_(structure)
     {
-        auto sequence = token.substr(1, token.size() - 3);
-        return { GraphBlueprintFeatureType::kInsertionOrDeletion, { sequence } };
     }
-    else if (std::regex_match(token, skippableRepeatRegex_))
+
+    bool reachedEnd() const { return position_ == structure_.size(); }
+
+    FeatureTypeAndSequences parseNextFeature()
     {
-        auto sequence = token.substr(1, token.size() - 3);
-        return { GraphBlueprintFeatureType::kSkippableRepeat, { sequence } };
+        if (isBase(currentSymbol()))
+        {
+            return { GraphBlueprintFeatureType::kInterruption, { parseSequence() } };
+        }
+
+        expectSymbol('(');
+        auto sequence = parseSequence();
+        if (currentSymbol() == '|')
+        {
+            ++position_;
+            auto secondAllele = parseSequence();
+            expectSymbol(')');
+            return { GraphBlueprintFeatureType::kSwap, { std::move(sequence), std::move(secondAllele) } };
+        }
+
+        expectSymbol(')');
+        switch (currentSymbol())
+        {
+        case '*':
+            ++position_;
+            return { GraphBlueprintFeatureType::kSkippableRepeat, { std::move(sequence) } };
+        case '+':
+            ++position_;
+            return { GraphBlueprintFeatureType::kUnskippableRepeat, { std::move(sequence) } };
+        case '?':
+            ++position_;
+            return { GraphBlueprintFeatureType::kInsertionOrDeletion, { std::move(sequence) } };
+        default:
+            throwError("expected *, + or ?");
+        }
     }
-    else if (std::regex_match(token, unskippableRepeatRegex_))
+
+    [[noreturn]] void throwError(const string& problem) const
     {
-        auto sequence = token.substr(1, token.size() - 3);
-        return { GraphBlueprintFeatureType::kUnskippableRepeat, { sequence } };
+        const string found = reachedEnd() ? "end of structure" : string("'") + currentSymbol() + "'";
+        throw std::logic_error(
+            "Could not parse locus structure " + structure_ + ": " + problem + " but found " + found + " at position "
+            + std::to_string(position_));
     }
-    else if (std::regex_match(token, swapRegex_))
+
+private:
+    // Returns '\0' past the end of the structure, which matches no valid symbol
+    char currentSymbol() const { return reachedEnd() ? '\0' : structure_[position_]; }
+
+    string parseSequence()
     {
-        auto sequence = token.substr(1, token.size() - 2);
-        int pipePosition = sequence.find('|');
-        auto firstAllele = sequence.substr(0, pipePosition);
-        auto secondAllele = sequence.substr(pipePosition + 1);
-        return { GraphBlueprintFeatureType::kSwap, { firstAllele, secondAllele } };
+        const size_t sequenceStart = position_;
+        while (isBase(currentSymbol()))
+        {
+            ++position_;
+        }
+
+        if (position_ == sequenceStart)
+        {
+            throwError("expected a base");
+        }
+        return structure_.substr(sequenceStart, position_ - sequenceStart);
+    }
+
+    void expectSymbol(char symbol)
+    {
+        if (currentSymbol() != symbol)
+        {
+            throwError(string("expected '") + symbol + "'");
+        }
+        ++position_;
     }
-    else if (std::regex_match(token, interruptionRegex_))
+
+    const string& structure_;
+    size_t position_ = 0;
+};
+
+}
+
+FeatureTypeAndSequences TokenParser::parse(const string& token) const
+{
+    LocusStructureParser parser(token);
+    if (parser.reachedEnd())
     {
-        return { GraphBlueprintFeatureType::kInterruption, { token } };
+        throw std::logic_error("Could not parse an empty token");
     }
-    else
+
+    auto featureTypeAndSequences = parser.parseNextFeature();
+    if (!parser.reachedEnd())
     {
-        throw std::logic_error("Could not parse the token " + token);
+        parser.throwError("expected the token to end");
     }
+
+    return featureTypeAndSequences;
 }
 
 std::ostream& operator<<(std::ostream& out, GraphBlueprintFeatureType tokenType)
@@ -205,17 +272,18 @@ GraphBlueprint decodeFeaturesFromRegex(const string& regex)
 {
     GraphBlueprint blueprint;
 
-    const auto tokens = tokenizeRegex(regex);
-    TokenParser parser;
+    vector<FeatureTypeAndSequences> features;
+    LocusStructureParser parser(regex);
+    while (!parser.reachedEnd())
+    {
+        features.push_back(parser.parseNextFeature());
+    }
 
     NodeId firstUnusedNodeId = 0;
-    for (int index = 0; index != static_cast<int>(tokens.size()); ++index)
+    for (int index = 0; index != static_cast<int>(features.size()); ++index)
     {
-        const auto& token = tokens[index];
-        auto featureTypeAndSequences = parser.parse(token);
-
-        auto featureType = featureTypeAndSequences.first;
-        const auto& sequences = featureTypeAndSequences.second;
+        auto featureType = features[index].first;
+        const auto& sequences = features[index].second;
 
         if (index == 0)
         {
@@ -227,7 +295,7 @@ GraphBlueprint decodeFeaturesFromRegex(const string& regex)
             blueprint.push_back(GraphBlueprintFeature(featureType, sequences, { firstUnusedNodeId }));
             ++firstUnusedNodeId;
         }
-        else if (index == static_cast<int>(tokens.size()) - 1)
+        else if (index == static_cast<int>(features.size()) - 1)
         {
             if (featureType == GraphBlueprintFeatureType::kInterruption)
             {
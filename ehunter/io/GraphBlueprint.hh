@@ -23,7 +23,6 @@
 
 #include <iostream>
 #include <memory>
-#include <regex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -54,16 +53,7 @@ std::vector<std::string> tokenizeRegex(const std::string& regex);
 class TokenParser
 {
 public:
-    TokenParser();
-
     FeatureTypeAndSequences parse(const std::string& token) const;
-
-private:
-    std::regex skippableRepeatRegex_;
-    std::regex unskippableRepeatRegex_;
-    std::regex insertionOrDeletionRegex_;
-    std::regex swapRegex_;
-    std::regex interruptionRegex_;
 };
 
 struct GraphBlueprintFeature
@@ -75,6 +65,11 @@ struct GraphBlueprintFeature
         , nodeIds(std::move(nodeIds))
     {
     }
+    bool operator==(const GraphBlueprintFeature& other) const
+    {
+        return type == other.type && sequences == other.sequences && nodeIds == other.nodeIds;
+    }
+
     GraphBlueprintFeatureType type;
     std::vector<std::string> sequences;
     std::vector<graphtools::NodeId> nodeIds;
@@ -82,6 +77,10 @@ struct GraphBlueprintFeature
 
 using GraphBlueprint = std::vector<GraphBlueprintFeature>;
 
+/// \brief Decode the features of a locus structure such as ATCG(CAG)*CAACAG(CCG)*GCTA
+///
+/// Throws std::logic_error giving the position of the first symbol that does not fit the locus structure grammar
+///
 GraphBlueprint decodeFeaturesFromRegex(const std::string& regex);
 
 std::ostream& operator<<(std::ostream& out, GraphBlueprintFeatureType tokenType);
@@ -48,12 +48,15 @@ std::ostream& operator<<(std::ostream& out, JsonWriter& jsonWriter)
 }
 
 JsonWriter::JsonWriter(
-    const SampleParameters& sampleParams, const ReferenceContigInfo& contigInfo, const RegionCatalog& regionCatalog,
-    const SampleFindings& sampleFindings)
+    const SampleParameters& sampleParams, const VariantRecordTemplates& recordTemplates,
+    const RegionCatalog& regionCatalog, const SampleFindings& sampleFindings, boost::optional<double> genomeWideDepth,
+    const SampleQcSummary* sampleQc)
     : sampleParams_(sampleParams)
-    , contigInfo_(contigInfo)
+    , recordTemplates_(recordTemplates)
     , regionCatalog_(regionCatalog)
     , sampleFindings_(sampleFindings)
+    , genomeWideDepth_(genomeWideDepth)
+    , sampleQc_(sampleQc)
 {
 }
 
@@ -62,6 +65,10 @@ void JsonWriter::write(std::ostream& out)
     Json sampleParametersRecord;
     sampleParametersRecord["SampleId"] = sampleParams_.id();
     sampleParametersRecord["Sex"] = streamToString(sampleParams_.sex());
+    if (genomeWideDepth_)
+    {
+        sampleParametersRecord["GenomeWideDepth"] = *genomeWideDepth_;
+    }
 
     Json resultsRecord;
     const unsigned locusCount(sampleFindings_.size());
@@ -74,6 +81,11 @@ void JsonWriter::write(std::ostream& out)
         Json locusRecord;
         locusRecord["LocusId"] = locusId;
         locusRecord["Coverage"] = locusFindings.stats.depth();
+        if (locusFindings.stats.indexDepth())
+        {
+            locusRecord["LocalCoverage"] = locusFindings.stats.localDepth();
+            locusRecord["IndexCoverage"] = *locusFindings.stats.indexDepth();
+        }
         locusRecord["ReadLength"] = locusFindings.stats.meanReadLength();
         locusRecord["FragmentLength"] = locusFindings.stats.medianFragLength();
         locusRecord["AlleleCount"] = static_cast<int>(locusFindings.stats.alleleCount());
@@ -84,7 +96,7 @@ void JsonWriter::write(std::ostream& out)
             const string& variantId = variantIdAndFindings.first;
             const VariantSpecification& variantSpec = locusSpec.getVariantSpecById(variantId);
 
-            VariantJsonWriter variantWriter(contigInfo_, locusSpec, variantSpec);
+            VariantJsonWriter variantWriter(recordTemplates_.get(locusId, variantId), variantSpec);
             variantIdAndFindings.second->accept(&variantWriter);
             variantRecords[variantId] = variantWriter.record();
         }
@@ -103,6 +115,29 @@ void JsonWriter::write(std::ostream& out)
     }
     sampleRecords["SampleParameters"] = sampleParametersRecord;
 
+    if (sampleQc_)
+    {
+        Json sampleQcRecord;
+        sampleQcRecord["SampledReadCount"] = sampleQc_->sampledReadCount;
+        sampleQcRecord["MinReadLength"] = sampleQc_->minReadLength;
+        sampleQcRecord["MedianReadLength"] = sampleQc_->medianReadLength;
+        sampleQcRecord["MaxReadLength"] = sampleQc_->maxReadLength;
+        sampleQcRecord["MedianFragmentLength"] = sampleQc_->medianFragmentLength;
+        if (sampleQc_->xDepthRatio)
+        {
+            sampleQcRecord["ChrXDepthRatio"] = *sampleQc_->xDepthRatio;
+        }
+        if (sampleQc_->yDepthRatio)
+        {
+            sampleQcRecord["ChrYDepthRatio"] = *sampleQc_->yDepthRatio;
+        }
+        if (sampleQc_->inferredSex)
+        {
+            sampleQcRecord["InferredSex"] = streamToString(*sampleQc_->inferredSex);
+        }
+        sampleRecords["SampleQC"] = sampleQcRecord;
+    }
+
     out << std::setw(2) << sampleRecords << std::endl;
 }
 
@@ -124,15 +159,7 @@ void VariantJsonWriter::visit(const RepeatFindings* repeatFindingsPtr)
 
     const RepeatFindings& repeatFindings = *repeatFindingsPtr;
 
-    record_.clear();
-    record_["VariantId"] = variantSpec_.id();
-    record_["ReferenceRegion"] = encode(contigInfo_, variantSpec_.referenceLocus());
-    record_["VariantType"] = streamToString(variantSpec_.classification().type);
-    record_["VariantSubtype"] = streamToString(variantSpec_.classification().subtype);
-
-    const auto repeatNodeId = variantSpec_.nodes().front();
-    const auto& repeatUnit = locusSpec_.regionGraph().nodeSeq(repeatNodeId);
-    record_["RepeatUnit"] = repeatUnit;
+    record_ = recordTemplate_.jsonRecord;
 
     record_["CountsOfSpanningReads"] = streamToString(repeatFindings.countsOfSpanningReads());
     record_["CountsOfFlankingReads"] = streamToString(repeatFindings.countsOfFlankingReads());
@@ -152,16 +179,22 @@ void VariantJsonWriter::visit(const RepeatFindings* repeatFindingsPtr)
         rfc1Results["Description"] = rfc1Status->description;
         record_["RFC1MotifAnalysis"] = rfc1Results;
     }
+
+    if (repeatFindings.motifComposition())
+    {
+        nlohmann::json motifComposition = nlohmann::json::array();
+        for (const auto& motifAndCount : *repeatFindings.motifComposition())
+        {
+            motifComposition.push_back({ { "Motif", motifAndCount.first }, { "Count", motifAndCount.second } });
+        }
+        record_["MotifComposition"] = motifComposition;
+    }
 }
 
 void VariantJsonWriter::visit(const SmallVariantFindings* smallVariantFindingsPtr)
 {
     const SmallVariantFindings& findings = *smallVariantFindingsPtr;
-    record_.clear();
-    record_["VariantId"] = variantSpec_.id();
-    record_["VariantType"] = streamToString(variantSpec_.classification().type);
-    record_["VariantSubtype"] = streamToString(variantSpec_.classification().subtype);
-    record_["ReferenceRegion"] = encode(contigInfo_, variantSpec_.referenceLocus());
+    record_ = recordTemplate_.jsonRecord;
     record_["CountOfRefReads"] = findings.numRefReads();
     record_["CountOfAltReads"] = findings.numAltReads();
     record_["StatusOfRefAllele"] = streamToString(findings.refAllelePresenceStatus().status);
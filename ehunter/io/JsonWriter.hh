@@ -21,7 +21,11 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "core/Parameters.hh"
+#include "io/SampleStats.hh"
+#include "io/VariantRecordTemplates.hh"
 #include "locus/LocusFindings.hh"
 #include "locus/LocusSpecification.hh"
 
@@ -33,11 +37,8 @@ namespace ehunter
 class VariantJsonWriter : public VariantFindingsVisitor
 {
 public:
-    VariantJsonWriter(
-        const ReferenceContigInfo& contigInfo, const LocusSpecification& locusSpec,
-        const VariantSpecification& variantSpec)
-        : contigInfo_(contigInfo)
-        , locusSpec_(locusSpec)
+    VariantJsonWriter(const VariantRecordTemplate& recordTemplate, const VariantSpecification& variantSpec)
+        : recordTemplate_(recordTemplate)
         , variantSpec_(variantSpec)
     {
     }
@@ -48,8 +49,7 @@ public:
     nlohmann::json record() const { return record_; }
 
 private:
-    const ReferenceContigInfo& contigInfo_;
-    const LocusSpecification& locusSpec_;
+    const VariantRecordTemplate& recordTemplate_;
     const VariantSpecification& variantSpec_;
     nlohmann::json record_;
 };
@@ -57,17 +57,22 @@ private:
 class JsonWriter
 {
 public:
+    /// \param[in] genomeWideDepth Depth of the sample estimated independently of the loci, if available
+    /// \param[in] sampleQc Summary of the sample QC pre-pass, if it was run
     JsonWriter(
-        const SampleParameters& sampleParams, const ReferenceContigInfo& contigInfo, const RegionCatalog& regionCatalog,
-        const SampleFindings& sampleFindings);
+        const SampleParameters& sampleParams, const VariantRecordTemplates& recordTemplates,
+        const RegionCatalog& regionCatalog, const SampleFindings& sampleFindings,
+        boost::optional<double> genomeWideDepth = boost::none, const SampleQcSummary* sampleQc = nullptr);
 
     void write(std::ostream& out);
 
 private:
     const SampleParameters& sampleParams_;
-    const ReferenceContigInfo& contigInfo_;
+    const VariantRecordTemplates& recordTemplates_;
     const RegionCatalog& regionCatalog_;
     const SampleFindings& sampleFindings_;
+    boost::optional<double> genomeWideDepth_;
+    const SampleQcSummary* sampleQc_;
 };
 
 std::ostream& operator<<(std::ostream& out, JsonWriter& jsonWriter);
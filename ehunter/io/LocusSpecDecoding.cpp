@@ -29,6 +29,7 @@
 
 #include "io/GraphBlueprint.hh"
 #include "io/RegionGraph.hh"
+#include "locus/MotifComposition.hh"
 
 using boost::optional;
 using graphtools::Graph;
@@ -302,6 +303,7 @@ LocusSpecification decodeLocusSpecification(
             userDescription.locusId, chromType, std::move(targetReadExtractionRegions), std::move(locusGraph),
             std::move(referenceRegionsOfGraphNodes), std::move(parameters), userDescription.useRFC1MotifAnalysis);
         locusSpec.setOfftargetReadExtractionRegions(userDescription.offtargetRegions);
+        locusSpec.setMotifCompositionAnalysis(userDescription.useMotifCompositionAnalysis);
 
         int variantIndex = 0;
         for (const auto& feature : blueprint)
@@ -376,6 +378,22 @@ void assertValidity(const LocusDescriptionFromUser& userDescription)
                   " exactly one variant of type 'Repeat' is defined.");
         }
     }
+
+    if (userDescription.useMotifCompositionAnalysis)
+    {
+        for (const GraphBlueprintFeature& feature : blueprint)
+        {
+            const bool isRepeat = feature.type == GraphBlueprintFeatureType::kSkippableRepeat
+                || feature.type == GraphBlueprintFeatureType::kUnskippableRepeat;
+            if (isRepeat && static_cast<int>(feature.sequences.front().length()) > kMaxCompositionMotifLength)
+            {
+                throw std::runtime_error(
+                    "Locus " + userDescription.locusId + " has option 'MotifCompositionAnalysis' enabled, which is"
+                    + " not supported for repeat units longer than " + to_string(kMaxCompositionMotifLength)
+                    + " bases such as " + feature.sequences.front());
+            }
+        }
+    }
 }
 
 }
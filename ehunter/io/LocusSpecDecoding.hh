@@ -59,6 +59,9 @@ struct LocusDescriptionFromUser
 
     /// If true, turn on additional motif processing for a repeat
     bool useRFC1MotifAnalysis = false;
+
+    /// If true, report the motif composition of each repeat of the locus
+    bool useMotifCompositionAnalysis = false;
 };
 
 void assertValidity(const LocusDescriptionFromUser& userDescription);
@@ -21,9 +21,11 @@
 
 #include "io/ParameterLoading.hh"
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
+#include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/optional.hpp>
 #include <boost/program_options.hpp>
@@ -48,6 +50,11 @@ struct UserParameters
     string htsFilePath;
     string referencePath;
     string catalogPath;
+    string alignmentCachePath;
+
+    // Catalog subset
+    string locusIdEncoding;
+    string regionEncoding;
 
     // Output prefix
     string outputPrefix;
@@ -60,14 +67,55 @@ struct UserParameters
     int regionExtensionLength;
     double minLocusCoverage = 10.0;
     int qualityCutoffForGoodBaseCall = 20;
-    bool skipUnaligned;
+    bool skipUnaligned = true;
 
     string analysisMode;
     string logLevel;
+    string alignmentValidation;
+    string depthSource;
     int threadCount;
     bool disableBamletOutput = false;
+    bool alignInRepeatReadsDirectly = false;
+    bool writeAlignmentCache = false;
+    bool resume = false;
+    bool server = false;
+    bool trimLowQualityEnds = false;
+    int alignmentMemoSize = 0;
+    bool pinThreads = false;
+    int prefetchLoci = 0;
 };
 
+static string encodeValidationLevel(graphtools::ValidationLevel level)
+{
+    switch (level)
+    {
+    case graphtools::ValidationLevel::kOff:
+        return "off";
+    case graphtools::ValidationLevel::kSampled:
+        return "sampled";
+    case graphtools::ValidationLevel::kFull:
+        return "full";
+    }
+    throw std::logic_error("Unknown validation level");
+}
+
+static graphtools::ValidationLevel decodeValidationLevel(const string& encoding)
+{
+    if (encoding == "off")
+    {
+        return graphtools::ValidationLevel::kOff;
+    }
+    if (encoding == "sampled")
+    {
+        return graphtools::ValidationLevel::kSampled;
+    }
+    if (encoding == "full")
+    {
+        return graphtools::ValidationLevel::kFull;
+    }
+    throw std::invalid_argument(encoding + " is not a valid alignment validation level; use off, sampled, or full");
+}
+
 boost::optional<UserParameters> tryParsingUserParameters(int argc, char** argv)
 {
     UserParameters params;
@@ -77,23 +125,39 @@ boost::optional<UserParameters> tryParsingUserParameters(int argc, char** argv)
     basicOptions.add_options()
         ("help,h", "Print help message")
         ("version,v", "Print version number")
-        ("reads", po::value<string>(&params.htsFilePath)->required(), "aligned reads BAM/CRAM file/URL")
+        ("reads", po::value<string>(&params.htsFilePath)->required(), "aligned reads BAM/CRAM file/URL, or - to stream SAM/BAM from the standard input")
         ("reference", po::value<string>(&params.referencePath)->required(), "reference genome FASTA file")
         ("variant-catalog", po::value<string>(&params.catalogPath)->required(), "JSON file with variants to genotype")
         ("output-prefix", po::value<string>(&params.outputPrefix)->required(), "Prefix for the output files")
-        ("sex", po::value<string>(&params.sampleSexEncoding)->default_value("female"), "Sex of the sample; must be either male or female")
+        ("sex", po::value<string>(&params.sampleSexEncoding)->default_value("female"), "Sex of the sample; must be either male, female, or auto to infer it from the reads")
+        ("locus-ids", po::value<string>(&params.locusIdEncoding), "Comma-separated ids of catalog loci to analyze")
+        ("regions", po::value<string>(&params.regionEncoding), "Comma-separated regions (chr:start-end); catalog loci overlapping any of them are analyzed")
     ;
     // clang-format on
 
+    const string defaultAlignmentValidation = encodeValidationLevel(graphtools::getValidationLevel());
+
     // clang-format off
     po::options_description advancedOptions("Advanced options");
     advancedOptions.add_options()
         ("region-extension-length", po::value<int>(&params.regionExtensionLength)->default_value(1000), "How far from on/off-target regions to search for informative reads")
         ("min-locus-coverage", po::value<double>(&params.minLocusCoverage)->default_value(10.0), "Minimum read coverage depth for diploid loci (set to half for loci on haploid chromosomes)")
         ("aligner", po::value<string>(&params.alignerType)->default_value("dag-aligner"), "Graph aligner to use (dag-aligner or path-aligner)")
-        ("analysis-mode", po::value<string>(&params.analysisMode)->default_value("seeking"), "Analysis workflow to use (seeking or streaming)")
+        ("analysis-mode", po::value<string>(&params.analysisMode)->default_value("seeking"), "Analysis workflow to use (seeking, streaming or extract)")
         ("threads", po::value(&params.threadCount)->default_value(1), "Number of threads to use")
+        ("pin-threads", "Pin worker threads to CPUs spread over the NUMA nodes of the machine")
+        ("prefetch-loci", po::value<int>(&params.prefetchLoci)->default_value(0), "Number of loci ahead of the worker threads whose reads are prefetched from a local BAM file in seeking mode (0 to disable)")
         ("log-level", po::value<string>(&params.logLevel)->default_value("info"), "trace, debug, info, warn, or error")
+        ("write-alignment-cache", "Write read alignments of all loci to an alignment cache for fast re-genotyping")
+        ("from-alignment-cache", po::value<string>(&params.alignmentCachePath), "Genotype from an alignment cache written by an earlier run instead of re-aligning the reads")
+        ("resume", "Resume or update an earlier run with the same output prefix, skipping loci with unchanged records in its alignment cache (implies --write-alignment-cache)")
+        ("server", "Keep the reference and catalog loaded and run analysis jobs read as JSON lines from the standard input")
+        ("trim-low-quality-ends", "Align only the high-quality core of each read and softclip its low-quality ends")
+        ("align-in-repeat-reads-directly", "Align reads that exactly tile a repeat motif without running the graph aligner")
+        ("alignment-memo-size", po::value<int>(&params.alignmentMemoSize)->default_value(0), "Number of distinct read sequences per locus whose alignments are reused for identical reads (0 to disable)")
+        ("rescue-unmapped-reads", "Screen unmapped read pairs for in-repeat reads of rare repeats (streaming mode only)")
+        ("alignment-validation", po::value<string>(&params.alignmentValidation)->default_value(defaultAlignmentValidation), "Consistency checks of graph alignments to perform (off, sampled, or full)")
+        ("depth-source", po::value<string>(&params.depthSource)->default_value("locus"), "Source of the read depth used for genotyping (locus for reads at each locus or index to also use mapped read counts of the alignment file index)")
     ;
     // clang-format on
 
@@ -129,6 +193,13 @@ boost::optional<UserParameters> tryParsingUserParameters(int argc, char** argv)
     }
 
     params.disableBamletOutput = argumentMap.count("disable-bamlet-output");
+    params.alignInRepeatReadsDirectly = argumentMap.count("align-in-repeat-reads-directly");
+    params.resume = argumentMap.count("resume");
+    params.writeAlignmentCache = argumentMap.count("write-alignment-cache") || params.resume;
+    params.server = argumentMap.count("server");
+    params.trimLowQualityEnds = argumentMap.count("trim-low-quality-ends");
+    params.skipUnaligned = !argumentMap.count("rescue-unmapped-reads");
+    params.pinThreads = argumentMap.count("pin-threads");
 
     po::notify(argumentMap);
 
@@ -179,20 +250,79 @@ static void assertIndexExists(const string& htsFilePath)
 void assertValidity(const UserParameters& userParameters)
 {
     // Validate analysis Mode:
-    if ((userParameters.analysisMode != "seeking") and (userParameters.analysisMode != "streaming"))
+    if ((userParameters.analysisMode != "seeking") and (userParameters.analysisMode != "streaming")
+        and (userParameters.analysisMode != "extract"))
     {
         throw std::invalid_argument(userParameters.analysisMode + " is not a valid analysis mode");
     }
 
+    if (userParameters.depthSource != "locus" && userParameters.depthSource != "index")
+    {
+        throw std::invalid_argument(userParameters.depthSource + " is not a valid depth source; use locus or index");
+    }
+
+    const bool isAlignmentCacheInput = !userParameters.alignmentCachePath.empty();
+
+    if (!userParameters.skipUnaligned && (userParameters.analysisMode != "streaming" || isAlignmentCacheInput))
+    {
+        throw std::invalid_argument("Unmapped reads can only be rescued when streaming an alignment file");
+    }
+
     // Validate input file paths
-    if (not isURL(userParameters.htsFilePath))
+    if (isStreamOnlyPath(userParameters.htsFilePath))
     {
-        assertPathToExistingFile(userParameters.htsFilePath);
         if (userParameters.analysisMode != "streaming")
+        {
+            throw std::invalid_argument(
+                "Reads from the standard input or a named pipe can only be analyzed in streaming mode");
+        }
+        if (isAlignmentCacheInput || userParameters.resume || userParameters.server)
+        {
+            throw std::invalid_argument(
+                "Reads from the standard input or a named pipe cannot be combined with alignment cache input, resumed "
+                "runs, or server mode");
+        }
+        if (userParameters.depthSource == "index" || userParameters.sampleSexEncoding == kInferredSexEncoding)
+        {
+            throw std::invalid_argument(
+                "Reads from the standard input or a named pipe have no index to estimate depth or infer sex from");
+        }
+    }
+    else if (not isURL(userParameters.htsFilePath))
+    {
+        const bool requiresIndex
+            = userParameters.depthSource == "index" || userParameters.sampleSexEncoding == kInferredSexEncoding;
+        // Genotyping from an alignment cache does not read the alignment file
+        if (!isAlignmentCacheInput || requiresIndex)
+        {
+            assertPathToExistingFile(userParameters.htsFilePath);
+        }
+        if ((userParameters.analysisMode != "streaming" && !isAlignmentCacheInput) || requiresIndex)
         {
             assertIndexExists(userParameters.htsFilePath);
         }
     }
+    if (isAlignmentCacheInput)
+    {
+        assertPathToExistingFile(userParameters.alignmentCachePath);
+        if (userParameters.writeAlignmentCache)
+        {
+            throw std::invalid_argument(
+                "Alignment cache output (including resumed runs) cannot be combined with alignment cache input");
+        }
+        if (userParameters.analysisMode == "extract")
+        {
+            throw std::invalid_argument("Read evidence cannot be extracted from an alignment cache");
+        }
+    }
+    if (userParameters.server && (isAlignmentCacheInput || userParameters.resume))
+    {
+        throw std::invalid_argument("Server mode cannot be combined with alignment cache input or resumed runs");
+    }
+    if (userParameters.server && userParameters.analysisMode == "extract")
+    {
+        throw std::invalid_argument("Server jobs run in seeking or streaming mode; extract mode is not supported");
+    }
     assertPathToExistingFile(userParameters.referencePath);
     assertPathToExistingFile(userParameters.catalogPath);
 
@@ -200,7 +330,8 @@ void assertValidity(const UserParameters& userParameters)
     assertWritablePath(userParameters.outputPrefix);
 
     // Validate sample parameters
-    if (userParameters.sampleSexEncoding != "female" && userParameters.sampleSexEncoding != "male")
+    if (userParameters.sampleSexEncoding != "female" && userParameters.sampleSexEncoding != "male"
+        && userParameters.sampleSexEncoding != kInferredSexEncoding)
     {
         throw std::invalid_argument(userParameters.sampleSexEncoding + " is not a valid sex encoding");
     }
@@ -238,16 +369,39 @@ void assertValidity(const UserParameters& userParameters)
         const string message = "Thread count cannot be less than 1";
         throw std::invalid_argument(message);
     }
+
+    if (userParameters.alignmentMemoSize < 0)
+    {
+        const string message = "Alignment memo size cannot be negative";
+        throw std::invalid_argument(message);
+    }
+
+    if (userParameters.prefetchLoci < 0)
+    {
+        const string message = "Number of prefetched loci cannot be negative";
+        throw std::invalid_argument(message);
+    }
 }
 
-SampleParameters decodeSampleParameters(const UserParameters& userParams)
+SampleParameters makeSampleParameters(const string& htsFilePath, const string& sexEncoding)
 {
-    fs::path boostHtsFilePath(userParams.htsFilePath);
+    fs::path boostHtsFilePath(htsFilePath);
     auto sampleId = boostHtsFilePath.stem().string();
-    Sex sex = decodeSampleSex(userParams.sampleSexEncoding);
+    // Inferred sex is determined by the sample QC before the analysis starts
+    Sex sex = sexEncoding == kInferredSexEncoding ? Sex::kFemale : decodeSampleSex(sexEncoding);
     return SampleParameters(sampleId, sex);
 }
 
+OutputPaths makeOutputPaths(const string& outputPrefix)
+{
+    const string vcfPath = outputPrefix + ".vcf";
+    const string jsonPath = outputPrefix + ".json";
+    const string bamletPath = outputPrefix + "_realigned.bam";
+    const string alignmentCacheOutputPath = outputPrefix + ".alignment_cache";
+    const string evidencePath = outputPrefix + "_evidence.bam";
+    return OutputPaths(vcfPath, jsonPath, bamletPath, alignmentCacheOutputPath, evidencePath);
+}
+
 AnalysisMode decodeAnalysisMode(const string& encoding)
 {
     if (encoding == "streaming")
@@ -258,6 +412,10 @@ AnalysisMode decodeAnalysisMode(const string& encoding)
     {
         return AnalysisMode::kSeeking;
     }
+    else if (encoding == "extract")
+    {
+        return AnalysisMode::kExtract;
+    }
     else
     {
         throw std::logic_error("Invalid encoding of data input mode '" + encoding + "'");
@@ -308,6 +466,17 @@ static graphtools::AlignerType decodeAlignerType(const string& alignerType)
     }
 }
 
+static vector<string> splitList(const string& encoding)
+{
+    vector<string> items;
+    if (!encoding.empty())
+    {
+        boost::split(items, encoding, boost::is_any_of(","));
+        items.erase(std::remove(items.begin(), items.end(), string()), items.end());
+    }
+    return items;
+}
+
 boost::optional<ProgramParameters> tryLoadingProgramParameters(int argc, char** argv)
 {
     auto optionalUserParameters = tryParsingUserParameters(argc, argv);
@@ -319,15 +488,23 @@ boost::optional<ProgramParameters> tryLoadingProgramParameters(int argc, char**
     const auto& userParams = *optionalUserParameters;
     assertValidity(userParams);
 
-    InputPaths inputPaths(userParams.htsFilePath, userParams.referencePath, userParams.catalogPath);
-    const string vcfPath = userParams.outputPrefix + ".vcf";
-    const string jsonPath = userParams.outputPrefix + ".json";
-    const string bamletPath = userParams.outputPrefix + "_realigned.bam";
-    OutputPaths outputPaths(vcfPath, jsonPath, bamletPath);
-    SampleParameters sampleParameters = decodeSampleParameters(userParams);
+    boost::optional<string> alignmentCachePath;
+    if (!userParams.alignmentCachePath.empty())
+    {
+        alignmentCachePath = userParams.alignmentCachePath;
+    }
+    InputPaths inputPaths(userParams.htsFilePath, userParams.referencePath, userParams.catalogPath, alignmentCachePath);
+    OutputPaths outputPaths = makeOutputPaths(userParams.outputPrefix);
+    // Reads from the standard input have no file name to derive the sample id from, so the output prefix is used
+    const string& sampleIdSource
+        = userParams.htsFilePath == kStandardInputPath ? userParams.outputPrefix : userParams.htsFilePath;
+    SampleParameters sampleParameters = makeSampleParameters(sampleIdSource, userParams.sampleSexEncoding);
     HeuristicParameters heuristicParameters(
         userParams.regionExtensionLength, userParams.minLocusCoverage, userParams.qualityCutoffForGoodBaseCall,
         userParams.skipUnaligned, decodeAlignerType(userParams.alignerType));
+    heuristicParameters.setTrimLowQualityEnds(userParams.trimLowQualityEnds);
+    heuristicParameters.setAlignmentMemoSize(userParams.alignmentMemoSize);
+    heuristicParameters.setAlignInRepeatReadsDirectly(userParams.alignInRepeatReadsDirectly);
 
     LogLevel logLevel;
     try
@@ -347,13 +524,21 @@ boost::optional<ProgramParameters> tryLoadingProgramParameters(int argc, char**
     }
     catch (std::logic_error&)
     {
-        const string message = "Analysis mode must be set to either streaming or seeking";
+        const string message = "Analysis mode must be set to either streaming, seeking or extract";
         throw std::invalid_argument(message);
     }
 
-    return ProgramParameters(
+    ProgramParameters programParameters(
         inputPaths, outputPaths, sampleParameters, heuristicParameters, analysisMode, logLevel, userParams.threadCount,
-        userParams.disableBamletOutput);
+        userParams.disableBamletOutput, userParams.writeAlignmentCache, userParams.resume, userParams.server,
+        LocusSelection(splitList(userParams.locusIdEncoding), splitList(userParams.regionEncoding)));
+    programParameters.alignmentValidation = decodeValidationLevel(userParams.alignmentValidation);
+    programParameters.depthSource = userParams.depthSource == "index" ? DepthSource::kIndex : DepthSource::kLocus;
+    programParameters.inferSampleSex = userParams.sampleSexEncoding == kInferredSexEncoding;
+    programParameters.pinThreads = userParams.pinThreads;
+    programParameters.prefetchLoci = userParams.prefetchLoci;
+
+    return programParameters;
 }
 
 }
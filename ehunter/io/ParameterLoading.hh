@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <string>
+
 #include <boost/optional.hpp>
 
 #include "core/Parameters.hh"
@@ -30,4 +32,10 @@ namespace ehunter
 
 boost::optional<ProgramParameters> tryLoadingProgramParameters(int argc, char** argv);
 
+/// Paths of all output files sharing the given prefix
+OutputPaths makeOutputPaths(const std::string& outputPrefix);
+
+/// Parameters of the sample stored in the given alignment file; the sample id is the file name without extension
+SampleParameters makeSampleParameters(const std::string& htsFilePath, const std::string& sexEncoding);
+
 }
@@ -22,7 +22,11 @@
 
 #include "io/SampleStats.hh"
 
+#include <algorithm>
+#include <cctype>
 #include <cstdint>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
@@ -40,13 +44,17 @@ using std::vector;
 namespace ehunter
 {
 
-int extractReadLength(const string& htsFilePath)
+int extractReadLength(const string& htsFilePath, const string& referencePath)
 {
     samFile* htsFilePtr = sam_open(htsFilePath.c_str(), "r");
     if (!htsFilePtr)
     {
         throw std::runtime_error("Failed to read " + htsFilePath);
     }
+    if (!referencePath.empty() && hts_set_fai_filename(htsFilePtr, referencePath.c_str()) != 0)
+    {
+        throw std::runtime_error("Failed to set index of: " + referencePath);
+    }
     bam_hdr_t* htsHeaderPtr = sam_hdr_read(htsFilePtr);
     if (!htsHeaderPtr)
     {
@@ -104,4 +112,251 @@ ReferenceContigInfo extractReferenceContigInfo(const std::string& htsFilePath)
     return htshelpers::decodeContigInfo(htsHeaderPtr.get());
 }
 
+static const int kWindowLength = 2000;
+static const int kAutosomeWindowCount = 64;
+static const int kSexChromosomeWindowCount = 16;
+static const int kMinMapqForDepth = 20;
+static const double kMaxMaleXDepthRatio = 0.75;
+
+static ChromType determineChromosomeType(const string& contigName)
+{
+    if (contigName == "chrX" || contigName == "X")
+    {
+        return ChromType::kX;
+    }
+    if (contigName == "chrY" || contigName == "Y")
+    {
+        return ChromType::kY;
+    }
+    return ChromType::kAutosome;
+}
+
+// Only the primary assembly is sampled; alternate, unplaced, and decoy contigs are skipped
+static bool isPrimaryAssemblyContig(const string& contigName)
+{
+    const string name = contigName.compare(0, 3, "chr") == 0 ? contigName.substr(3) : contigName;
+    if (name == "X" || name == "Y")
+    {
+        return true;
+    }
+    if (name.empty() || name.size() > 2 || !std::all_of(name.begin(), name.end(), ::isdigit))
+    {
+        return false;
+    }
+    const int chromosomeNumber = std::stoi(name);
+    return 1 <= chromosomeNumber && chromosomeNumber <= 22;
+}
+
+static int calculateMedian(vector<int> values)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+void SampleQcAccumulator::addWindow(ChromType chromType, int readCount)
+{
+    switch (chromType)
+    {
+    case ChromType::kAutosome:
+        autosomeWindowReadCounts_.push_back(readCount);
+        break;
+    case ChromType::kX:
+        xWindowReadCounts_.push_back(readCount);
+        break;
+    case ChromType::kY:
+        yWindowReadCounts_.push_back(readCount);
+        break;
+    }
+}
+
+SampleQcSummary SampleQcAccumulator::summarize() const
+{
+    // Windows without reads typically fall into assembly gaps, so they are excluded from the autosome and X depths
+    auto collectCoveredWindows = [](const vector<int>& readCounts)
+    {
+        vector<int> coveredWindows;
+        std::copy_if(
+            readCounts.begin(), readCounts.end(), std::back_inserter(coveredWindows),
+            [](int readCount) { return readCount > 0; });
+        return coveredWindows;
+    };
+
+    const vector<int> coveredAutosomeWindows = collectCoveredWindows(autosomeWindowReadCounts_);
+    if (readLengths_.empty() || coveredAutosomeWindows.empty())
+    {
+        throw std::runtime_error("Sample QC found no reads on the autosomes");
+    }
+    const double autosomeReadCount = calculateMedian(coveredAutosomeWindows);
+
+    SampleQcSummary summary;
+    summary.sampledReadCount = readLengths_.size();
+    summary.minReadLength = *std::min_element(readLengths_.begin(), readLengths_.end());
+    summary.medianReadLength = calculateMedian(readLengths_);
+    summary.maxReadLength = *std::max_element(readLengths_.begin(), readLengths_.end());
+    summary.medianFragmentLength = calculateMedian(fragmentLengths_);
+
+    const vector<int> coveredXWindows = collectCoveredWindows(xWindowReadCounts_);
+    if (!coveredXWindows.empty())
+    {
+        summary.xDepthRatio = calculateMedian(coveredXWindows) / autosomeReadCount;
+    }
+
+    // Most of chromosome Y is either unassembled or mapped to by female reads with low quality, so its depth is only
+    // reported as the mean over all windows
+    if (!yWindowReadCounts_.empty())
+    {
+        double totalReadCount = 0;
+        for (const int readCount : yWindowReadCounts_)
+        {
+            totalReadCount += readCount;
+        }
+        summary.yDepthRatio = totalReadCount / yWindowReadCounts_.size() / autosomeReadCount;
+    }
+
+    if (summary.xDepthRatio)
+    {
+        summary.inferredSex = *summary.xDepthRatio < kMaxMaleXDepthRatio ? Sex::kMale : Sex::kFemale;
+    }
+
+    return summary;
+}
+
+// Start positions of windows spread evenly across the given contigs as if they were concatenated
+static vector<pair<int32_t, int64_t>>
+placeWindows(const ReferenceContigInfo& contigInfo, const vector<int32_t>& contigIndexes, int windowCount)
+{
+    int64_t totalLength = 0;
+    for (const int32_t contigIndex : contigIndexes)
+    {
+        totalLength += contigInfo.getContigSize(contigIndex);
+    }
+
+    vector<pair<int32_t, int64_t>> windowStarts;
+    if (totalLength == 0)
+    {
+        return windowStarts;
+    }
+
+    const int64_t windowSpacing = totalLength / windowCount;
+    int64_t offset = windowSpacing / 2;
+    int64_t contigStart = 0;
+    for (const int32_t contigIndex : contigIndexes)
+    {
+        const int64_t contigLength = contigInfo.getContigSize(contigIndex);
+        while (offset < contigStart + contigLength && static_cast<int>(windowStarts.size()) < windowCount)
+        {
+            const int64_t lastWindowStart = std::max<int64_t>(contigLength - kWindowLength, 0);
+            windowStarts.emplace_back(contigIndex, std::min(offset - contigStart, lastWindowStart));
+            offset += windowSpacing;
+        }
+        contigStart += contigLength;
+    }
+
+    return windowStarts;
+}
+
+SampleQcSummary runSampleQc(const string& htsFilePath, const string& referencePath)
+{
+    std::unique_ptr<samFile, decltype(&hts_close)> htsFilePtr(sam_open(htsFilePath.c_str(), "r"), hts_close);
+    if (!htsFilePtr)
+    {
+        throw std::runtime_error("Failed to read " + htsFilePath);
+    }
+    if (!referencePath.empty() && hts_set_fai_filename(htsFilePtr.get(), referencePath.c_str()) != 0)
+    {
+        throw std::runtime_error("Failed to set index of: " + referencePath);
+    }
+
+    std::unique_ptr<bam_hdr_t, decltype(&bam_hdr_destroy)> htsHeaderPtr(
+        sam_hdr_read(htsFilePtr.get()), bam_hdr_destroy);
+    if (!htsHeaderPtr)
+    {
+        throw std::runtime_error("Failed to read the header of " + htsFilePath);
+    }
+
+    std::unique_ptr<hts_idx_t, decltype(&hts_idx_destroy)> htsIndexPtr(
+        sam_index_load(htsFilePtr.get(), htsFilePath.c_str()), hts_idx_destroy);
+    if (!htsIndexPtr)
+    {
+        throw std::runtime_error("Failed to load index of " + htsFilePath);
+    }
+
+    const ReferenceContigInfo contigInfo = htshelpers::decodeContigInfo(htsHeaderPtr.get());
+    vector<int32_t> autosomeIndexes;
+    vector<int32_t> xIndexes;
+    vector<int32_t> yIndexes;
+    for (int32_t contigIndex = 0; contigIndex != contigInfo.numContigs(); ++contigIndex)
+    {
+        const string& contigName = contigInfo.getContigName(contigIndex);
+        if (!isPrimaryAssemblyContig(contigName))
+        {
+            continue;
+        }
+        switch (determineChromosomeType(contigName))
+        {
+        case ChromType::kAutosome:
+            autosomeIndexes.push_back(contigIndex);
+            break;
+        case ChromType::kX:
+            xIndexes.push_back(contigIndex);
+            break;
+        case ChromType::kY:
+            yIndexes.push_back(contigIndex);
+            break;
+        }
+    }
+
+    SampleQcAccumulator accumulator;
+    std::unique_ptr<bam1_t, decltype(&bam_destroy1)> htsAlignmentPtr(bam_init1(), bam_destroy1);
+
+    auto sampleWindows = [&](ChromType chromType, const vector<int32_t>& contigIndexes, int windowCount)
+    {
+        for (const auto& windowStart : placeWindows(contigInfo, contigIndexes, windowCount))
+        {
+            const int64_t windowEnd = windowStart.second + kWindowLength;
+            std::unique_ptr<hts_itr_t, decltype(&hts_itr_destroy)> htsRegionPtr(
+                sam_itr_queryi(htsIndexPtr.get(), windowStart.first, windowStart.second, windowEnd),
+                hts_itr_destroy);
+            if (!htsRegionPtr)
+            {
+                throw std::runtime_error("Failed to sample reads from " + htsFilePath);
+            }
+
+            int readCount = 0;
+            while (sam_itr_next(htsFilePtr.get(), htsRegionPtr.get(), htsAlignmentPtr.get()) >= 0)
+            {
+                const bam1_core_t& core = htsAlignmentPtr->core;
+                const bool isSkipped = !htshelpers::isPrimaryAlignment(htsAlignmentPtr.get())
+                    || (core.flag & (BAM_FUNMAP | BAM_FDUP | BAM_FQCFAIL)) || core.pos < windowStart.second;
+                if (isSkipped)
+                {
+                    continue;
+                }
+
+                accumulator.addRead(core.l_qseq);
+                if ((core.flag & BAM_FPROPER_PAIR) && core.isize > 0)
+                {
+                    accumulator.addFragment(core.isize);
+                }
+                if (core.qual >= kMinMapqForDepth)
+                {
+                    ++readCount;
+                }
+            }
+            accumulator.addWindow(chromType, readCount);
+        }
+    };
+
+    sampleWindows(ChromType::kAutosome, autosomeIndexes, kAutosomeWindowCount);
+    sampleWindows(ChromType::kX, xIndexes, kSexChromosomeWindowCount);
+    sampleWindows(ChromType::kY, yIndexes, kSexChromosomeWindowCount);
+
+    return accumulator.summarize();
+}
+
 }
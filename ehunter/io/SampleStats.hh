@@ -23,15 +23,60 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
+#include <boost/optional.hpp>
+
+#include "core/Common.hh"
 #include "core/ReferenceContigInfo.hh"
 
 namespace ehunter
 {
 
-// Returns the length of the first read in a HTS file
-int extractReadLength(const std::string& htsFilePath);
+// Returns the length of the first read in a HTS file; the reference is needed to decode CRAM files
+int extractReadLength(const std::string& htsFilePath, const std::string& referencePath = "");
 
 ReferenceContigInfo extractReferenceContigInfo(const std::string& htsFilePath);
 
+// Summary of the reads sampled from an alignment file by the sample QC pre-pass
+struct SampleQcSummary
+{
+    int sampledReadCount = 0;
+    int minReadLength = 0;
+    int medianReadLength = 0;
+    int maxReadLength = 0;
+    // Median fragment length of properly paired reads; zero if no such reads were sampled
+    int medianFragmentLength = 0;
+    // Depth of chromosomes X and Y relative to the autosomes; unset if the reference lacks the chromosome or, for
+    // chromosome X, if none of its sampled windows is covered by reads
+    boost::optional<double> xDepthRatio;
+    boost::optional<double> yDepthRatio;
+    // Unset if the depth of chromosome X could not be determined
+    boost::optional<Sex> inferredSex;
+};
+
+// Collects read, fragment, and depth statistics of windows sampled across the genome
+class SampleQcAccumulator
+{
+public:
+    void addRead(int readLength) { readLengths_.push_back(readLength); }
+    void addFragment(int fragmentLength) { fragmentLengths_.push_back(fragmentLength); }
+    // Number of confidently mapped reads starting in a sampled window of the given chromosome type
+    void addWindow(ChromType chromType, int readCount);
+
+    // Samples are inferred to be male if chromosome X has less than 3/4 of the autosomal depth
+    SampleQcSummary summarize() const;
+
+private:
+    std::vector<int> readLengths_;
+    std::vector<int> fragmentLengths_;
+    std::vector<int> autosomeWindowReadCounts_;
+    std::vector<int> xWindowReadCounts_;
+    std::vector<int> yWindowReadCounts_;
+};
+
+// Run the sample QC pre-pass by reading small windows spread evenly across the autosomes and sex chromosomes; the
+// alignment file must be indexed
+SampleQcSummary runSampleQc(const std::string& htsFilePath, const std::string& referencePath);
+
 }
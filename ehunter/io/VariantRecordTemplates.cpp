@@ -0,0 +1,191 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "io/VariantRecordTemplates.hh"
+
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/algorithm/string/join.hpp>
+
+#include "core/Common.hh"
+
+using std::string;
+using std::to_string;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace
+{
+
+string computeRepeatInfoColumn(const VariantSpecification& variantSpec, const string& repeatUnit)
+{
+    const auto& referenceLocus = variantSpec.referenceLocus();
+    const int referenceSizeInBp = referenceLocus.length();
+    const int referenceSizeInUnits = referenceSizeInBp / repeatUnit.length();
+
+    vector<string> fields;
+    fields.push_back("END=" + to_string(referenceLocus.end()));
+    fields.push_back("REF=" + to_string(referenceSizeInUnits));
+    fields.push_back("RL=" + to_string(referenceSizeInBp));
+    fields.push_back("RU=" + repeatUnit);
+    fields.push_back("VARID=" + variantSpec.id());
+    fields.push_back("REPID=" + variantSpec.id());
+
+    return boost::algorithm::join(fields, ";");
+}
+
+VariantRecordTemplate makeRepeatTemplate(
+    const Reference& reference, const LocusSpecification& locusSpec, const VariantSpecification& variantSpec)
+{
+    const auto& referenceLocus = variantSpec.referenceLocus();
+    const auto repeatNodeId = variantSpec.nodes().front();
+    const string& repeatUnit = locusSpec.regionGraph().nodeSeq(repeatNodeId);
+
+    const int posPreceedingRepeat1based = referenceLocus.start();
+    const auto& contigName = reference.contigInfo().getContigName(referenceLocus.contigIndex());
+    const string leftFlankingBase
+        = reference.getSequence(contigName, referenceLocus.start() - 1, referenceLocus.start());
+
+    VariantRecordTemplate recordTemplate;
+    recordTemplate.vcfLeadingColumns
+        = contigName + "\t" + to_string(posPreceedingRepeat1based) + "\t.\t" + leftFlankingBase;
+    recordTemplate.vcfInfoColumn = computeRepeatInfoColumn(variantSpec, repeatUnit);
+    recordTemplate.referenceSizeInUnits = referenceLocus.length() / repeatUnit.length();
+
+    nlohmann::json& record = recordTemplate.jsonRecord;
+    record["VariantId"] = variantSpec.id();
+    record["ReferenceRegion"] = encode(reference.contigInfo(), referenceLocus);
+    record["VariantType"] = streamToString(variantSpec.classification().type);
+    record["VariantSubtype"] = streamToString(variantSpec.classification().subtype);
+    record["RepeatUnit"] = repeatUnit;
+
+    return recordTemplate;
+}
+
+VariantRecordTemplate makeSmallVariantTemplate(
+    const Reference& reference, const LocusSpecification& locusSpec, const VariantSpecification& variantSpec)
+{
+    const auto& referenceLocus = variantSpec.referenceLocus();
+    const auto& contigName = reference.contigInfo().getContigName(referenceLocus.contigIndex());
+    string refSequence;
+    string altSequence;
+    int64_t startPosition = -1;
+
+    if ((variantSpec.classification().subtype == VariantSubtype::kSwap)
+        || (variantSpec.classification().subtype == VariantSubtype::kSMN))
+    {
+        assert(variantSpec.optionalRefNode());
+        const auto refNode = *variantSpec.optionalRefNode();
+        const int refNodeIndex = refNode == variantSpec.nodes().front() ? 0 : 1;
+        const int altNodeIndex = refNode == variantSpec.nodes().front() ? 1 : 0;
+
+        const auto refNodeId = variantSpec.nodes()[refNodeIndex];
+        const auto altNodeId = variantSpec.nodes()[altNodeIndex];
+
+        refSequence = locusSpec.regionGraph().nodeSeq(refNodeId);
+        altSequence = locusSpec.regionGraph().nodeSeq(altNodeId);
+        // Conversion from 0-based to 1-based coordinates
+        startPosition = referenceLocus.start() + 1;
+    }
+    else if (variantSpec.classification().subtype == VariantSubtype::kDeletion)
+    {
+        const string refFlankingBase
+            = reference.getSequence(contigName, referenceLocus.start() - 1, referenceLocus.start());
+
+        const int refNodeId = variantSpec.nodes().front();
+        refSequence = refFlankingBase + locusSpec.regionGraph().nodeSeq(refNodeId);
+        altSequence = refFlankingBase;
+        // Conversion from 0-based to 1-based coordinates
+        startPosition = referenceLocus.start();
+    }
+    else if (variantSpec.classification().subtype == VariantSubtype::kInsertion)
+    {
+        const string refFlankingBase
+            = reference.getSequence(contigName, referenceLocus.start() - 1, referenceLocus.start());
+
+        const int altNodeId = variantSpec.nodes().front();
+        refSequence = refFlankingBase;
+        altSequence = refFlankingBase + locusSpec.regionGraph().nodeSeq(altNodeId);
+        // Conversion from 0-based to 1-based coordinates
+        startPosition = referenceLocus.start();
+    }
+    else
+    {
+        std::ostringstream encoding;
+        encoding << variantSpec.classification().type << "/" << variantSpec.classification().subtype;
+        throw std::logic_error("Unable to generate VCF record for " + encoding.str());
+    }
+
+    VariantRecordTemplate recordTemplate;
+    recordTemplate.vcfLeadingColumns = contigName + "\t" + to_string(startPosition) + "\t.\t" + refSequence;
+    recordTemplate.vcfAltColumn = altSequence;
+    recordTemplate.vcfInfoColumn = "VARID=" + variantSpec.id();
+
+    nlohmann::json& record = recordTemplate.jsonRecord;
+    record["VariantId"] = variantSpec.id();
+    record["VariantType"] = streamToString(variantSpec.classification().type);
+    record["VariantSubtype"] = streamToString(variantSpec.classification().subtype);
+    record["ReferenceRegion"] = encode(reference.contigInfo(), referenceLocus);
+
+    return recordTemplate;
+}
+
+}
+
+VariantRecordTemplates::VariantRecordTemplates(const Reference& reference, const RegionCatalog& regionCatalog)
+{
+    for (const LocusSpecification& locusSpec : regionCatalog)
+    {
+        VariantIdToTemplate& locusTemplates = locusIdToTemplates_[locusSpec.locusId()];
+        for (const VariantSpecification& variantSpec : locusSpec.variantSpecs())
+        {
+            if (variantSpec.classification().type == VariantType::kRepeat)
+            {
+                locusTemplates[variantSpec.id()] = makeRepeatTemplate(reference, locusSpec, variantSpec);
+            }
+            else
+            {
+                locusTemplates[variantSpec.id()] = makeSmallVariantTemplate(reference, locusSpec, variantSpec);
+            }
+        }
+    }
+}
+
+const VariantRecordTemplate& VariantRecordTemplates::get(const string& locusId, const string& variantId) const
+{
+    const auto locusIterator = locusIdToTemplates_.find(locusId);
+    if (locusIterator != locusIdToTemplates_.end())
+    {
+        const auto variantIterator = locusIterator->second.find(variantId);
+        if (variantIterator != locusIterator->second.end())
+        {
+            return variantIterator->second;
+        }
+    }
+
+    throw std::logic_error("No output record template for variant " + variantId + " of locus " + locusId);
+}
+
+}
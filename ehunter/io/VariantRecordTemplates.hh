@@ -0,0 +1,74 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/Reference.hh"
+#include "locus/LocusSpecification.hh"
+
+#include "thirdparty/json/json.hpp"
+
+namespace ehunter
+{
+
+/// \brief Parts of the output records of a variant that do not depend on the sample
+///
+/// Sample-specific fields (genotypes, read counts, filters, and depths) are added to the template at output time
+///
+struct VariantRecordTemplate
+{
+    /// CHROM, POS, ID, and REF columns of the VCF record joined by tabs
+    std::string vcfLeadingColumns;
+
+    /// ALT column of a small variant; ALT columns of repeats depend on the genotype
+    std::string vcfAltColumn;
+
+    /// INFO column of the VCF record
+    std::string vcfInfoColumn;
+
+    /// Size of the reference allele of a repeat in repeat units
+    int referenceSizeInUnits = 0;
+
+    /// JSON variant record containing the variant id, type, reference region and (for repeats) the repeat unit
+    nlohmann::json jsonRecord;
+};
+
+/// \brief Output record templates of all variants of a catalog
+///
+/// The templates are rendered once per catalog, so a catalog analyzed repeatedly (for example, by the analysis server)
+/// does not query the reference or re-encode locus definitions for every sample
+///
+class VariantRecordTemplates
+{
+public:
+    VariantRecordTemplates(const Reference& reference, const RegionCatalog& regionCatalog);
+
+    /// Template of the given variant; throws if the variant is absent from the catalog used to build the templates
+    const VariantRecordTemplate& get(const std::string& locusId, const std::string& variantId) const;
+
+private:
+    using VariantIdToTemplate = std::unordered_map<std::string, VariantRecordTemplate>;
+    std::unordered_map<std::string, VariantIdToTemplate> locusIdToTemplates_;
+};
+
+}
@@ -78,10 +78,10 @@ std::ostream& operator<<(std::ostream& out, VcfWriter& vcfWriter)
 }
 
 VcfWriter::VcfWriter(
-    std::string sampleId, Reference& reference, const RegionCatalog& regionCatalog,
+    std::string sampleId, const VariantRecordTemplates& recordTemplates, const RegionCatalog& regionCatalog,
     const SampleFindings& sampleFindings)
     : sampleId_(std::move(sampleId))
-    , reference_(reference)
+    , recordTemplates_(recordTemplates)
     , regionCatalog_(regionCatalog)
     , sampleFindings_(sampleFindings)
 {
@@ -102,7 +102,8 @@ void VcfWriter::writeBody(ostream& out)
         const auto& variantFindings = locusFindings.findingsForEachVariant.at(variantId);
 
         const double locusDepth = locusFindings.stats.depth();
-        VariantVcfWriter variantWriter(reference_, locusSpec, locusDepth, variantSpec, out);
+        const VariantRecordTemplate& recordTemplate = recordTemplates_.get(locusSpec.locusId(), variantId);
+        VariantVcfWriter variantWriter(recordTemplate, locusDepth, variantSpec, out);
         variantFindings->accept(&variantWriter);
     }
 }
@@ -169,23 +170,6 @@ static string computeAltSymbol(const optional<RepeatGenotype>& optionalGenotype,
     return boost::algorithm::join(alleleEncodings, ",");
 }
 
-static string computeInfoFields(const VariantSpecification& variantSpec, const string& repeatUnit)
-{
-    const auto& referenceLocus = variantSpec.referenceLocus();
-    const int referenceSizeInBp = referenceLocus.length();
-    const int referenceSizeInUnits = referenceSizeInBp / repeatUnit.length();
-
-    vector<string> fields;
-    fields.push_back("END=" + std::to_string(referenceLocus.end()));
-    fields.push_back("REF=" + std::to_string(referenceSizeInUnits));
-    fields.push_back("RL=" + std::to_string(referenceSizeInBp));
-    fields.push_back("RU=" + repeatUnit);
-    fields.push_back("VARID=" + variantSpec.id());
-    fields.push_back("REPID=" + variantSpec.id());
-
-    return boost::algorithm::join(fields, ";");
-}
-
 static ReadType determineSupportType(const CountTable& spanningCounts, const CountTable& flankingCounts, int repeatSize)
 {
     if (spanningCounts.countOf(repeatSize) != 0)
@@ -200,8 +184,7 @@ static ReadType determineSupportType(const CountTable& spanningCounts, const Cou
     return ReadType::kRepeat;
 }
 
-static string computeAlleleFields(
-    const VariantSpecification& variantSpec, const string& repeatUnit, const RepeatFindings& repeatFindings)
+static string computeAlleleFields(int referenceSizeInUnits, const RepeatFindings& repeatFindings)
 {
     if (!repeatFindings.optionalGenotype())
     {
@@ -217,9 +200,6 @@ static string computeAlleleFields(
     }
 
     const RepeatGenotype& genotype = *repeatFindings.optionalGenotype();
-    const auto referenceLocus = variantSpec.referenceLocus();
-    const int referenceSizeInBp = referenceLocus.length();
-    const int referenceSizeInUnits = referenceSizeInBp / repeatUnit.length();
 
     ReadSupportCalculator readSupportCalculator(
         repeatFindings.countsOfSpanningReads(), repeatFindings.countsOfFlankingReads(),
@@ -255,31 +235,18 @@ static string computeAlleleFields(
 
 void VariantVcfWriter::visit(const RepeatFindings* repeatFindingsPtr)
 {
-    const auto& referenceLocus = variantSpec_.referenceLocus();
-    const auto repeatNodeId = variantSpec_.nodes().front();
-    const string& repeatUnit = locusSpec_.regionGraph().nodeSeq(repeatNodeId);
-    const int referenceSizeInUnits = referenceLocus.length() / repeatUnit.length();
-    const string infoFields = computeInfoFields(variantSpec_, repeatUnit);
-
-    const int posPreceedingRepeat1based = referenceLocus.start();
-    const auto& contigName = reference_.contigInfo().getContigName(referenceLocus.contigIndex());
-    const string leftFlankingBase
-        = reference_.getSequence(contigName, referenceLocus.start() - 1, referenceLocus.start());
-
+    const int referenceSizeInUnits = recordTemplate_.referenceSizeInUnits;
     const string altSymbol = computeAltSymbol(repeatFindingsPtr->optionalGenotype(), referenceSizeInUnits);
-    const string alleleFields = computeAlleleFields(variantSpec_, repeatUnit, *repeatFindingsPtr);
+    const string alleleFields = computeAlleleFields(referenceSizeInUnits, *repeatFindingsPtr);
     const string sampleFields = alleleFields + ":" + std::to_string(locusDepth_);
 
     string genotypeFilter = computeFilterSymbol(repeatFindingsPtr->genotypeFilter());
 
-    vector<string> vcfRecordElements = { contigName,
-                                         to_string(posPreceedingRepeat1based),
-                                         ".",
-                                         leftFlankingBase,
+    vector<string> vcfRecordElements = { recordTemplate_.vcfLeadingColumns,
                                          altSymbol,
                                          ".",
                                          genotypeFilter,
-                                         infoFields,
+                                         recordTemplate_.vcfInfoColumn,
                                          "GT:SO:REPCN:REPCI:ADSP:ADFL:ADIR:LC",
                                          sampleFields };
 
@@ -288,59 +255,6 @@ void VariantVcfWriter::visit(const RepeatFindings* repeatFindingsPtr)
 
 void VariantVcfWriter::visit(const SmallVariantFindings* smallVariantFindingsPtr)
 {
-    const auto& referenceLocus = variantSpec_.referenceLocus();
-    const auto& contigName = reference_.contigInfo().getContigName(referenceLocus.contigIndex());
-    string refSequence;
-    string altSequence;
-    int64_t startPosition = -1;
-
-    if ((variantSpec_.classification().subtype == VariantSubtype::kSwap)
-        || (variantSpec_.classification().subtype == VariantSubtype::kSMN))
-    {
-        assert(variantSpec_.optionalRefNode());
-        const auto refNode = *variantSpec_.optionalRefNode();
-        const int refNodeIndex = refNode == variantSpec_.nodes().front() ? 0 : 1;
-        const int altNodeIndex = refNode == variantSpec_.nodes().front() ? 1 : 0;
-
-        const auto refNodeId = variantSpec_.nodes()[refNodeIndex];
-        const auto altNodeId = variantSpec_.nodes()[altNodeIndex];
-
-        refSequence = locusSpec_.regionGraph().nodeSeq(refNodeId);
-        altSequence = locusSpec_.regionGraph().nodeSeq(altNodeId);
-        // Conversion from 0-based to 1-based coordinates
-        startPosition = referenceLocus.start() + 1;
-    }
-    else if (variantSpec_.classification().subtype == VariantSubtype::kDeletion)
-    {
-        const string refFlankingBase
-            = reference_.getSequence(contigName, referenceLocus.start() - 1, referenceLocus.start());
-
-        const int refNodeId = variantSpec_.nodes().front();
-        refSequence = refFlankingBase + locusSpec_.regionGraph().nodeSeq(refNodeId);
-        altSequence = refFlankingBase;
-        // Conversion from 0-based to 1-based coordinates
-        startPosition = referenceLocus.start();
-    }
-    else if (variantSpec_.classification().subtype == VariantSubtype::kInsertion)
-    {
-        const string refFlankingBase
-            = reference_.getSequence(contigName, referenceLocus.start() - 1, referenceLocus.start());
-
-        const int altNodeId = variantSpec_.nodes().front();
-        refSequence = refFlankingBase;
-        altSequence = refFlankingBase + locusSpec_.regionGraph().nodeSeq(altNodeId);
-        // Conversion from 0-based to 1-based coordinates
-        startPosition = referenceLocus.start();
-    }
-    else
-    {
-        std::ostringstream encoding;
-        encoding << variantSpec_.classification().type << "/" << variantSpec_.classification().subtype;
-        throw std::logic_error("Unable to generate VCF record for " + encoding.str());
-    }
-
-    const string infoFields = "VARID=" + variantSpec_.id();
-
     vector<string> sampleFields;
     vector<string> sampleValues;
 
@@ -389,14 +303,11 @@ void VariantVcfWriter::visit(const SmallVariantFindings* smallVariantFindingsPtr
 
     string genotypeFilter = computeFilterSymbol(smallVariantFindingsPtr->genotypeFilter());
 
-    vector<string> line { contigName,
-                          streamToString(startPosition),
-                          ".",
-                          refSequence,
-                          altSequence,
+    vector<string> line { recordTemplate_.vcfLeadingColumns,
+                          recordTemplate_.vcfAltColumn,
                           ".",
                           genotypeFilter,
-                          infoFields,
+                          recordTemplate_.vcfInfoColumn,
                           sampleField,
                           sampleValue };
     out_ << boost::algorithm::join(line, "\t") << std::endl;
@@ -28,7 +28,7 @@
 #include <string>
 
 #include "core/Parameters.hh"
-#include "core/Reference.hh"
+#include "io/VariantRecordTemplates.hh"
 #include "locus/LocusFindings.hh"
 #include "locus/LocusSpecification.hh"
 
@@ -39,10 +39,9 @@ class VariantVcfWriter : public VariantFindingsVisitor
 {
 public:
     VariantVcfWriter(
-        Reference& reference, const LocusSpecification& locusSpec, double locusDepth,
-        const VariantSpecification& variantSpec, std::ostream& out)
-        : reference_(reference)
-        , locusSpec_(locusSpec)
+        const VariantRecordTemplate& recordTemplate, double locusDepth, const VariantSpecification& variantSpec,
+        std::ostream& out)
+        : recordTemplate_(recordTemplate)
         , locusDepth_(locusDepth)
         , variantSpec_(variantSpec)
         , out_(out)
@@ -54,8 +53,7 @@ public:
     void visit(const SmallVariantFindings* smallVariantFindingsPtr) override;
 
 private:
-    Reference& reference_;
-    const LocusSpecification& locusSpec_;
+    const VariantRecordTemplate& recordTemplate_;
     double locusDepth_;
     const VariantSpecification& variantSpec_;
     std::ostream& out_;
@@ -66,7 +64,7 @@ class VcfWriter
 {
 public:
     VcfWriter(
-        std::string sampleId, Reference& reference, const RegionCatalog& regionCatalog,
+        std::string sampleId, const VariantRecordTemplates& recordTemplates, const RegionCatalog& regionCatalog,
         const SampleFindings& sampleFindings);
 
     friend std::ostream& operator<<(std::ostream& out, VcfWriter& vcfWriter);
@@ -78,7 +76,7 @@ private:
     const std::vector<LocusIndexAndVariantId> getSortedIdPairs();
 
     std::string sampleId_;
-    Reference& reference_;
+    const VariantRecordTemplates& recordTemplates_;
     const RegionCatalog& regionCatalog_;
     const SampleFindings& sampleFindings_;
 };
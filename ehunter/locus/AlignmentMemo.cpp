@@ -0,0 +1,98 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "locus/AlignmentMemo.hh"
+
+#include <stdexcept>
+
+using graphtools::GraphAlignment;
+using std::string;
+
+namespace ehunter
+{
+namespace locus
+{
+
+static int64_t estimateMemoryUsage(const string& sequence, const MemoizedAlignment& outcome)
+{
+    // Key and outcome together with the bookkeeping of the hash table node, the recency list node, and the entry
+    int64_t memoryUsage = sizeof(string) + sequence.capacity() + sizeof(MemoizedAlignment) + 6 * sizeof(void*);
+    if (outcome.alignment)
+    {
+        const GraphAlignment& alignment = *outcome.alignment;
+        memoryUsage += alignment.path().numNodes() * sizeof(graphtools::NodeId);
+        for (const auto& nodeAlignment : alignment.alignments())
+        {
+            memoryUsage += sizeof(nodeAlignment)
+                + nodeAlignment.operations().size() * (sizeof(graphtools::Operation) + 2 * sizeof(void*));
+        }
+    }
+    return memoryUsage;
+}
+
+AlignmentMemo::AlignmentMemo(int capacity)
+    : capacity_(capacity)
+{
+    if (capacity_ < 1)
+    {
+        throw std::invalid_argument("Alignment memo must hold at least one sequence");
+    }
+}
+
+const MemoizedAlignment* AlignmentMemo::find(const string& sequence)
+{
+    ++stats_.numLookups;
+    const auto entryIterator = entries_.find(sequence);
+    if (entryIterator == entries_.end())
+    {
+        return nullptr;
+    }
+
+    ++stats_.numHits;
+    Entry& entry = entryIterator->second;
+    recency_.splice(recency_.begin(), recency_, entry.recencyPosition);
+    return &entry.outcome;
+}
+
+void AlignmentMemo::insert(const string& sequence, MemoizedAlignment outcome)
+{
+    if (entries_.find(sequence) != entries_.end())
+    {
+        return;
+    }
+
+    if (static_cast<int>(entries_.size()) == capacity_)
+    {
+        const auto evictedIterator = entries_.find(*recency_.back());
+        memoryUsage_ -= evictedIterator->second.memoryUsage;
+        recency_.pop_back();
+        entries_.erase(evictedIterator);
+        ++stats_.numEvictions;
+    }
+
+    const int64_t entryMemoryUsage = estimateMemoryUsage(sequence, outcome);
+    auto insertion = entries_.emplace(sequence, Entry { std::move(outcome), recency_.end(), entryMemoryUsage });
+    recency_.push_front(&insertion.first->first);
+    insertion.first->second.recencyPosition = recency_.begin();
+    memoryUsage_ += entryMemoryUsage;
+}
+
+}
+}
@@ -0,0 +1,106 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "graphalign/GraphAlignment.hh"
+
+namespace ehunter
+{
+namespace locus
+{
+
+/// Outcome of aligning a read sequence to a locus graph
+struct MemoizedAlignment
+{
+    /// True if the read was reverse-complemented before being aligned
+    bool isReverseComplemented = false;
+
+    /// True if the orientation predictor found that the read does not align to the graph
+    bool isRejectedByOrientationPredictor = false;
+
+    /// Canonical alignment of the read or none if the read was rejected
+    boost::optional<graphtools::GraphAlignment> alignment;
+};
+
+/// \brief Bounded cache of the alignments of read sequences to the graph of one locus
+///
+/// Byte-identical reads, such as PCR and optical duplicates or in-repeat reads of pure expansions, always align the
+/// same way, so the outcome of aligning a sequence can be reused. Once the cache is full, the least recently used
+/// sequence is evicted to make room for a new one.
+///
+class AlignmentMemo
+{
+public:
+    struct Stats
+    {
+        int64_t numLookups = 0;
+        int64_t numHits = 0;
+        int64_t numEvictions = 0;
+    };
+
+    /// \param[in] capacity Maximum number of sequences held in the cache
+    explicit AlignmentMemo(int capacity);
+
+    AlignmentMemo(const AlignmentMemo&) = delete;
+    AlignmentMemo& operator=(const AlignmentMemo&) = delete;
+    AlignmentMemo(AlignmentMemo&&) = default;
+    AlignmentMemo& operator=(AlignmentMemo&&) = default;
+
+    /// Return the cached outcome of aligning the sequence or null if the sequence is absent
+    const MemoizedAlignment* find(const std::string& sequence);
+
+    void insert(const std::string& sequence, MemoizedAlignment outcome);
+
+    int size() const { return static_cast<int>(entries_.size()); }
+    const Stats& stats() const { return stats_; }
+
+    /// Approximate number of bytes used by the cached sequences and alignments
+    int64_t memoryUsage() const { return memoryUsage_; }
+
+private:
+    using RecencyList = std::list<const std::string*>;
+
+    struct Entry
+    {
+        MemoizedAlignment outcome;
+        RecencyList::iterator recencyPosition;
+        int64_t memoryUsage;
+    };
+
+    int capacity_;
+    std::unordered_map<std::string, Entry> entries_;
+
+    // Keys of the entries ordered from the most to the least recently used
+    RecencyList recency_;
+
+    Stats stats_;
+    int64_t memoryUsage_ = 0;
+};
+
+}
+}
@@ -0,0 +1,78 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "locus/AlignmentMemo.hh"
+
+#include "gtest/gtest.h"
+
+#include "graphalign/GraphAlignmentOperations.hh"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using graphtools::decodeGraphAlignment;
+using graphtools::Graph;
+using namespace ehunter;
+using namespace ehunter::locus;
+
+TEST(MemoizingAlignments, InsertedSequences_Found)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATATTA(C)*GGCGGC"));
+    AlignmentMemo memo(10);
+
+    MemoizedAlignment alignedOutcome;
+    alignedOutcome.isReverseComplemented = true;
+    alignedOutcome.alignment = decodeGraphAlignment(2, "0[4M]1[1M]1[1M]", &graph);
+    memo.insert("ATTACC", alignedOutcome);
+    memo.insert("TTTTTT", MemoizedAlignment());
+
+    EXPECT_EQ(nullptr, memo.find("GGCGGC"));
+
+    const MemoizedAlignment* memoizedAlignment = memo.find("ATTACC");
+    ASSERT_NE(nullptr, memoizedAlignment);
+    EXPECT_TRUE(memoizedAlignment->isReverseComplemented);
+    EXPECT_EQ(*alignedOutcome.alignment, *memoizedAlignment->alignment);
+
+    const MemoizedAlignment* memoizedRejection = memo.find("TTTTTT");
+    ASSERT_NE(nullptr, memoizedRejection);
+    EXPECT_FALSE(memoizedRejection->alignment);
+
+    EXPECT_EQ(3, memo.stats().numLookups);
+    EXPECT_EQ(2, memo.stats().numHits);
+    EXPECT_EQ(2, memo.size());
+    EXPECT_GT(memo.memoryUsage(), 0);
+}
+
+TEST(MemoizingAlignments, FullMemo_LeastRecentlyUsedSequenceEvicted)
+{
+    AlignmentMemo memo(2);
+    memo.insert("AAAA", MemoizedAlignment());
+    memo.insert("CCCC", MemoizedAlignment());
+    memo.find("AAAA");
+    memo.insert("GGGG", MemoizedAlignment());
+
+    EXPECT_NE(nullptr, memo.find("AAAA"));
+    EXPECT_EQ(nullptr, memo.find("CCCC"));
+    EXPECT_NE(nullptr, memo.find("GGGG"));
+    EXPECT_EQ(1, memo.stats().numEvictions);
+    EXPECT_EQ(2, memo.size());
+}
+
+TEST(MemoizingAlignments, EmptyMemo_ExceptionThrown) { EXPECT_THROW(AlignmentMemo(0), std::invalid_argument); }
@@ -0,0 +1,333 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "locus/InRepeatReadAligner.hh"
+
+#include <algorithm>
+
+using graphtools::Alignment;
+using graphtools::Graph;
+using graphtools::GraphAlignment;
+using graphtools::NodeId;
+using graphtools::Path;
+using std::string;
+using std::vector;
+
+namespace ehunter
+{
+namespace locus
+{
+
+namespace
+{
+
+bool isPlainDna(const string& sequence)
+{
+    return sequence.find_first_not_of("ACGT") == string::npos;
+}
+
+// Degenerate reference bases are assumed to match any query base, which can only add alternative alignments
+bool isMatch(char queryBase, char referenceBase)
+{
+    return queryBase == referenceBase || !isPlainDna(string(1, referenceBase));
+}
+
+// True if the motif is not a repetition of a shorter sequence such as AT in ATAT
+bool isPrimitive(const string& motif)
+{
+    const int motifLength = motif.length();
+    for (int period = 1; period != motifLength; ++period)
+    {
+        if (motifLength % period == 0 && motif.substr(period) + motif.substr(0, period) == motif)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Length of the longest substring of the sequence that is also a substring of the infinite repetition of the motif
+int computeMaxRun(const string& sequence, const string& motif)
+{
+    const int motifLength = motif.length();
+    int maxRun = 0;
+    for (int phase = 0; phase != motifLength; ++phase)
+    {
+        int run = 0;
+        for (int position = 0; position != static_cast<int>(sequence.length()); ++position)
+        {
+            run = isMatch(motif[(phase + position) % motifLength], sequence[position]) ? run + 1 : 0;
+            maxRun = std::max(maxRun, run);
+        }
+    }
+    return maxRun;
+}
+
+}
+
+InRepeatReadAligner::InRepeatReadAligner(const Graph* graph, int minReadLength)
+    : graph_(graph)
+    , minReadLength_(minReadLength)
+{
+    for (NodeId nodeId = 0; nodeId != graph_->numNodes(); ++nodeId)
+    {
+        // Paths through empty nodes are not handled by the flank checks
+        if (graph_->nodeSeq(nodeId).empty())
+        {
+            return;
+        }
+    }
+
+    for (NodeId nodeId = 0; nodeId != graph_->numNodes(); ++nodeId)
+    {
+        const string& motif = graph_->nodeSeq(nodeId);
+        if (!graph_->hasEdge(nodeId, nodeId) || !isPlainDna(motif) || !isPrimitive(motif))
+        {
+            continue;
+        }
+
+        // A stretch of the motif avoiding the repeat node visits each other node at most once, except for other repeat
+        // nodes, which can only hold a short stretch unless their motif is a rotation of this one
+        bool isEligible = true;
+        int maxRunOutsideNode = 0;
+        for (NodeId otherNodeId = 0; otherNodeId != graph_->numNodes(); ++otherNodeId)
+        {
+            if (otherNodeId == nodeId)
+            {
+                continue;
+            }
+
+            string otherSequence = graph_->nodeSeq(otherNodeId);
+            if (graph_->hasEdge(otherNodeId, otherNodeId))
+            {
+                const int minLength = 2 * (motif.length() + otherSequence.length());
+                const string otherMotif = otherSequence;
+                while (static_cast<int>(otherSequence.length()) < minLength)
+                {
+                    otherSequence += otherMotif;
+                }
+            }
+
+            const int maxRun = computeMaxRun(otherSequence, motif);
+            if (graph_->hasEdge(otherNodeId, otherNodeId) && maxRun == static_cast<int>(otherSequence.length()))
+            {
+                isEligible = false;
+                break;
+            }
+            maxRunOutsideNode += maxRun;
+        }
+
+        if (isEligible)
+        {
+            repeatNodes_.push_back({ nodeId, motif, maxRunOutsideNode });
+        }
+    }
+}
+
+boost::optional<GraphAlignment> InRepeatReadAligner::align(const string& query) const
+{
+    const int queryLength = query.length();
+    if (queryLength < minReadLength_)
+    {
+        return boost::none;
+    }
+
+    for (const auto& repeatNode : repeatNodes_)
+    {
+        if (queryLength <= repeatNode.maxRunOutsideNode)
+        {
+            continue;
+        }
+
+        const int offset = computeTilingOffset(repeatNode, query);
+        if (offset == -1)
+        {
+            continue;
+        }
+
+        // Motifs of eligible repeat nodes are not rotations of each other, so the query tiles at most one of them
+        if (canEnterFromPredecessor(repeatNode, offset, query) || canExitToSuccessor(repeatNode, offset, query))
+        {
+            return boost::none;
+        }
+
+        return makeLoopingAlignment(repeatNode, offset, query);
+    }
+
+    return boost::none;
+}
+
+/// Return the offset in the motif of the first query base if the query tiles the motif at exactly one offset and -1
+/// otherwise
+int InRepeatReadAligner::computeTilingOffset(const RepeatNode& repeatNode, const string& query) const
+{
+    const string& motif = repeatNode.motif;
+    const int motifLength = motif.length();
+    int tilingOffset = -1;
+    for (int offset = 0; offset != motifLength; ++offset)
+    {
+        bool isTiling = true;
+        for (int position = 0; position != static_cast<int>(query.length()); ++position)
+        {
+            if (query[position] != motif[(offset + position) % motifLength])
+            {
+                isTiling = false;
+                break;
+            }
+        }
+
+        if (isTiling)
+        {
+            if (tilingOffset != -1)
+            {
+                return -1;
+            }
+            tilingOffset = offset;
+        }
+    }
+
+    return tilingOffset;
+}
+
+/// True if a query prefix ending where the query tiling crosses a motif boundary matches a path into the repeat node
+bool InRepeatReadAligner::canEnterFromPredecessor(const RepeatNode& repeatNode, int offset, const string& query) const
+{
+    const int motifLength = repeatNode.motif.length();
+    const int firstBoundary = offset == 0 ? motifLength : motifLength - offset;
+    for (int prefixLength = firstBoundary; prefixLength < static_cast<int>(query.length()); prefixLength += motifLength)
+    {
+        for (NodeId predecessorId : graph_->predecessors(repeatNode.nodeId))
+        {
+            if (predecessorId != repeatNode.nodeId && matchesPathEndingAt(predecessorId, query, prefixLength))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/// True if a query suffix starting where the query tiling crosses a motif boundary matches a path out of the repeat
+/// node
+bool InRepeatReadAligner::canExitToSuccessor(const RepeatNode& repeatNode, int offset, const string& query) const
+{
+    const int motifLength = repeatNode.motif.length();
+    const int firstBoundary = offset == 0 ? motifLength : motifLength - offset;
+    for (int suffixStart = firstBoundary; suffixStart < static_cast<int>(query.length()); suffixStart += motifLength)
+    {
+        for (NodeId successorId : graph_->successors(repeatNode.nodeId))
+        {
+            if (successorId != repeatNode.nodeId && matchesPathStartingAt(successorId, query, suffixStart))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/// True if the query bases before queryEnd match a path ending at the end of the given node
+bool InRepeatReadAligner::matchesPathEndingAt(NodeId nodeId, const string& query, int queryEnd) const
+{
+    const string& sequence = graph_->nodeSeq(nodeId);
+    const int sequenceLength = sequence.length();
+    const int overlapLength = std::min(queryEnd, sequenceLength);
+    for (int index = 1; index <= overlapLength; ++index)
+    {
+        if (!isMatch(query[queryEnd - index], sequence[sequenceLength - index]))
+        {
+            return false;
+        }
+    }
+
+    if (queryEnd <= sequenceLength)
+    {
+        return true;
+    }
+
+    for (NodeId predecessorId : graph_->predecessors(nodeId))
+    {
+        if (matchesPathEndingAt(predecessorId, query, queryEnd - sequenceLength))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// True if the query bases from queryStart onwards match a path starting at the start of the given node
+bool InRepeatReadAligner::matchesPathStartingAt(NodeId nodeId, const string& query, int queryStart) const
+{
+    const string& sequence = graph_->nodeSeq(nodeId);
+    const int sequenceLength = sequence.length();
+    const int remainingLength = static_cast<int>(query.length()) - queryStart;
+    const int overlapLength = std::min(remainingLength, sequenceLength);
+    for (int index = 0; index != overlapLength; ++index)
+    {
+        if (!isMatch(query[queryStart + index], sequence[index]))
+        {
+            return false;
+        }
+    }
+
+    if (remainingLength <= sequenceLength)
+    {
+        return true;
+    }
+
+    for (NodeId successorId : graph_->successors(nodeId))
+    {
+        if (matchesPathStartingAt(successorId, query, queryStart + sequenceLength))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+GraphAlignment
+InRepeatReadAligner::makeLoopingAlignment(const RepeatNode& repeatNode, int offset, const string& query) const
+{
+    const int motifLength = repeatNode.motif.length();
+    const int queryLength = query.length();
+
+    vector<NodeId> nodeIds;
+    vector<Alignment> nodeAlignments;
+    int queryPosition = 0;
+    int nodeStart = offset;
+    int nodeEnd = offset;
+    while (queryPosition != queryLength)
+    {
+        const int alignedLength = std::min(motifLength - nodeStart, queryLength - queryPosition);
+        nodeIds.push_back(repeatNode.nodeId);
+        nodeAlignments.emplace_back(static_cast<uint32_t>(nodeStart), std::to_string(alignedLength) + "M");
+        queryPosition += alignedLength;
+        nodeEnd = nodeStart + alignedLength;
+        nodeStart = 0;
+    }
+
+    return GraphAlignment(Path(graph_, offset, nodeIds, nodeEnd), nodeAlignments);
+}
+
+}
+}
@@ -0,0 +1,78 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "graphalign/GraphAlignment.hh"
+#include "graphcore/Graph.hh"
+
+namespace ehunter
+{
+namespace locus
+{
+
+/// \brief Aligns in-repeat reads of a locus without running the graph aligner
+///
+/// A read that exactly tiles the motif of a repeat node aligns to that node by looping it from end to end. When this
+/// looping alignment is provably the only best alignment of the read, it is the alignment the graph aligner would have
+/// found, so it is constructed directly. This is the case when the motif is not a power of a shorter sequence (which
+/// makes the starting offset unique), when the read is longer than any stretch of the motif found elsewhere in the
+/// graph, and when no part of the read also matches the sequence flanking the repeat node.
+///
+/// All other reads, including reads that contain a single mismatch or a low-quality (lowercase) base, are left to the
+/// graph aligner.
+///
+class InRepeatReadAligner
+{
+public:
+    /// \param[in] minReadLength Reads shorter than this are never aligned directly
+    InRepeatReadAligner(const graphtools::Graph* graph, int minReadLength);
+
+    /// Return the only best alignment of a read tiling a repeat motif or none if the read needs the graph aligner
+    boost::optional<graphtools::GraphAlignment> align(const std::string& query) const;
+
+private:
+    struct RepeatNode
+    {
+        graphtools::NodeId nodeId;
+        std::string motif;
+        /// Upper bound on the length of a stretch of the motif that avoids the repeat node
+        int maxRunOutsideNode;
+    };
+
+    int computeTilingOffset(const RepeatNode& repeatNode, const std::string& query) const;
+    bool canEnterFromPredecessor(const RepeatNode& repeatNode, int offset, const std::string& query) const;
+    bool canExitToSuccessor(const RepeatNode& repeatNode, int offset, const std::string& query) const;
+    bool matchesPathEndingAt(graphtools::NodeId nodeId, const std::string& query, int queryEnd) const;
+    bool matchesPathStartingAt(graphtools::NodeId nodeId, const std::string& query, int queryStart) const;
+    graphtools::GraphAlignment
+    makeLoopingAlignment(const RepeatNode& repeatNode, int offset, const std::string& query) const;
+
+    const graphtools::Graph* graph_;
+    int minReadLength_;
+    std::vector<RepeatNode> repeatNodes_;
+};
+
+}
+}
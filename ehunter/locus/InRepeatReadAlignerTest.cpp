@@ -0,0 +1,112 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "locus/InRepeatReadAligner.hh"
+
+#include "gtest/gtest.h"
+
+#include "graphalign/GraphAlignmentOperations.hh"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using namespace ehunter;
+using namespace locus;
+
+using graphtools::decodeGraphAlignment;
+using graphtools::GraphAlignment;
+
+TEST(AligningInRepeatReads, ReadTilingMotif_AlignedToRepeatNode)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("TTGGAT(CAG)*CGTTAC"));
+    InRepeatReadAligner aligner(&graph, 4);
+
+    auto alignment = aligner.align("AGCAGCAGCA");
+
+    ASSERT_TRUE(alignment);
+    EXPECT_EQ(decodeGraphAlignment(1, "1[2M]1[3M]1[3M]1[2M]", &graph), *alignment);
+}
+
+TEST(AligningInRepeatReads, ReadTilingHomopolymer_AlignedToRepeatNode)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATATTA(C)*GGCGGC"));
+    InRepeatReadAligner aligner(&graph, 4);
+
+    auto alignment = aligner.align("CCCCC");
+
+    ASSERT_TRUE(alignment);
+    EXPECT_EQ(decodeGraphAlignment(0, "1[1M]1[1M]1[1M]1[1M]1[1M]", &graph), *alignment);
+}
+
+TEST(AligningInRepeatReads, ReadsWithNonRepeatBases_NotAligned)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("TTGGAT(CAG)*CGTTAC"));
+    InRepeatReadAligner aligner(&graph, 4);
+
+    EXPECT_FALSE(aligner.align("CAGCAGCTGCAG"));
+    EXPECT_FALSE(aligner.align("CAGCAGcAGCAG"));
+    EXPECT_FALSE(aligner.align("CAGCAGNAGCAG"));
+}
+
+TEST(AligningInRepeatReads, ShortRead_NotAligned)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("TTGGAT(CAG)*CGTTAC"));
+    InRepeatReadAligner aligner(&graph, 8);
+
+    EXPECT_FALSE(aligner.align("CAGCAG"));
+    EXPECT_TRUE(aligner.align("CAGCAGCA"));
+}
+
+TEST(AligningInRepeatReads, ReadAlsoMatchingFlank_NotAligned)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("TTGCAG(CAG)*CAGTAC"));
+    InRepeatReadAligner aligner(&graph, 4);
+
+    // The reads could start in the left flank or end in the right flank with equal score
+    EXPECT_FALSE(aligner.align("CAGCAGCAGCAG"));
+    EXPECT_FALSE(aligner.align("GCAGCAGCAGC"));
+}
+
+TEST(AligningInRepeatReads, ReadNotLongerThanMotifStretchInFlank_NotAligned)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("CAGCAGCAGTT(CAG)*ATTTAC"));
+    InRepeatReadAligner aligner(&graph, 4);
+
+    EXPECT_FALSE(aligner.align("AGCAGCAG"));
+    EXPECT_TRUE(aligner.align("AGCAGCAGCAGC"));
+}
+
+TEST(AligningInRepeatReads, RepeatWithPeriodicMotif_NotAligned)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("TTGGAT(ATAT)*CGGCAC"));
+    InRepeatReadAligner aligner(&graph, 4);
+
+    EXPECT_FALSE(aligner.align("ATATATATAT"));
+}
+
+TEST(AligningInRepeatReads, AdjacentRepeats_ReadTilingOneMotifAligned)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("TTGGAT(CAG)*(CCG)*CGTTAC"));
+    InRepeatReadAligner aligner(&graph, 4);
+
+    auto alignment = aligner.align("CCGCCGCCGCCG");
+
+    ASSERT_TRUE(alignment);
+    EXPECT_EQ(decodeGraphAlignment(0, "2[3M]2[3M]2[3M]2[3M]", &graph), *alignment);
+}
@@ -21,6 +21,11 @@
 
 #include "locus/LocusAligner.hh"
 
+#include <atomic>
+
+#include "graphalign/ValidationLevel.hh"
+#include "spdlog/spdlog.h"
+
 #include "alignment/AlignmentFilters.hh"
 #include "alignment/OperationsOnAlignments.hh"
 
@@ -33,25 +38,57 @@ LocusAligner::LocusAligner(
     std::string locusId, GraphPtr graph, const HeuristicParameters& params, AlignmentWriterPtr writer,
     AlignmentBufferPtr buffer)
     : locusId_(std::move(locusId))
-    , aligner_(graph, params.kmerLenForAlignment(), params.paddingLength(), params.seedAffixTrimLength())
+    , aligner_(
+          graph, params.kmerLenForAlignment(), params.paddingLength(), params.seedAffixTrimLength(),
+          params.trimLowQualityEnds())
     , orientationPredictor_(graph, params.orientationPredictorKmerLen(), params.orientationPredictorMinKmerCount())
     , writer_(std::move(writer))
     , alignmentBuffer_(std::move(buffer))
 {
+    if (params.alignInRepeatReadsDirectly())
+    {
+        inRepeatReadAligner_.emplace(graph, params.kmerLenForAlignment());
+    }
+
+    if (params.alignmentMemoSize() > 0)
+    {
+        alignmentMemo_.emplace(params.alignmentMemoSize());
+    }
 }
 
-LocusAligner::AlignedPair LocusAligner::align(Read& read, Read* mate, graphtools::AlignerSelector& alignerSelector)
+LocusAligner::AlignedPair
+LocusAligner::align(Read& read, Read* mate, graphtools::AlignerSelector& alignerSelector, SummaryPair* summaries)
 {
+    if (summaries)
+    {
+        *summaries = SummaryPair();
+    }
+
+    ++stats_.numPairs;
+
     auto readAlign = align(read, alignerSelector);
     auto mateAlign = mate ? align(*mate, alignerSelector) : boost::none;
 
+    // The summaries are shared with the downstream analyzers so that each alignment is only traversed once
+    OptionalSummary readSummary;
+    if (readAlign)
+    {
+        readSummary = AlignmentSummary(*readAlign);
+    }
+    OptionalSummary mateSummary;
+    if (mateAlign)
+    {
+        mateSummary = AlignmentSummary(*mateAlign);
+    }
+
     int numMatchingBases = static_cast<int>(static_cast<double>(read.sequence().length()) / 7.5);
     numMatchingBases = std::max(numMatchingBases, 10);
     LinearAlignmentParameters parameters;
     const int kMinNonRepeatAlignmentScore = numMatchingBases * parameters.matchScore;
 
-    if (!checkIfLocallyPlacedReadPair(readAlign, mateAlign, kMinNonRepeatAlignmentScore))
+    if (!checkIfLocallyPlacedReadPair(readSummary, mateSummary, kMinNonRepeatAlignmentScore))
     {
+        ++stats_.numPairsRejectedByScoreFilter;
         return { boost::none, boost::none };
     }
 
@@ -72,10 +109,49 @@ LocusAligner::AlignedPair LocusAligner::align(Read& read, Read* mate, graphtools
             *mateAlign);
     }
 
+    if (summaries)
+    {
+        *summaries = SummaryPair(std::move(readSummary), std::move(mateSummary));
+    }
+
     return { readAlign, mateAlign };
 }
 
-LocusAligner::OptionalAlign LocusAligner::align(Read& read, graphtools::AlignerSelector& alignerSelector) const
+LocusAligner::OptionalAlign LocusAligner::align(Read& read, graphtools::AlignerSelector& alignerSelector)
+{
+    if (!alignmentMemo_)
+    {
+        return alignWithoutMemo(read, alignerSelector, nullptr);
+    }
+
+    const MemoizedAlignment* memoizedAlignment = alignmentMemo_->find(read.sequence());
+    if (memoizedAlignment)
+    {
+        if (memoizedAlignment->isReverseComplemented)
+        {
+            read.reverseComplement();
+        }
+        // Counted as if the read was aligned again so that the statistics do not depend on the memo
+        if (memoizedAlignment->isRejectedByOrientationPredictor)
+        {
+            ++stats_.numReadsRejectedByOrientationPredictor;
+        }
+        return memoizedAlignment->alignment;
+    }
+
+    const std::string sequence = read.sequence();
+    const bool wasReversed = read.isReversed();
+    MemoizedAlignment outcome;
+    outcome.alignment = alignWithoutMemo(read, alignerSelector, &outcome.isRejectedByOrientationPredictor);
+    outcome.isReverseComplemented = read.isReversed() != wasReversed;
+    alignmentMemo_->insert(sequence, outcome);
+
+    return outcome.alignment;
+}
+
+LocusAligner::OptionalAlign
+LocusAligner::alignWithoutMemo(
+    Read& read, graphtools::AlignerSelector& alignerSelector, bool* isRejectedByOrientationPredictor)
 {
     OrientationPrediction predictedOrientation = orientationPredictor_.predict(read.sequence());
 
@@ -85,9 +161,27 @@ LocusAligner::OptionalAlign LocusAligner::align(Read& read, graphtools::AlignerS
     }
     else if (predictedOrientation == OrientationPrediction::kDoesNotAlign)
     {
+        ++stats_.numReadsRejectedByOrientationPredictor;
+        if (isRejectedByOrientationPredictor)
+        {
+            *isRejectedByOrientationPredictor = true;
+        }
         return {};
     }
 
+    if (inRepeatReadAligner_)
+    {
+        auto directAlign = inRepeatReadAligner_->align(read.sequence());
+        if (directAlign)
+        {
+            if (graphtools::shouldValidate())
+            {
+                return validateInRepeatAlignment(read, std::move(directAlign), alignerSelector);
+            }
+            return directAlign;
+        }
+    }
+
     auto readAligns = aligner_.align(read.sequence(), alignerSelector);
     if (readAligns.empty())
     {
@@ -97,5 +191,32 @@ LocusAligner::OptionalAlign LocusAligner::align(Read& read, graphtools::AlignerS
     return computeCanonicalAlignment(readAligns);
 }
 
+LocusAligner::OptionalAlign LocusAligner::validateInRepeatAlignment(
+    const Read& read, OptionalAlign directAlign, graphtools::AlignerSelector& alignerSelector)
+{
+    const auto readAligns = aligner_.align(read.sequence(), alignerSelector);
+    OptionalAlign graphAlign;
+    if (!readAligns.empty())
+    {
+        graphAlign = computeCanonicalAlignment(readAligns);
+    }
+
+    if (graphAlign == directAlign)
+    {
+        return directAlign;
+    }
+
+    // The graph alignment is the reference behavior, so a disagreement is reported without failing the analysis
+    ++stats_.numInRepeatAlignmentMismatches;
+    static std::atomic<bool> isMismatchReported(false);
+    if (!isMismatchReported.exchange(true))
+    {
+        spdlog::warn(
+            "Direct alignment of in-repeat read {} at {} disagrees with its graph alignment; using the graph alignment",
+            read.fragmentId(), locusId_);
+    }
+    return graphAlign;
+}
+
 }
 }
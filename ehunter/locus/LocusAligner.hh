@@ -21,14 +21,19 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include <boost/optional.hpp>
 
+#include "alignment/AlignmentSummary.hh"
 #include "alignment/OrientationPredictor.hh"
+#include "alignment/SoftclippingAligner.hh"
 #include "core/Parameters.hh"
 #include "core/Read.hh"
 #include "locus/AlignmentBuffer.hh"
+#include "locus/AlignmentMemo.hh"
+#include "locus/InRepeatReadAligner.hh"
 
 #include "graphalign/GappedAligner.hh"
 #include "graphio/AlignmentWriter.hh"
@@ -45,6 +50,8 @@ public:
     using Align = graphtools::GraphAlignment;
     using OptionalAlign = boost::optional<Align>;
     using AlignedPair = std::pair<OptionalAlign, OptionalAlign>;
+    using OptionalSummary = boost::optional<AlignmentSummary>;
+    using SummaryPair = std::pair<OptionalSummary, OptionalSummary>;
     using AlignmentWriterPtr = std::shared_ptr<graphtools::AlignmentWriter>;
     using AlignmentBufferPtr = std::shared_ptr<AlignmentBuffer>;
 
@@ -57,17 +64,45 @@ public:
         AlignmentBufferPtr buffer);
 
     /// \param[in,out] alignerSelector A per-thread alignment workspace which mutates during alignment
+    /// \param[out] summaries If not null, receives the summaries of the returned alignments
     ///
-    AlignedPair align(Read& read, Read* mate, graphtools::AlignerSelector& alignerSelector);
+    AlignedPair align(
+        Read& read, Read* mate, graphtools::AlignerSelector& alignerSelector, SummaryPair* summaries = nullptr);
+
+    /// Memo of the alignments of previously seen read sequences; null if memoization is off
+    const AlignmentMemo* alignmentMemo() const { return alignmentMemo_.get_ptr(); }
+
+    struct Stats
+    {
+        int64_t numPairs = 0;
+        /// Reads that the orientation predictor found not to align to the locus graph
+        int64_t numReadsRejectedByOrientationPredictor = 0;
+        /// Pairs that failed the non-repeat alignment score filter after alignment
+        int64_t numPairsRejectedByScoreFilter = 0;
+        /// Validated in-repeat reads whose direct alignment disagreed with the graph aligner
+        int64_t numInRepeatAlignmentMismatches = 0;
+    };
+
+    const Stats& stats() const { return stats_; }
 
 private:
-    OptionalAlign align(Read& read, graphtools::AlignerSelector& alignerSelector) const;
+    OptionalAlign align(Read& read, graphtools::AlignerSelector& alignerSelector);
+    /// \param[out] isRejectedByOrientationPredictor If not null, set when the orientation predictor rejects the read
+    OptionalAlign alignWithoutMemo(
+        Read& read, graphtools::AlignerSelector& alignerSelector, bool* isRejectedByOrientationPredictor);
+
+    /// Return the graph alignment of an in-repeat read in place of its direct alignment if the two disagree
+    OptionalAlign validateInRepeatAlignment(
+        const Read& read, OptionalAlign directAlign, graphtools::AlignerSelector& alignerSelector);
 
     std::string locusId_;
-    graphtools::GappedGraphAligner aligner_;
+    SoftclippingAligner aligner_;
     OrientationPredictor orientationPredictor_;
+    boost::optional<InRepeatReadAligner> inRepeatReadAligner_;
     AlignmentWriterPtr writer_;
     AlignmentBufferPtr alignmentBuffer_;
+    boost::optional<AlignmentMemo> alignmentMemo_;
+    Stats stats_;
 };
 
 }
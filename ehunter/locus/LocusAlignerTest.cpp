@@ -24,6 +24,7 @@
 #include "gmock/gmock.h"
 
 #include "graphalign/GraphAlignmentOperations.hh"
+#include "graphalign/ValidationLevel.hh"
 #include "graphio/AlignmentWriter.hh"
 
 #include "io/GraphBlueprint.hh"
@@ -95,3 +96,116 @@ TEST(AligningReads, NotLocallyPlasedReads_NotAligned)
     ASSERT_FALSE(alignedPair.first);
     ASSERT_FALSE(alignedPair.second);
 }
+
+TEST(AligningReads, RepeatedReadPairWithMemo_AlignedAsFirstPair)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATATTA(C)*GGCGGC"));
+    HeuristicParameters params(1000, 10, 20, true, graphtools::AlignerType::DAG_ALIGNER, 4, 0, 0, 4, 1);
+    params.setAlignmentMemoSize(10);
+    LocusAligner aligner("str", &graph, params, std::make_shared<BlankAlignmentWriter>(), {});
+    graphtools::AlignerSelector selector(graphtools::AlignerType::DAG_ALIGNER);
+
+    GraphAlignment expectedReadAlign = decodeGraphAlignment(2, "0[4M]1[1M]1[1M]", &graph);
+    GraphAlignment expectedMateAlign = decodeGraphAlignment(0, "2[6M]", &graph);
+
+    for (int pairIndex = 0; pairIndex != 2; ++pairIndex)
+    {
+        Read read(ReadId("frag" + std::to_string(pairIndex), MateNumber::kFirstMate), "GGTAAT", true);
+        Read mate(ReadId("frag" + std::to_string(pairIndex), MateNumber::kSecondMate), "GCCGCC", false);
+        auto alignedPair = aligner.align(read, &mate, selector);
+
+        ASSERT_TRUE(alignedPair.first && alignedPair.second);
+        EXPECT_EQ(expectedReadAlign, *alignedPair.first);
+        EXPECT_EQ(expectedMateAlign, *alignedPair.second);
+        EXPECT_FALSE(read.isReversed());
+        EXPECT_TRUE(mate.isReversed());
+    }
+
+    ASSERT_NE(nullptr, aligner.alignmentMemo());
+    EXPECT_EQ(4, aligner.alignmentMemo()->stats().numLookups);
+    EXPECT_EQ(2, aligner.alignmentMemo()->stats().numHits);
+}
+
+TEST(AligningReads, InRepeatReadsAlignedDirectly_AlignmentsMatchGraphAligner)
+{
+    const auto initialValidationLevel = graphtools::getValidationLevel();
+    graphtools::setValidationLevel(graphtools::ValidationLevel::kFull);
+
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("TTGGATCGTA(CAG)*CGTTACGTAA"));
+    HeuristicParameters directParams(1000, 10, 20, true, graphtools::AlignerType::DAG_ALIGNER, 4, 0, 0, 4, 1);
+    HeuristicParameters graphParams = directParams;
+    directParams.setAlignInRepeatReadsDirectly(true);
+    LocusAligner directAligner("str", &graph, directParams, std::make_shared<BlankAlignmentWriter>(), {});
+    LocusAligner graphAligner("str", &graph, graphParams, std::make_shared<BlankAlignmentWriter>(), {});
+    graphtools::AlignerSelector selector(graphtools::AlignerType::DAG_ALIGNER);
+
+    const std::vector<std::string> sequences = { "AGCAGCAGCAGCA", "CAGCAGCAGCAG", "GCAGCAGCAGCAGC", "CTGCTGCTGCTGCT" };
+    for (const std::string& sequence : sequences)
+    {
+        Read directRead(ReadId("frag1", MateNumber::kFirstMate), sequence, true);
+        Read directMate(ReadId("frag1", MateNumber::kSecondMate), "TTGGATCGTA", false);
+        Read graphRead = directRead;
+        Read graphMate = directMate;
+
+        auto directPair = directAligner.align(directRead, &directMate, selector);
+        auto graphPair = graphAligner.align(graphRead, &graphMate, selector);
+
+        ASSERT_TRUE(directPair.first && graphPair.first);
+        EXPECT_EQ(*graphPair.first, *directPair.first);
+        EXPECT_EQ(graphRead.isReversed(), directRead.isReversed());
+    }
+    EXPECT_EQ(0, directAligner.stats().numInRepeatAlignmentMismatches);
+
+    graphtools::setValidationLevel(initialValidationLevel);
+}
+
+TEST(AligningReads, RejectedReadsAndPairs_Counted)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATATTA(C)*GGCGGC"));
+    auto aligner = makeStrAligner(&graph);
+    graphtools::AlignerSelector selector(graphtools::AlignerType::DAG_ALIGNER);
+
+    Read read(ReadId("frag1", MateNumber::kFirstMate), "TACCC", true);
+    Read mate(ReadId("frag1", MateNumber::kSecondMate), "CCCGG", false);
+    aligner.align(read, &mate, selector);
+
+    Read unalignedRead(ReadId("frag2", MateNumber::kFirstMate), "TTTTTT", true);
+    Read unalignedMate(ReadId("frag2", MateNumber::kSecondMate), "AAAAAA", false);
+    aligner.align(unalignedRead, &unalignedMate, selector);
+
+    EXPECT_EQ(2, aligner.stats().numPairs);
+    EXPECT_EQ(2, aligner.stats().numReadsRejectedByOrientationPredictor);
+    EXPECT_EQ(2, aligner.stats().numPairsRejectedByScoreFilter);
+}
+
+TEST(AligningReads, RepeatedReadPairsWithMemo_CountedAsWithoutMemo)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATATTA(C)*GGCGGC"));
+    HeuristicParameters params(1000, 10, 20, true, graphtools::AlignerType::DAG_ALIGNER, 4, 0, 0, 4, 1);
+    LocusAligner aligner("str", &graph, params, std::make_shared<BlankAlignmentWriter>(), {});
+    params.setAlignmentMemoSize(10);
+    LocusAligner memoizingAligner("str", &graph, params, std::make_shared<BlankAlignmentWriter>(), {});
+    graphtools::AlignerSelector selector(graphtools::AlignerType::DAG_ALIGNER);
+
+    for (int pairIndex = 0; pairIndex != 3; ++pairIndex)
+    {
+        for (LocusAligner* currentAligner : { &aligner, &memoizingAligner })
+        {
+            Read read(ReadId("frag1", MateNumber::kFirstMate), "TACCC", true);
+            Read mate(ReadId("frag1", MateNumber::kSecondMate), "CCCGG", false);
+            currentAligner->align(read, &mate, selector);
+
+            Read unalignedRead(ReadId("frag2", MateNumber::kFirstMate), "TTTTTT", true);
+            Read unalignedMate(ReadId("frag2", MateNumber::kSecondMate), "AAAAAA", false);
+            currentAligner->align(unalignedRead, &unalignedMate, selector);
+        }
+    }
+
+    EXPECT_EQ(8, memoizingAligner.alignmentMemo()->stats().numHits);
+    EXPECT_EQ(aligner.stats().numPairs, memoizingAligner.stats().numPairs);
+    EXPECT_EQ(6, memoizingAligner.stats().numReadsRejectedByOrientationPredictor);
+    EXPECT_EQ(
+        aligner.stats().numReadsRejectedByOrientationPredictor,
+        memoizingAligner.stats().numReadsRejectedByOrientationPredictor);
+    EXPECT_EQ(aligner.stats().numPairsRejectedByScoreFilter, memoizingAligner.stats().numPairsRejectedByScoreFilter);
+}
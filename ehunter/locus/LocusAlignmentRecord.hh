@@ -0,0 +1,59 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "graphalign/GraphAlignment.hh"
+
+#include "core/Read.hh"
+
+namespace ehunter
+{
+namespace locus
+{
+
+/// Read in the orientation it was aligned in together with its graph alignment
+struct AlignedRead
+{
+    Read read;
+    graphtools::GraphAlignment alignment;
+};
+
+/// \brief All read evidence collected at a locus after graph alignment
+///
+/// The record contains everything needed to repeat the variant analysis of a locus without reading or aligning any
+/// reads, which allows a sample to be re-genotyped with different genotyping parameters.
+///
+struct LocusAlignmentRecord
+{
+    /// Read pairs with both mates aligned to the locus graph
+    std::vector<std::pair<AlignedRead, AlignedRead>> alignedPairs;
+
+    /// Reads aligned to the locus graph whose mates did not align; these only contribute to locus statistics
+    std::vector<AlignedRead> alignedSingleReads;
+
+    /// Number of in-repeat read pairs found by the IRR pair finder
+    int irrPairCount = 0;
+};
+
+}
+}
@@ -23,6 +23,8 @@
 
 #include <boost/smart_ptr/make_unique.hpp>
 
+#include "spdlog/spdlog.h"
+
 #include "locus/LocusAligner.hh"
 #include "locus/RFC1MotifAnalysis.hh"
 #include "locus/RepeatAnalyzer.hh"
@@ -41,10 +43,25 @@ namespace ehunter
 namespace locus
 {
 
+// Loci requiring genome-wide depth (such as SMN) are genotyped with the sample depth; other loci keep their local
+// depth, capped by the sample depth
+static void applySampleDepth(const LocusSpecification& locusSpec, double sampleDepth, LocusStats& stats)
+{
+    if (locusSpec.requiresGenomeWideDepth())
+    {
+        stats.useIndexDepth(sampleDepth);
+    }
+    else
+    {
+        stats.setIndexDepth(sampleDepth);
+    }
+}
+
 LocusAnalyzer::LocusAnalyzer(LocusSpecification locusSpec, const HeuristicParameters& params, AlignWriterPtr writer)
     : locusSpec_(std::move(locusSpec))
     , alignmentBuffer_(locusSpec_.useRFC1MotifAnalysis() ? std::make_shared<locus::AlignmentBuffer>() : nullptr)
-    , aligner_(locusSpec_.locusId(), &locusSpec_.regionGraph(), params, std::move(writer), alignmentBuffer_)
+    , heuristicParams_(params)
+    , writer_(std::move(writer))
     , statsCalc_(locusSpec_.typeOfChromLocusLocatedOn(), locusSpec_.regionGraph())
 {
     for (const auto& variantSpec : locusSpec_.variantSpecs())
@@ -98,7 +115,8 @@ void LocusAnalyzer::processMates(
 
 void LocusAnalyzer::processOntargetMates(Read& read, Read* mate, graphtools::AlignerSelector& alignerSelector)
 {
-    auto alignedPair = aligner_.align(read, mate, alignerSelector);
+    LocusAligner::SummaryPair summaries;
+    auto alignedPair = aligner().align(read, mate, alignerSelector, &summaries);
 
     const bool neitherMateAligned = !alignedPair.first && !alignedPair.second;
     const bool bothMatesAligned = alignedPair.first && alignedPair.second;
@@ -111,22 +129,47 @@ void LocusAnalyzer::processOntargetMates(Read& read, Read* mate, graphtools::Ali
 
     if (bothMatesAligned)
     {
-        statsCalc_.inspect(*alignedPair.first, *alignedPair.second);
-        runVariantAnalysis(read, *alignedPair.first, *mate, *alignedPair.second);
+        statsCalc_.inspect(*summaries.first, *summaries.second);
+        runVariantAnalysis(
+            read, *alignedPair.first, *summaries.first, *mate, *alignedPair.second, *summaries.second);
+        if (alignmentRecord_)
+        {
+            alignmentRecord_->alignedPairs.emplace_back(
+                AlignedRead { read, *alignedPair.first }, AlignedRead { *mate, *alignedPair.second });
+        }
     }
     else
     {
         if (alignedPair.first)
         {
-            statsCalc_.inspectRead(*alignedPair.first);
+            statsCalc_.inspectRead(*summaries.first);
+            if (alignmentRecord_)
+            {
+                alignmentRecord_->alignedSingleReads.push_back({ read, *alignedPair.first });
+            }
         }
         if (alignedPair.second)
         {
-            statsCalc_.inspectRead(*alignedPair.second);
+            statsCalc_.inspectRead(*summaries.second);
+            if (alignmentRecord_)
+            {
+                alignmentRecord_->alignedSingleReads.push_back({ *mate, *alignedPair.second });
+            }
         }
     }
 }
 
+LocusAligner& LocusAnalyzer::aligner()
+{
+    if (!aligner_)
+    {
+        aligner_ = make_unique<LocusAligner>(
+            locusSpec_.locusId(), &locusSpec_.regionGraph(), heuristicParams_, writer_, alignmentBuffer_);
+    }
+
+    return *aligner_;
+}
+
 void LocusAnalyzer::processOfftargetMates(const Read& read, const Read& mate)
 {
     if (!irrPairFinder_)
@@ -137,31 +180,123 @@ void LocusAnalyzer::processOfftargetMates(const Read& read, const Read& mate)
 
     if (irrPairFinder_->check(read.sequence(), mate.sequence()))
     {
-        int numAnalyzersFound = 0;
-        for (auto& variantAnalyzer : variantAnalyzers_)
+        addIrrPairs(1);
+    }
+}
+
+void LocusAnalyzer::addIrrPairs(const int irrPairCount)
+{
+    int numAnalyzersFound = 0;
+    for (auto& variantAnalyzer : variantAnalyzers_)
+    {
+        auto repeatAnalyzer = dynamic_cast<RepeatAnalyzer*>(variantAnalyzer.get());
+        if (repeatAnalyzer != nullptr && repeatAnalyzer->repeatUnit() == irrPairFinder_->targetMotif())
         {
-            auto repeatAnalyzer = dynamic_cast<RepeatAnalyzer*>(variantAnalyzer.get());
-            if (repeatAnalyzer != nullptr && repeatAnalyzer->repeatUnit() == irrPairFinder_->targetMotif())
+            numAnalyzersFound++;
+            for (int irrPairIndex(0); irrPairIndex < irrPairCount; ++irrPairIndex)
             {
-                numAnalyzersFound++;
                 repeatAnalyzer->addInrepeatReadPair();
             }
         }
+    }
+
+    if (numAnalyzersFound != 1)
+    {
+        const string message = "Locus " + locusSpec_.locusId() + " must have exactly one rare motif";
+        throw std::logic_error(message);
+    }
+
+    if (alignmentRecord_)
+    {
+        alignmentRecord_->irrPairCount += irrPairCount;
+    }
+}
+
+void LocusAnalyzer::enableAlignmentRecording()
+{
+    if (!alignmentRecord_)
+    {
+        alignmentRecord_ = LocusAlignmentRecord();
+    }
+}
+
+void LocusAnalyzer::processAlignmentRecord(const LocusAlignmentRecord& record)
+{
+    for (const auto& alignedPair : record.alignedPairs)
+    {
+        const AlignedRead& read = alignedPair.first;
+        const AlignedRead& mate = alignedPair.second;
+
+        // Mirror the side effects of LocusAligner for pairs with both mates aligned:
+        if (alignmentBuffer_)
+        {
+            alignmentBuffer_->testAndPushRead(read.read.sequence(), read.read.isReversed(), read.alignment);
+        }
+        for (const AlignedRead* alignedRead : { &read, &mate })
+        {
+            writer_->write(
+                locusSpec_.locusId(), alignedRead->read.fragmentId(), alignedRead->read.sequence(),
+                alignedRead->read.isFirstMate(), alignedRead->read.isReversed(), alignedRead->read.isReversed(),
+                alignedRead->alignment);
+        }
+
+        const AlignmentSummary readSummary(read.alignment);
+        const AlignmentSummary mateSummary(mate.alignment);
+        statsCalc_.inspect(readSummary, mateSummary);
+        runVariantAnalysis(read.read, read.alignment, readSummary, mate.read, mate.alignment, mateSummary);
+    }
+
+    for (const auto& alignedRead : record.alignedSingleReads)
+    {
+        statsCalc_.inspectRead(AlignmentSummary(alignedRead.alignment));
+    }
 
-        if (numAnalyzersFound != 1)
+    if (record.irrPairCount > 0)
+    {
+        if (!irrPairFinder_)
         {
-            const string message = "Locus " + locusSpec_.locusId() + " must have exactly one rare motif";
+            const string message = "Locus " + locusSpec_.locusId() + " is not supposed to have in-repeat read pairs";
             throw std::logic_error(message);
         }
+        addIrrPairs(record.irrPairCount);
+    }
+
+    if (alignmentRecord_)
+    {
+        alignmentRecord_->alignedPairs.insert(
+            alignmentRecord_->alignedPairs.end(), record.alignedPairs.begin(), record.alignedPairs.end());
+        alignmentRecord_->alignedSingleReads.insert(
+            alignmentRecord_->alignedSingleReads.end(), record.alignedSingleReads.begin(),
+            record.alignedSingleReads.end());
     }
 }
 
-LocusFindings LocusAnalyzer::analyze(Sex sampleSex, boost::optional<double> genomeWideDepth)
+LocusFindings LocusAnalyzer::analyze(Sex sampleSex, boost::optional<double> sampleDepth)
 {
+    if (aligner_)
+    {
+        const LocusAligner::Stats& alignerStats = aligner_->stats();
+        spdlog::debug(
+            "Read pairs of {}: {} processed, {} reads rejected by the orientation predictor, {} pairs rejected by the "
+            "non-repeat score filter, {} in-repeat reads realigned by the graph aligner",
+            locusSpec_.locusId(), alignerStats.numPairs, alignerStats.numReadsRejectedByOrientationPredictor,
+            alignerStats.numPairsRejectedByScoreFilter, alignerStats.numInRepeatAlignmentMismatches);
+    }
+
+    if (aligner_ && aligner_->alignmentMemo())
+    {
+        const AlignmentMemo& memo = *aligner_->alignmentMemo();
+        const AlignmentMemo::Stats& memoStats = memo.stats();
+        spdlog::debug(
+            "Alignment memo of {}: {} of {} lookups hit, {} evictions, {} sequences using about {} bytes",
+            locusSpec_.locusId(), memoStats.numHits, memoStats.numLookups, memoStats.numEvictions, memo.size(),
+            memo.memoryUsage());
+    }
+
     LocusFindings locusFindings(statsCalc_.estimate(sampleSex));
-    if (genomeWideDepth && locusSpec_.requiresGenomeWideDepth())
+    if (sampleDepth)
     {
-        locusFindings.stats.setDepth(*genomeWideDepth);
+        applySampleDepth(locusSpec_, *sampleDepth, locusFindings.stats);
     }
 
     for (auto& variantAnalyzer : variantAnalyzers_)
@@ -181,12 +316,60 @@ LocusFindings LocusAnalyzer::analyze(Sex sampleSex, boost::optional<double> geno
     return locusFindings;
 }
 
+LocusFindings LocusAnalyzer::analyzeWithoutReads(
+    const LocusSpecification& locusSpec, Sex sampleSex, boost::optional<double> sampleDepth)
+{
+    const AlleleCount alleleCount = determineExpectedAlleleCount(locusSpec.typeOfChromLocusLocatedOn(), sampleSex);
+    LocusFindings locusFindings(LocusStats(alleleCount, 0, 0, 0.0));
+    if (sampleDepth)
+    {
+        applySampleDepth(locusSpec, *sampleDepth, locusFindings.stats);
+    }
+
+    // Without reads, the mean read length is zero and so every variant is low-depth regardless of the sample depth
+    for (const auto& variantSpec : locusSpec.variantSpecs())
+    {
+        if (variantSpec.classification().type == VariantType::kRepeat)
+        {
+            auto repeatFindings = RepeatAnalyzer::makeLowDepthFindings(alleleCount);
+            if (locusSpec.useMotifCompositionAnalysis())
+            {
+                repeatFindings->setMotifComposition(MotifCounts());
+            }
+            locusFindings.findingsForEachVariant.emplace(variantSpec.id(), std::move(repeatFindings));
+        }
+        else if (variantSpec.classification().type == VariantType::kSmallVariant)
+        {
+            locusFindings.findingsForEachVariant.emplace(
+                variantSpec.id(), SmallVariantAnalyzer::makeLowDepthFindings(alleleCount));
+        }
+        else
+        {
+            std::stringstream encoding;
+            encoding << variantSpec.classification().type << "/" << variantSpec.classification().subtype;
+            throw std::logic_error("Missing logic to report findings for " + encoding.str());
+        }
+    }
+
+    if (locusSpec.useRFC1MotifAnalysis())
+    {
+        runRFC1MotifAnalysis(AlignmentBuffer(), locusFindings);
+    }
+
+    return locusFindings;
+}
+
 void LocusAnalyzer::addIrrPairFinder(std::string motif) { irrPairFinder_ = IrrPairFinder(std::move(motif)); }
 
 void LocusAnalyzer::addRepeatAnalyzer(std::string variantId, graphtools::NodeId nodeId)
 {
-    variantAnalyzers_.emplace_back(make_unique<RepeatAnalyzer>(
-        std::move(variantId), locusSpec_.regionGraph(), nodeId, locusSpec_.genotyperParameters()));
+    auto repeatAnalyzer = make_unique<RepeatAnalyzer>(
+        std::move(variantId), locusSpec_.regionGraph(), nodeId, locusSpec_.genotyperParameters());
+    if (locusSpec_.useMotifCompositionAnalysis())
+    {
+        repeatAnalyzer->enableMotifComposition();
+    }
+    variantAnalyzers_.push_back(std::move(repeatAnalyzer));
 }
 
 void LocusAnalyzer::addSmallVariantAnalyzer(
@@ -198,11 +381,12 @@ void LocusAnalyzer::addSmallVariantAnalyzer(
 }
 
 void LocusAnalyzer::runVariantAnalysis(
-    const Read& read, const LocusAnalyzer::Align& readAlign, const Read& mate, const LocusAnalyzer::Align& mateAlign)
+    const Read& read, const LocusAnalyzer::Align& readAlign, const AlignmentSummary& readSummary, const Read& mate,
+    const LocusAnalyzer::Align& mateAlign, const AlignmentSummary& mateSummary)
 {
     for (auto& analyzer : variantAnalyzers_)
     {
-        analyzer->processMates(read, readAlign, mate, mateAlign);
+        analyzer->processMates(read, readAlign, readSummary, mate, mateAlign, mateSummary);
     }
 }
 
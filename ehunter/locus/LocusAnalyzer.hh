@@ -36,6 +36,7 @@
 #include "locus/AlignmentBuffer.hh"
 #include "locus/IrrPairFinder.hh"
 #include "locus/LocusAligner.hh"
+#include "locus/LocusAlignmentRecord.hh"
 #include "locus/LocusFindings.hh"
 #include "locus/LocusSpecification.hh"
 #include "locus/VariantAnalyzer.hh"
@@ -69,7 +70,29 @@ public:
     const LocusSpecification& locusSpec() const { return locusSpec_; }
 
     void processMates(Read& read, Read* mate, RegionType regionType, graphtools::AlignerSelector& alignerSelector);
-    LocusFindings analyze(Sex sampleSex, boost::optional<double> genomeWideDepth);
+
+    /// \param[in] sampleDepth Depth estimated independently of the reads at the locus; when set, it is used for
+    /// genotyping loci requiring genome-wide depth (such as SMN) and caps the depth estimated from the reads aligned to
+    /// the flanks of other loci (see reconcileLocusDepth)
+    LocusFindings analyze(Sex sampleSex, boost::optional<double> sampleDepth);
+
+    /// \brief Findings of a locus that received no reads
+    ///
+    /// These are the findings an analyzer of the locus would report without processing any reads, computed without
+    /// constructing the analyzer
+    ///
+    static LocusFindings
+    analyzeWithoutReads(const LocusSpecification& locusSpec, Sex sampleSex, boost::optional<double> sampleDepth);
+
+    /// Start keeping a record of all read evidence processed by this analyzer from this point on
+    void enableAlignmentRecording();
+    const boost::optional<LocusAlignmentRecord>& alignmentRecord() const { return alignmentRecord_; }
+
+    /// \brief Process read evidence recorded at the same locus by an earlier analysis
+    ///
+    /// Alignments in \p record must refer to the graph of this locus
+    ///
+    void processAlignmentRecord(const LocusAlignmentRecord& record);
 
     const boost::optional<IrrPairFinder>& irrPairFinder() const { return irrPairFinder_; }
     void addIrrPairFinder(std::string motif);
@@ -81,17 +104,27 @@ public:
 private:
     void processOntargetMates(Read& read, Read* mate, graphtools::AlignerSelector& alignerSelector);
     void processOfftargetMates(const Read& read, const Read& mate);
-    void runVariantAnalysis(const Read& read, const Align& readAlign, const Read& mate, const Align& mateAlign);
+    void addIrrPairs(int irrPairCount);
+    void runVariantAnalysis(
+        const Read& read, const Align& readAlign, const AlignmentSummary& readSummary, const Read& mate,
+        const Align& mateAlign, const AlignmentSummary& mateSummary);
+    LocusAligner& aligner();
 
     LocusSpecification locusSpec_;
 
     // Read alignments are optionally buffered for custom additional analysis at certain loci
     std::shared_ptr<locus::AlignmentBuffer> alignmentBuffer_;
 
-    LocusAligner aligner_;
+    // The aligner is built when the first on-target read arrives because its indexes are costly to construct and most
+    // loci in large catalogs receive no reads from targeted sequencing data
+    HeuristicParameters heuristicParams_;
+    AlignWriterPtr writer_;
+    std::unique_ptr<LocusAligner> aligner_;
+
     LocusStatsCalculator statsCalc_;
     boost::optional<IrrPairFinder> irrPairFinder_;
     std::vector<std::unique_ptr<VariantAnalyzer>> variantAnalyzers_;
+    boost::optional<LocusAlignmentRecord> alignmentRecord_;
 };
 
 }
@@ -74,3 +74,105 @@ TEST(CreatingLocusAnalyzer, TypicalParameters_Created)
 
     ASSERT_EQ(repeatFindings, observed);
 }
+
+TEST(ReplayingAlignmentRecord, RecordedEvidence_SameFindings)
+{
+    auto locusSpec = buildStrSpec("ATTCGA(C)*ATGTCG");
+
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER, 4, 1, 5, 4, 1);
+    auto writer = std::make_shared<graphtools::BlankAlignmentWriter>();
+
+    graphtools::AlignerSelector selector(heuristicParams.alignerType());
+    LocusAnalyzer locusAnalyzer(locusSpec, heuristicParams, writer);
+    locusAnalyzer.enableAlignmentRecording();
+
+    Read read1(ReadId("read1", MateNumber::kFirstMate), "CGACCCATGT", true);
+    Read mate1(ReadId("read1", MateNumber::kSecondMate), "GACCCATGTC", true);
+    locusAnalyzer.processMates(read1, &mate1, RegionType::kTarget, selector);
+
+    Read read2(ReadId("read2", MateNumber::kFirstMate), "CGACATGT", true);
+    Read mate2(ReadId("read2", MateNumber::kSecondMate), "GACATGTC", true);
+    locusAnalyzer.processMates(read2, &mate2, RegionType::kTarget, selector);
+
+    ASSERT_TRUE(locusAnalyzer.alignmentRecord());
+    EXPECT_EQ(2ul, locusAnalyzer.alignmentRecord()->alignedPairs.size());
+
+    LocusAnalyzer replayingAnalyzer(locusSpec, heuristicParams, writer);
+    replayingAnalyzer.processAlignmentRecord(*locusAnalyzer.alignmentRecord());
+
+    LocusFindings expectedFindings = locusAnalyzer.analyze(Sex::kFemale, boost::none);
+    LocusFindings observedFindings = replayingAnalyzer.analyze(Sex::kFemale, boost::none);
+    EXPECT_EQ(
+        *dynamic_cast<RepeatFindings*>(expectedFindings.findingsForEachVariant["repeat"].get()),
+        *dynamic_cast<RepeatFindings*>(observedFindings.findingsForEachVariant["repeat"].get()));
+    EXPECT_EQ(expectedFindings.stats, observedFindings.stats);
+}
+
+TEST(AnalyzingLocus, SampleDepthGiven_LowLocusDepthKept)
+{
+    auto locusSpec = buildStrSpec("GCTAGCTTAGGCATCGATCCAGTTACGTACATTCGA(C)*ATGTCG");
+
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER, 4, 1, 5, 4, 1);
+    auto writer = std::make_shared<graphtools::BlankAlignmentWriter>();
+
+    graphtools::AlignerSelector selector(heuristicParams.alignerType());
+    LocusAnalyzer locusAnalyzer(locusSpec, heuristicParams, writer);
+
+    Read read(ReadId("read1", MateNumber::kFirstMate), "CGACCCATGT", true);
+    Read mate(ReadId("read1", MateNumber::kSecondMate), "GACCCATGTC", true);
+    locusAnalyzer.processMates(read, &mate, RegionType::kTarget, selector);
+
+    // Two reads over 32 start positions fall far below both the sample depth and the minimum locus coverage
+    LocusFindings locusFindings = locusAnalyzer.analyze(Sex::kFemale, 30.0);
+    EXPECT_DOUBLE_EQ(0.625, locusFindings.stats.localDepth());
+    EXPECT_DOUBLE_EQ(locusFindings.stats.localDepth(), locusFindings.stats.depth());
+    ASSERT_TRUE(locusFindings.stats.indexDepth());
+    EXPECT_EQ(30.0, *locusFindings.stats.indexDepth());
+
+    const auto& repeatFindings = *dynamic_cast<RepeatFindings*>(locusFindings.findingsForEachVariant["repeat"].get());
+    EXPECT_EQ(GenotypeFilter::kLowDepth, repeatFindings.genotypeFilter() & GenotypeFilter::kLowDepth);
+}
+
+TEST(AnalyzingLocus, SmnLocusGivenSampleDepth_SampleDepthUsed)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("GCTAGCTTAGGCATCGATCCAGTTACGTACATTCGA(C|T)ATGTCG"));
+    const GenomicRegion region(1, 1, 2);
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    LocusSpecification locusSpec("smn", ChromType::kAutosome, { region }, graph, dummyAssociation, params, false);
+    VariantClassification classification(VariantType::kSmallVariant, VariantSubtype::kSMN);
+    locusSpec.addVariantSpecification("variant", classification, region, { 1, 2 }, 1);
+
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER, 4, 1, 5, 4, 1);
+    auto writer = std::make_shared<graphtools::BlankAlignmentWriter>();
+    LocusAnalyzer locusAnalyzer(locusSpec, heuristicParams, writer);
+
+    LocusFindings locusFindings = locusAnalyzer.analyze(Sex::kFemale, 30.0);
+    EXPECT_DOUBLE_EQ(0.0, locusFindings.stats.localDepth());
+    EXPECT_DOUBLE_EQ(30.0, locusFindings.stats.depth());
+    EXPECT_EQ(locusFindings.stats, LocusAnalyzer::analyzeWithoutReads(locusSpec, Sex::kFemale, 30.0).stats);
+}
+
+TEST(AnalyzingLocus, LocusWithoutReads_SameFindingsWithoutAnalyzer)
+{
+    auto locusSpec = buildStrSpec("ATTCGA(C)*ATGTCG");
+    locusSpec.setMotifCompositionAnalysis(true);
+
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER, 4, 1, 5, 4, 1);
+    auto writer = std::make_shared<graphtools::BlankAlignmentWriter>();
+    LocusAnalyzer locusAnalyzer(locusSpec, heuristicParams, writer);
+
+    LocusFindings expectedFindings = locusAnalyzer.analyze(Sex::kMale, 30.0);
+    LocusFindings observedFindings = LocusAnalyzer::analyzeWithoutReads(locusSpec, Sex::kMale, 30.0);
+
+    EXPECT_EQ(expectedFindings.stats, observedFindings.stats);
+    ASSERT_EQ(1ul, observedFindings.findingsForEachVariant.size());
+    const auto& expectedRepeatFindings
+        = *dynamic_cast<RepeatFindings*>(expectedFindings.findingsForEachVariant["repeat"].get());
+    const auto& observedRepeatFindings
+        = *dynamic_cast<RepeatFindings*>(observedFindings.findingsForEachVariant["repeat"].get());
+    EXPECT_EQ(expectedRepeatFindings, observedRepeatFindings);
+    EXPECT_EQ(GenotypeFilter::kLowDepth, observedRepeatFindings.genotypeFilter());
+    EXPECT_EQ(expectedRepeatFindings.alleleCount(), observedRepeatFindings.alleleCount());
+    EXPECT_TRUE(expectedRepeatFindings.motifComposition() == observedRepeatFindings.motifComposition());
+}
@@ -99,4 +99,58 @@ bool LocusSpecification::requiresGenomeWideDepth() const
     return false;
 }
 
+uint64_t LocusSpecification::contentHash() const
+{
+    std::ostringstream encoding;
+    encoding.precision(17);
+
+    // Genotyping parameters and analysis options are left out since they do not change read alignments
+    encoding << locusId_;
+
+    encoding << "|target";
+    for (const auto& region : targetReadExtractionRegions_)
+    {
+        encoding << ' ' << region;
+    }
+    encoding << "|offtarget";
+    for (const auto& region : offtargetReadExtractionRegions_)
+    {
+        encoding << ' ' << region;
+    }
+
+    // Node sequences include the flanks, so flank changes are captured by the graph
+    encoding << "|graph";
+    for (NodeId nodeId = 0; nodeId != static_cast<NodeId>(regionGraph_.numNodes()); ++nodeId)
+    {
+        encoding << ' ' << regionGraph_.nodeSeq(nodeId) << ':';
+        for (const NodeId successor : regionGraph_.successors(nodeId))
+        {
+            encoding << successor << ',';
+        }
+    }
+
+    // Hash map iteration order is not stable, so node projections are encoded in node order
+    encoding << "|projections";
+    const std::map<NodeId, GenomicRegion> orderedReferenceRegions(referenceRegions_.begin(), referenceRegions_.end());
+    for (const auto& nodeAndRegion : orderedReferenceRegions)
+    {
+        encoding << ' ' << nodeAndRegion.first << '=' << nodeAndRegion.second;
+    }
+
+    encoding << "|variants";
+    for (const auto& variantSpec : variantSpecs_)
+    {
+        encoding << ' ' << variantSpec.id() << ':' << static_cast<int>(variantSpec.classification().type) << ':'
+                 << static_cast<int>(variantSpec.classification().subtype) << ':' << variantSpec.referenceLocus()
+                 << ':';
+        for (const NodeId nodeId : variantSpec.nodes())
+        {
+            encoding << nodeId << ',';
+        }
+        encoding << ':' << (variantSpec.optionalRefNode() ? static_cast<int64_t>(*variantSpec.optionalRefNode()) : -1);
+    }
+
+    return computeStableHash(encoding.str());
+}
+
 }
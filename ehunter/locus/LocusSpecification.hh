@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -86,6 +87,21 @@ public:
 
     bool useRFC1MotifAnalysis() const { return useRFC1MotifAnalysis_; }
 
+    /// True if the motif composition of the repeats of this locus is to be reported
+    bool useMotifCompositionAnalysis() const { return useMotifCompositionAnalysis_; }
+    void setMotifCompositionAnalysis(bool useMotifCompositionAnalysis)
+    {
+        useMotifCompositionAnalysis_ = useMotifCompositionAnalysis;
+    }
+
+    /// \brief Hash of the parts of the locus definition that determine read alignments
+    ///
+    /// The hash covers the locus id, graph, regions, and variant definitions but not the genotyping parameters, so
+    /// alignments stored under it remain valid when only the genotyping of the locus changes. It is stable across runs,
+    /// so it can be used to detect loci whose alignments are stale between catalog versions.
+    ///
+    uint64_t contentHash() const;
+
 private:
     std::string locusId_;
     ChromType typeOfChromLocusLocatedOn_;
@@ -96,6 +112,7 @@ private:
     NodeToRegionAssociation referenceRegions_;
     GenotyperParameters parameters_;
     bool useRFC1MotifAnalysis_;
+    bool useMotifCompositionAnalysis_ = false;
 };
 
 using RegionCatalog = std::vector<LocusSpecification>;
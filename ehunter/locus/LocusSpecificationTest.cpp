@@ -0,0 +1,66 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "locus/LocusSpecification.hh"
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using namespace ehunter;
+
+static LocusSpecification buildLocusSpec(const std::string& locusStructure, int minLocusCoverage)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex(locusStructure));
+    NodeToRegionAssociation referenceRegions;
+    referenceRegions.emplace(0, GenomicRegion(1, 94, 100));
+    referenceRegions.emplace(1, GenomicRegion(1, 100, 110));
+    referenceRegions.emplace(2, GenomicRegion(1, 110, 116));
+    GenotyperParameters params(minLocusCoverage);
+    return LocusSpecification(
+        "locus", ChromType::kAutosome, { GenomicRegion(1, 0, 200) }, graph, referenceRegions, params, false);
+}
+
+TEST(HashingLocusContent, IdenticalLoci_HashesMatch)
+{
+    const auto locusSpec = buildLocusSpec("ATTCGA(C)*ATGTCG", 10);
+    EXPECT_EQ(locusSpec.contentHash(), buildLocusSpec("ATTCGA(C)*ATGTCG", 10).contentHash());
+}
+
+TEST(HashingLocusContent, ChangedLoci_HashesDiffer)
+{
+    const auto locusSpec = buildLocusSpec("ATTCGA(C)*ATGTCG", 10);
+    EXPECT_NE(locusSpec.contentHash(), buildLocusSpec("ATTCGA(C)*ATGTCC", 10).contentHash());
+    EXPECT_NE(locusSpec.contentHash(), buildLocusSpec("ATTCGA(G)*ATGTCG", 10).contentHash());
+
+    auto locusSpecWithOfftargetRegions = buildLocusSpec("ATTCGA(C)*ATGTCG", 10);
+    locusSpecWithOfftargetRegions.setOfftargetReadExtractionRegions({ GenomicRegion(2, 100, 200) });
+    EXPECT_NE(locusSpec.contentHash(), locusSpecWithOfftargetRegions.contentHash());
+}
+
+TEST(HashingLocusContent, ChangedGenotypingParameters_HashesMatch)
+{
+    const auto locusSpec = buildLocusSpec("ATTCGA(C)*ATGTCG", 10);
+    EXPECT_EQ(locusSpec.contentHash(), buildLocusSpec("ATTCGA(C)*ATGTCG", 20).contentHash());
+
+    auto locusSpecWithMotifComposition = buildLocusSpec("ATTCGA(C)*ATGTCG", 10);
+    locusSpecWithMotifComposition.setMotifCompositionAnalysis(true);
+    EXPECT_EQ(locusSpec.contentHash(), locusSpecWithMotifComposition.contentHash());
+}
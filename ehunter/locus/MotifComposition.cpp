@@ -0,0 +1,186 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "locus/MotifComposition.hh"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using graphtools::GraphAlignment;
+using graphtools::NodeId;
+using std::string;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace
+{
+
+const uint8_t kInvalidBaseCode = 4;
+
+std::array<uint8_t, 256> buildBaseCodes()
+{
+    std::array<uint8_t, 256> baseCodes;
+    baseCodes.fill(kInvalidBaseCode);
+    baseCodes['A'] = 0;
+    baseCodes['C'] = 1;
+    baseCodes['G'] = 2;
+    baseCodes['T'] = 3;
+    return baseCodes;
+}
+
+MotifRotationTables buildMotifRotationTables(int motifLength)
+{
+    const uint32_t motifCount = 1u << (2 * motifLength);
+    const uint32_t mask = motifCount - 1;
+    const int firstBaseShift = 2 * (motifLength - 1);
+
+    MotifRotationTables tables;
+    tables.minRotations.resize(motifCount);
+    tables.classIndexes.resize(motifCount);
+    for (uint32_t packedMotif = 0; packedMotif != motifCount; ++packedMotif)
+    {
+        uint32_t rotation = packedMotif;
+        uint32_t minRotation = packedMotif;
+        for (int rotationIndex = 1; rotationIndex < motifLength; ++rotationIndex)
+        {
+            // Move the first base to the end
+            rotation = ((rotation << 2) | (rotation >> firstBaseShift)) & mask;
+            minRotation = std::min(minRotation, rotation);
+        }
+        tables.minRotations[packedMotif] = static_cast<uint16_t>(minRotation);
+
+        // Motifs are visited in increasing order, so each class is numbered when its minimal rotation is reached, and
+        // the minimal rotation of a motif always precedes the motif
+        if (minRotation == packedMotif)
+        {
+            tables.classIndexes[packedMotif] = static_cast<uint16_t>(tables.classMinRotations.size());
+            tables.classMinRotations.push_back(static_cast<uint16_t>(packedMotif));
+        }
+        else
+        {
+            tables.classIndexes[packedMotif] = tables.classIndexes[minRotation];
+        }
+    }
+
+    return tables;
+}
+
+std::array<MotifRotationTables, kMaxCompositionMotifLength + 1> buildAllMotifRotationTables()
+{
+    std::array<MotifRotationTables, kMaxCompositionMotifLength + 1> tables;
+    for (int motifLength = 1; motifLength <= kMaxCompositionMotifLength; ++motifLength)
+    {
+        tables[motifLength] = buildMotifRotationTables(motifLength);
+    }
+    return tables;
+}
+
+}
+
+const MotifRotationTables& getMotifRotationTables(int motifLength)
+{
+    if (motifLength < 1 || motifLength > kMaxCompositionMotifLength)
+    {
+        throw std::logic_error(
+            "Motif composition is not supported for motifs of length " + std::to_string(motifLength));
+    }
+
+    static const auto tables = buildAllMotifRotationTables();
+    return tables[motifLength];
+}
+
+string decodePackedMotif(uint32_t packedMotif, int motifLength)
+{
+    static const char kBases[] = { 'A', 'C', 'G', 'T' };
+    string motif(motifLength, 'N');
+    for (int position = motifLength - 1; position >= 0; --position)
+    {
+        motif[position] = kBases[packedMotif & 3];
+        packedMotif >>= 2;
+    }
+    return motif;
+}
+
+MotifCompositionCounter::MotifCompositionCounter(NodeId repeatNodeId, int motifLength)
+    : repeatNodeId_(repeatNodeId)
+    , motifLength_(motifLength)
+    , rotationTables_(&getMotifRotationTables(motifLength))
+    , counts_(rotationTables_->classMinRotations.size(), 0)
+{
+}
+
+void MotifCompositionCounter::addRead(const string& read, const GraphAlignment& alignment)
+{
+    static const auto kBaseCodes = buildBaseCodes();
+    const uint32_t unitLength = motifLength_;
+
+    size_t queryStart = 0;
+    for (size_t nodeIndex = 0; nodeIndex != alignment.size(); ++nodeIndex)
+    {
+        const auto& nodeAlignment = alignment[nodeIndex];
+        const bool isFullUnit = alignment.getNodeIdByIndex(nodeIndex) == repeatNodeId_
+            && nodeAlignment.referenceLength() == unitLength && nodeAlignment.queryLength() == unitLength
+            && nodeAlignment.numMatched() + nodeAlignment.numMismatched() == unitLength;
+
+        if (isFullUnit && queryStart + unitLength <= read.size())
+        {
+            uint32_t packedMotif = 0;
+            uint8_t combinedCodes = 0;
+            for (size_t position = queryStart; position != queryStart + unitLength; ++position)
+            {
+                const uint8_t baseCode = kBaseCodes[static_cast<unsigned char>(read[position])];
+                combinedCodes |= baseCode;
+                packedMotif = (packedMotif << 2) | (baseCode & 3);
+            }
+
+            if (combinedCodes < kInvalidBaseCode)
+            {
+                ++counts_[rotationTables_->classIndexes[packedMotif]];
+            }
+        }
+
+        queryStart += nodeAlignment.queryLength();
+    }
+}
+
+MotifCounts MotifCompositionCounter::motifCounts() const
+{
+    MotifCounts motifCounts;
+    for (size_t classIndex = 0; classIndex != counts_.size(); ++classIndex)
+    {
+        if (counts_[classIndex] != 0)
+        {
+            const string motif = decodePackedMotif(rotationTables_->classMinRotations[classIndex], motifLength_);
+            motifCounts.emplace_back(motif, counts_[classIndex]);
+        }
+    }
+
+    // Classes were visited in lexicographic order of their motifs, so a stable sort keeps ties in that order
+    std::stable_sort(
+        motifCounts.begin(), motifCounts.end(),
+        [](const MotifCounts::value_type& motif1, const MotifCounts::value_type& motif2)
+        { return motif1.second > motif2.second; });
+
+    return motifCounts;
+}
+
+}
@@ -0,0 +1,98 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+/// \file
+///
+/// \brief Locus-generic motif composition of repeat tracts
+///
+/// Motifs are handled in a 2-bit packed form in which A, C, G and T are encoded as 0-3 and the first base occupies the
+/// most significant bits, so that the numerical order of packed motifs of the same length matches their lexicographic
+/// order.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "graphalign/GraphAlignment.hh"
+#include "graphcore/Graph.hh"
+
+namespace ehunter
+{
+
+/// Motifs together with the number of times each of them was observed
+using MotifCounts = std::vector<std::pair<std::string, int>>;
+
+/// Longest motif supported by the motif composition analysis
+const int kMaxCompositionMotifLength = 8;
+
+/// \brief Rotations of all packed motifs of one length
+///
+/// Motifs that are rotations of each other form a rotation class. Classes are numbered in increasing order of their
+/// lexicographically minimal rotations.
+///
+struct MotifRotationTables
+{
+    /// Minimal rotation of each packed motif
+    std::vector<uint16_t> minRotations;
+    /// Index of the rotation class of each packed motif
+    std::vector<uint16_t> classIndexes;
+    /// Minimal rotation of each rotation class
+    std::vector<uint16_t> classMinRotations;
+};
+
+/// \brief Return the rotation tables of the motifs of the given length
+///
+/// The tables are built once per process on first use; thread safe
+///
+const MotifRotationTables& getMotifRotationTables(int motifLength);
+
+/// Decode a packed motif of the given length
+std::string decodePackedMotif(uint32_t packedMotif, int motifLength);
+
+/// \brief Counts the repeat motifs of reads aligned to a repeat node
+///
+/// Each visit of a read alignment to the repeat node that covers a full repeat unit without gaps or clipping
+/// contributes one observation of the minimal rotation of the read bases aligned to it. Units containing low-quality
+/// (lowercase) or ambiguous bases are not counted.
+///
+class MotifCompositionCounter
+{
+public:
+    /// \param[in] motifLength Length of the repeat unit; must not exceed kMaxCompositionMotifLength
+    MotifCompositionCounter(graphtools::NodeId repeatNodeId, int motifLength);
+
+    /// \param[in] read Read sequence in the orientation of its alignment
+    void addRead(const std::string& read, const graphtools::GraphAlignment& alignment);
+
+    /// Observed motifs ordered by decreasing count and then lexicographically
+    MotifCounts motifCounts() const;
+
+private:
+    graphtools::NodeId repeatNodeId_;
+    int motifLength_;
+    const MotifRotationTables* rotationTables_;
+
+    // Counts indexed by rotation class
+    std::vector<int> counts_;
+};
+
+}
@@ -0,0 +1,88 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "locus/MotifComposition.hh"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "graphalign/GraphAlignmentOperations.hh"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+#include "locus/RFC1MotifAnalysisUtil.hh"
+
+using graphtools::decodeGraphAlignment;
+using graphtools::Graph;
+using std::string;
+
+using namespace ehunter;
+
+TEST(CanonicalizingMotifs, AllMotifsUpToLength6_SameRotationAsStringImplementation)
+{
+    for (int motifLength = 1; motifLength <= 6; ++motifLength)
+    {
+        const auto& tables = getMotifRotationTables(motifLength);
+        ASSERT_EQ(1ul << (2 * motifLength), tables.minRotations.size());
+        for (uint32_t packedMotif = 0; packedMotif != tables.minRotations.size(); ++packedMotif)
+        {
+            const string motif = decodePackedMotif(packedMotif, motifLength);
+            ASSERT_EQ(getMinRotation(motif), decodePackedMotif(tables.minRotations[packedMotif], motifLength)) << motif;
+            ASSERT_EQ(
+                tables.minRotations[packedMotif], tables.classMinRotations[tables.classIndexes[packedMotif]])
+                << motif;
+        }
+        EXPECT_TRUE(std::is_sorted(tables.classMinRotations.begin(), tables.classMinRotations.end()));
+    }
+}
+
+TEST(CanonicalizingMotifs, UnsupportedMotifLength_ExceptionThrown)
+{
+    EXPECT_ANY_THROW(getMotifRotationTables(0));
+    EXPECT_ANY_THROW(getMotifRotationTables(kMaxCompositionMotifLength + 1));
+}
+
+TEST(CountingMotifs, ReadsAlignedToRepeat_FullHighQualityUnitsCounted)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(AAAAG)*ATGTCG"));
+    MotifCompositionCounter counter(1, 5);
+    EXPECT_TRUE(counter.motifCounts().empty());
+
+    // Units: a reference unit, a pathogenic unit, a low-quality unit, a rotated reference unit, and a unit with an
+    // insertion
+    const string read = "TCGA" "AAAAG" "GGGAA" "aaaag" "AAGAA" "AAAAGT" "ATG";
+    const auto alignment = decodeGraphAlignment(2, "0[4M]1[5M]1[5M]1[5M]1[5M]1[2M1I3M]2[3M]", &graph);
+    counter.addRead(read, alignment);
+
+    const MotifCounts expectedCounts = { { "AAAAG", 2 }, { "AAGGG", 1 } };
+    EXPECT_EQ(expectedCounts, counter.motifCounts());
+}
+
+TEST(CountingMotifs, PartialUnitsAtReadEnds_NotCounted)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(AAAAG)*ATGTCG"));
+    MotifCompositionCounter counter(1, 5);
+
+    counter.addRead("AAG" "ACGGG" "AA", decodeGraphAlignment(2, "1[3M]1[5M]1[2M]", &graph));
+    counter.addRead("AAAGG" "AAG", decodeGraphAlignment(0, "1[5M]1[3M]", &graph));
+
+    const MotifCounts expectedCounts = { { "AAAGG", 1 }, { "ACGGG", 1 } };
+    EXPECT_EQ(expectedCounts, counter.motifCounts());
+}
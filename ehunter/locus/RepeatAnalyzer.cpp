@@ -50,21 +50,50 @@ using std::string;
 using std::unique_ptr;
 using std::vector;
 
+void RepeatAnalyzer::enableMotifComposition()
+{
+    if (!motifCompositionCounter_)
+    {
+        motifCompositionCounter_ = MotifCompositionCounter(repeatNodeId(), repeatUnit_.length());
+    }
+}
+
 void RepeatAnalyzer::processMates(
-    const Read& /*read*/, const GraphAlignment& readAlignment, const Read& /*mate*/,
-    const GraphAlignment& mateAlignment)
+    const Read& read, const GraphAlignment& readAlignment, const AlignmentSummary& readSummary, const Read& mate,
+    const GraphAlignment& mateAlignment, const AlignmentSummary& mateSummary)
 {
-    alignMatrix_.add(readAlignment, mateAlignment);
-    alignmentStatsCalculator_.inspect(readAlignment);
-    alignmentStatsCalculator_.inspect(mateAlignment);
+    alignMatrix_.add(readAlignment, readSummary, mateAlignment, mateSummary);
+    alignmentStatsCalculator_.inspect(readSummary);
+    alignmentStatsCalculator_.inspect(mateSummary);
+
+    if (motifCompositionCounter_)
+    {
+        motifCompositionCounter_->addRead(read.sequence(), readAlignment);
+        motifCompositionCounter_->addRead(mate.sequence(), mateAlignment);
+    }
 }
 
 unique_ptr<VariantFindings> RepeatAnalyzer::analyze(const LocusStats& stats)
+{
+    auto findings = genotypeRepeat(stats);
+    if (motifCompositionCounter_)
+    {
+        findings->setMotifComposition(motifCompositionCounter_->motifCounts());
+    }
+    return findings;
+}
+
+unique_ptr<RepeatFindings> RepeatAnalyzer::makeLowDepthFindings(AlleleCount alleleCount)
+{
+    return make_unique<RepeatFindings>(
+        CountTable(), CountTable(), CountTable(), alleleCount, boost::none, GenotypeFilter::kLowDepth);
+}
+
+unique_ptr<RepeatFindings> RepeatAnalyzer::genotypeRepeat(const LocusStats& stats)
 {
     if (isLowDepth(stats))
     {
-        return make_unique<RepeatFindings>(
-            CountTable(), CountTable(), CountTable(), stats.alleleCount(), boost::none, GenotypeFilter::kLowDepth);
+        return makeLowDepthFindings(stats.alleleCount());
     }
 
     auto genotypeFilter = GenotypeFilter();
@@ -35,6 +35,7 @@
 #include "core/Read.hh"
 #include "genotyping/AlignMatrix.hh"
 #include "genotyping/RepeatGenotype.hh"
+#include "locus/MotifComposition.hh"
 #include "locus/VariantAnalyzer.hh"
 
 namespace ehunter
@@ -59,20 +60,29 @@ public:
     const std::string& repeatUnit() const { return repeatUnit_; }
     void addInrepeatReadPair() { countOfInrepeatReadPairs_++; }
 
+    /// Report the motif composition of the repeat; the repeat unit must not exceed kMaxCompositionMotifLength
+    void enableMotifComposition();
+
     void processMates(
-        const Read& read, const graphtools::GraphAlignment& readAlignment, const Read& mate,
-        const graphtools::GraphAlignment& mateAlignment) override;
+        const Read& read, const graphtools::GraphAlignment& readAlignment, const AlignmentSummary& readSummary,
+        const Read& mate, const graphtools::GraphAlignment& mateAlignment,
+        const AlignmentSummary& mateSummary) override;
 
     std::unique_ptr<VariantFindings> analyze(const LocusStats& stats) override;
 
+    /// Findings of a repeat without enough reads to be genotyped
+    static std::unique_ptr<RepeatFindings> makeLowDepthFindings(AlleleCount alleleCount);
+
 private:
     graphtools::NodeId repeatNodeId() const { return nodeIds_.front(); }
+    std::unique_ptr<RepeatFindings> genotypeRepeat(const LocusStats& stats);
 
     const std::string repeatUnit_;
     GraphVariantAlignmentStatsCalculator alignmentStatsCalculator_;
 
     int countOfInrepeatReadPairs_;
     strgt::AlignMatrix alignMatrix_;
+    boost::optional<MotifCompositionCounter> motifCompositionCounter_;
 };
 
 }
@@ -36,14 +36,14 @@ namespace ehunter
 {
 
 void SmallVariantAnalyzer::processMates(
-    const Read& /*read*/, const graphtools::GraphAlignment& readAlignment, const Read& /*mate*/,
-    const graphtools::GraphAlignment& mateAlignment)
+    const Read& /*read*/, const graphtools::GraphAlignment& /*readAlignment*/, const AlignmentSummary& readSummary,
+    const Read& /*mate*/, const graphtools::GraphAlignment& /*mateAlignment*/, const AlignmentSummary& mateSummary)
 {
-    alignmentStatsCalculator_.inspect(readAlignment);
-    alignmentStatsCalculator_.inspect(mateAlignment);
+    alignmentStatsCalculator_.inspect(readSummary);
+    alignmentStatsCalculator_.inspect(mateSummary);
 
-    alignmentClassifier_.classify(readAlignment);
-    alignmentClassifier_.classify(mateAlignment);
+    alignmentClassifier_.classify(readSummary);
+    alignmentClassifier_.classify(mateSummary);
 }
 
 int SmallVariantAnalyzer::countReadsSupportingNode(graphtools::NodeId nodeId) const
@@ -64,14 +64,19 @@ int SmallVariantAnalyzer::countReadsSupportingNode(graphtools::NodeId nodeId) co
     return (numReadsSupportingUpstreamFlank + numReadsSupportingDownstreamFlank) / 2;
 }
 
+std::unique_ptr<SmallVariantFindings> SmallVariantAnalyzer::makeLowDepthFindings(AlleleCount alleleCount)
+{
+    auto refStatus = AlleleCheckSummary(AlleleStatus::kUncertain, 0);
+    auto altStatus = AlleleCheckSummary(AlleleStatus::kUncertain, 0);
+    return make_unique<SmallVariantFindings>(
+        0, 0, refStatus, altStatus, alleleCount, boost::none, GenotypeFilter::kLowDepth);
+}
+
 std::unique_ptr<VariantFindings> SmallVariantAnalyzer::analyze(const LocusStats& stats)
 {
     if (isLowDepth(stats))
     {
-        auto refStatus = AlleleCheckSummary(AlleleStatus::kUncertain, 0);
-        auto altStatus = AlleleCheckSummary(AlleleStatus::kUncertain, 0);
-        return make_unique<SmallVariantFindings>(
-            0, 0, refStatus, altStatus, stats.alleleCount(), boost::none, GenotypeFilter::kLowDepth);
+        return makeLowDepthFindings(stats.alleleCount());
     }
 
     NodeId refNode = optionalRefNode_ ? *optionalRefNode_ : ClassifierOfAlignmentsToVariant::kInvalidNodeId;
@@ -57,9 +57,13 @@ public:
 
     std::unique_ptr<VariantFindings> analyze(const LocusStats& stats) override;
 
+    /// Findings of a small variant without enough reads to be genotyped
+    static std::unique_ptr<SmallVariantFindings> makeLowDepthFindings(AlleleCount alleleCount);
+
     void processMates(
-        const Read& read, const graphtools::GraphAlignment& readAlignment, const Read& mate,
-        const graphtools::GraphAlignment& mateAlignment) override;
+        const Read& read, const graphtools::GraphAlignment& readAlignment, const AlignmentSummary& readSummary,
+        const Read& mate, const graphtools::GraphAlignment& mateAlignment,
+        const AlignmentSummary& mateSummary) override;
 
 protected:
     int countReadsSupportingNode(graphtools::NodeId nodeId) const;
@@ -28,6 +28,7 @@
 #include "graphalign/GraphAlignment.hh"
 #include "graphcore/Graph.hh"
 
+#include "alignment/AlignmentSummary.hh"
 #include "core/Common.hh"
 #include "core/LocusStats.hh"
 #include "core/Parameters.hh"
@@ -51,9 +52,10 @@ public:
     }
     virtual ~VariantAnalyzer() = default;
 
+    /// The summaries must describe the corresponding alignments
     virtual void processMates(
-        const Read& read, const graphtools::GraphAlignment& readAlignment, const Read& mate,
-        const graphtools::GraphAlignment& mateAlignment)
+        const Read& read, const graphtools::GraphAlignment& readAlignment, const AlignmentSummary& readSummary,
+        const Read& mate, const graphtools::GraphAlignment& mateAlignment, const AlignmentSummary& mateSummary)
         = 0;
 
     bool isLowDepth(const LocusStats& stats) const;
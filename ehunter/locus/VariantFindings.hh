@@ -30,6 +30,7 @@
 #include "genotyping/AlleleChecker.hh"
 #include "genotyping/RepeatGenotype.hh"
 #include "genotyping/SmallVariantGenotype.hh"
+#include "locus/MotifComposition.hh"
 #include "locus/RFC1Status.hh"
 
 namespace ehunter
@@ -90,6 +91,9 @@ public:
 
     boost::optional<RFC1Status> getRFC1Status() const { return rfc1Status_; }
 
+    void setMotifComposition(MotifCounts motifComposition) { motifComposition_ = std::move(motifComposition); }
+    const boost::optional<MotifCounts>& motifComposition() const { return motifComposition_; }
+
     bool operator==(const RepeatFindings& other) const
     {
         return countsOfSpanningReads_ == other.countsOfSpanningReads_
@@ -105,6 +109,7 @@ private:
     boost::optional<RepeatGenotype> optionalGenotype_;
     GenotypeFilter genotypeFilter_;
     boost::optional<RFC1Status> rfc1Status_;
+    boost::optional<MotifCounts> motifComposition_;
 };
 
 class SmallVariantFindings : public VariantFindings
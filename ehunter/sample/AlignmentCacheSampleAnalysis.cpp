@@ -0,0 +1,225 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/AlignmentCacheSampleAnalysis.hh"
+
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+using ehunter::locus::LocusAnalyzer;
+using std::string;
+
+namespace ehunter
+{
+
+namespace
+{
+
+/// \brief Mutable data shared by all worker threads
+///
+class LocusThreadSharedData
+{
+public:
+    LocusThreadSharedData()
+        : isWorkerThreadException(false)
+        , locusIndex(0)
+        , cachedLocusCount(0)
+    {
+    }
+
+    std::atomic<bool> isWorkerThreadException;
+    std::atomic<unsigned> locusIndex;
+    std::atomic<unsigned> cachedLocusCount;
+};
+
+/// \brief Data isolated to each locus-processing thread
+///
+struct LocusThreadLocalData
+{
+    std::exception_ptr threadExceptionPtr = nullptr;
+};
+
+/// \brief Process a series of loci on one thread
+///
+void processLocus(
+    const int threadIndex, const string& alignmentCachePath, const AlignmentCacheKeys& locusKeys, const Sex sampleSex,
+    const HeuristicParameters& heuristicParams, const RegionCatalog& regionCatalog,
+    locus::AlignWriterPtr alignmentWriter, const IndexDepthEstimate* depthEstimate, SampleFindings& sampleFindings,
+    LocusThreadSharedData& locusThreadSharedData, std::vector<LocusThreadLocalData>& locusThreadLocalDataPool)
+{
+    LocusThreadLocalData& locusThreadData(locusThreadLocalDataPool[threadIndex]);
+    std::string locusId = "Unknown";
+
+    try
+    {
+        AlignmentCacheReader cacheReader(alignmentCachePath);
+
+        const unsigned size(regionCatalog.size());
+        while (true)
+        {
+            if (locusThreadSharedData.isWorkerThreadException.load())
+            {
+                return;
+            }
+            const auto locusIndex(locusThreadSharedData.locusIndex.fetch_add(1));
+            if (locusIndex >= size)
+            {
+                return;
+            }
+
+            const auto& locusSpec(regionCatalog[locusIndex]);
+            locusId = locusSpec.locusId();
+
+            if (cacheReader.contains(locusId) && !cacheReader.contains(locusId, locusKeys.at(locusId)))
+            {
+                throw std::runtime_error(
+                    "Alignment cache record of locus " + locusId
+                    + " was written for a different locus structure, alignment settings, or program version; "
+                      "rebuild the cache with --write-alignment-cache");
+            }
+
+            LocusAnalyzer locusAnalyzer(locusSpec, heuristicParams, alignmentWriter);
+            const auto record = cacheReader.read(locusId, locusAnalyzer.locusSpec().regionGraph());
+            if (record)
+            {
+                locusAnalyzer.processAlignmentRecord(*record);
+                ++locusThreadSharedData.cachedLocusCount;
+            }
+            else
+            {
+                spdlog::warn("Locus {} is missing from the alignment cache", locusId);
+            }
+
+            sampleFindings[locusIndex]
+                = locusAnalyzer.analyze(sampleSex, getIndexBasedLocusDepth(depthEstimate, locusSpec));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        locusThreadSharedData.isWorkerThreadException = true;
+        locusThreadData.threadExceptionPtr = std::current_exception();
+
+        spdlog::error("Exception caught in thread {} while processing locus: {} : {}", threadIndex, locusId, e.what());
+        throw;
+    }
+    catch (...)
+    {
+        locusThreadSharedData.isWorkerThreadException = true;
+        locusThreadData.threadExceptionPtr = std::current_exception();
+
+        spdlog::error("Unknown exception caught in thread {} while processing locus: {}", threadIndex, locusId);
+        throw;
+    }
+}
+}
+
+AlignmentCacheKeys computeAlignmentCacheKeys(const RegionCatalog& regionCatalog, const uint64_t alignmentSettingsHash)
+{
+    AlignmentCacheKeys locusKeys;
+    for (const auto& locusSpec : regionCatalog)
+    {
+        std::ostringstream key;
+        key << std::hex << locusSpec.contentHash() << '-' << alignmentSettingsHash;
+        locusKeys.emplace(locusSpec.locusId(), key.str());
+    }
+    return locusKeys;
+}
+
+string describeAlignmentCacheKeyChange(const string& cachedKey, const string& currentKey)
+{
+    // Keys consist of the locus definition hash and the alignment settings hash separated by a dash
+    const auto splitKey = [](const string& key)
+    {
+        const size_t separatorPos = key.find('-');
+        return separatorPos == string::npos
+            ? std::make_pair(key, string())
+            : std::make_pair(key.substr(0, separatorPos), key.substr(separatorPos + 1));
+    };
+
+    const auto cachedParts = splitKey(cachedKey);
+    const auto currentParts = splitKey(currentKey);
+    const bool isDefinitionChanged = cachedParts.first != currentParts.first;
+    const bool areSettingsChanged = cachedParts.second != currentParts.second;
+    if (isDefinitionChanged && areSettingsChanged)
+    {
+        return "locus definition and alignment settings or program version changed";
+    }
+    if (isDefinitionChanged)
+    {
+        return "locus definition changed";
+    }
+    if (areSettingsChanged)
+    {
+        return "alignment settings or program version changed";
+    }
+    return "unchanged";
+}
+
+SampleFindings alignmentCacheSampleAnalysis(
+    const string& alignmentCachePath, const AlignmentCacheKeys& locusKeys, Sex sampleSex,
+    const HeuristicParameters& heuristicParams, const int threadCount, const RegionCatalog& regionCatalog,
+    locus::AlignWriterPtr alignmentWriter, const IndexDepthEstimate* depthEstimate)
+{
+    LocusThreadSharedData locusThreadSharedData;
+    std::vector<LocusThreadLocalData> locusThreadLocalDataPool(threadCount);
+
+    const unsigned locusCount(regionCatalog.size());
+    SampleFindings sampleFindings(locusCount);
+
+    // Start all locus worker threads
+    std::vector<std::thread> locusThreads;
+    for (int threadIndex(0); threadIndex < threadCount; ++threadIndex)
+    {
+        locusThreads.emplace_back(
+            processLocus, threadIndex, std::cref(alignmentCachePath), std::cref(locusKeys), sampleSex,
+            std::cref(heuristicParams), std::cref(regionCatalog), alignmentWriter, depthEstimate,
+            std::ref(sampleFindings), std::ref(locusThreadSharedData), std::ref(locusThreadLocalDataPool));
+    }
+
+    for (int threadIndex(0); threadIndex < threadCount; ++threadIndex)
+    {
+        locusThreads[threadIndex].join();
+    }
+
+    // Rethrow exceptions from worker pool in thread order:
+    if (locusThreadSharedData.isWorkerThreadException.load())
+    {
+        for (int threadIndex(0); threadIndex < threadCount; ++threadIndex)
+        {
+            const auto& locusThreadData(locusThreadLocalDataPool[threadIndex]);
+            if (locusThreadData.threadExceptionPtr)
+            {
+                std::rethrow_exception(locusThreadData.threadExceptionPtr);
+            }
+        }
+    }
+
+    spdlog::info(
+        "Loaded {} of {} loci from the alignment cache", locusThreadSharedData.cachedLocusCount.load(), locusCount);
+
+    return sampleFindings;
+}
+
+}
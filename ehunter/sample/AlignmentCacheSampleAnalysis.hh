@@ -0,0 +1,60 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "core/Parameters.hh"
+#include "io/AlignmentCache.hh"
+#include "locus/LocusAnalyzer.hh"
+#include "locus/LocusFindings.hh"
+#include "locus/LocusSpecification.hh"
+#include "sample/IndexBasedDepthEstimate.hh"
+
+namespace ehunter
+{
+
+/// \brief Compute the alignment cache keys of all loci
+///
+/// A key combines the hash of the alignment-relevant part of the locus definition with the given hash of the settings
+/// affecting read alignment. Genotyping parameters do not enter the key, so a cache can be re-genotyped with different
+/// genotyping parameters.
+///
+AlignmentCacheKeys computeAlignmentCacheKeys(const RegionCatalog& regionCatalog, uint64_t alignmentSettingsHash);
+
+/// Describe which inputs of a cached record changed given the key it was stored with and the current key of its locus
+std::string describeAlignmentCacheKeyChange(const std::string& cachedKey, const std::string& currentKey);
+
+/// \brief Genotype all loci from read alignments stored in an alignment cache instead of an alignment file
+///
+/// Loci missing from the cache are analyzed as if no reads were found for them. A locus whose record was stored with a
+/// key other than its expected key is an error, since its cached alignments may not match the current locus graph or
+/// alignment settings; changed genotyping parameters do not change the key.
+///
+/// \param[in] locusKeys Expected alignment cache keys of all loci in the catalog
+/// \param[in] depthEstimate Index-based depth applied to each locus (see LocusAnalyzer::analyze); ignored if null
+///
+SampleFindings alignmentCacheSampleAnalysis(
+    const std::string& alignmentCachePath, const AlignmentCacheKeys& locusKeys, Sex sampleSex,
+    const HeuristicParameters& heuristicParams, int threadCount, const RegionCatalog& regionCatalog,
+    locus::AlignWriterPtr alignmentWriter, const IndexDepthEstimate* depthEstimate = nullptr);
+
+}
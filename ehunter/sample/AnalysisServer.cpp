@@ -0,0 +1,302 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/AnalysisServer.hh"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include "spdlog/spdlog.h"
+#include "thirdparty/json/json.hpp"
+
+#include "core/ConcurrentQueue.hh"
+#include "io/ParameterLoading.hh"
+#include "io/SampleStats.hh"
+#include "io/VariantRecordTemplates.hh"
+#include "sample/SampleAnalysis.hh"
+
+using Json = nlohmann::json;
+using std::string;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Bounds the number of requests read ahead of the running job; the reader blocks once the queue is full
+const std::size_t kMaxQueuedRequests = 16;
+
+struct QueuedRequest
+{
+    string encoding;
+    Clock::time_point receiptTime;
+    bool isEndOfInput;
+};
+
+string getOptionalField(const Json& request, const string& fieldName, const string& defaultValue)
+{
+    if (!request.contains(fieldName))
+    {
+        return defaultValue;
+    }
+    if (!request[fieldName].is_string())
+    {
+        throw std::invalid_argument("Field " + fieldName + " of job request must be a string");
+    }
+    return request[fieldName].get<string>();
+}
+
+AnalysisMode decodeJobAnalysisMode(const string& encoding)
+{
+    if (encoding == "seeking")
+    {
+        return AnalysisMode::kSeeking;
+    }
+    else if (encoding == "streaming")
+    {
+        return AnalysisMode::kStreaming;
+    }
+    else
+    {
+        throw std::invalid_argument("Analysis mode of a job must be set to either seeking or streaming");
+    }
+}
+
+string encodeAnalysisMode(AnalysisMode analysisMode)
+{
+    switch (analysisMode)
+    {
+    case AnalysisMode::kSeeking:
+        return "seeking";
+    case AnalysisMode::kStreaming:
+        return "streaming";
+    case AnalysisMode::kExtract:
+        return "extract";
+    }
+
+    throw std::logic_error("Encountered unknown analysis mode");
+}
+
+// Catalog coordinates are contig indexes of the reference, so each sample must list the same contigs in the same order
+void assertCompatibleContigs(const ReferenceContigInfo& referenceContigInfo, const string& htsFilePath)
+{
+    const ReferenceContigInfo sampleContigInfo = extractReferenceContigInfo(htsFilePath);
+    bool isCompatible = sampleContigInfo.numContigs() == referenceContigInfo.numContigs();
+    for (int32_t contigIndex(0); isCompatible && contigIndex < sampleContigInfo.numContigs(); ++contigIndex)
+    {
+        isCompatible = sampleContigInfo.getContigName(contigIndex) == referenceContigInfo.getContigName(contigIndex)
+            && sampleContigInfo.getContigSize(contigIndex) == referenceContigInfo.getContigSize(contigIndex);
+    }
+
+    if (!isCompatible)
+    {
+        throw std::invalid_argument(
+            "Contigs of " + htsFilePath + " do not match the contigs of the alignment file used to start the server");
+    }
+}
+
+double getSecondsBetween(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+
+Json runJob(
+    const QueuedRequest& request, const ProgramParameters& serverParams, FastaReference& reference,
+    const RegionCatalog& regionCatalog, const VariantRecordTemplates& recordTemplates)
+{
+    const auto startTime = Clock::now();
+    Json response;
+    response["Id"] = nullptr;
+    response["QueueSeconds"] = getSecondsBetween(request.receiptTime, startTime);
+
+    try
+    {
+        const ServerJob job = decodeServerJob(request.encoding, serverParams);
+        response["Id"] = job.id;
+
+        const RegionCatalog jobCatalog = selectLoci(regionCatalog, job.locusIds);
+        assertCompatibleContigs(reference.contigInfo(), job.params.inputPaths().htsFile());
+
+        spdlog::info("Running job {} on sample {}", job.id, job.params.sample().id());
+        // Locus analyzers are built for this job only; the reference, catalog, and record templates are reused
+        analyzeSample(job.params, reference, jobCatalog, nullptr, &recordTemplates);
+
+        const double runSeconds = getSecondsBetween(startTime, Clock::now());
+        response["Status"] = "Success";
+        response["LocusCount"] = jobCatalog.size();
+        response["RunSeconds"] = runSeconds;
+        response["LociPerSecond"] = runSeconds > 0 ? jobCatalog.size() / runSeconds : 0.0;
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("Job failed: {}", e.what());
+        response["Status"] = "Failure";
+        response["Message"] = e.what();
+        response["RunSeconds"] = getSecondsBetween(startTime, Clock::now());
+    }
+
+    return response;
+}
+
+}
+
+ServerJob decodeServerJob(const string& encoding, const ProgramParameters& serverParams)
+{
+    const Json request = Json::parse(encoding, nullptr, false);
+    if (request.is_discarded() || !request.is_object())
+    {
+        throw std::invalid_argument("Job request is not a JSON object: " + encoding);
+    }
+
+    if (!request.contains("Id") || !request["Id"].is_string())
+    {
+        throw std::invalid_argument("Job request must contain a string Id: " + encoding);
+    }
+    const string id = request["Id"].get<string>();
+
+    const InputPaths& serverInputPaths = serverParams.inputPaths();
+    const string htsFilePath = getOptionalField(request, "Reads", serverInputPaths.htsFile());
+    if (isStreamOnlyPath(htsFilePath))
+    {
+        throw std::invalid_argument("Server jobs cannot read alignments from the standard input or a named pipe");
+    }
+    const string defaultSexEncoding = serverParams.inferSampleSex
+        ? kInferredSexEncoding
+        : (serverParams.sample().sex() == Sex::kMale ? "male" : "female");
+    const string sexEncoding = getOptionalField(request, "Sex", defaultSexEncoding);
+    // The server output prefix is recovered from its VCF path, which is the prefix followed by ".vcf"
+    const string& serverVcfPath = serverParams.outputPaths().vcf();
+    const string defaultOutputPrefix = serverVcfPath.substr(0, serverVcfPath.size() - string(".vcf").size());
+    const string outputPrefix = getOptionalField(request, "OutputPrefix", defaultOutputPrefix + "_" + id);
+    const AnalysisMode analysisMode = decodeJobAnalysisMode(
+        getOptionalField(request, "AnalysisMode", encodeAnalysisMode(serverParams.analysisMode())));
+
+    vector<string> locusIds;
+    if (request.contains("LocusIds"))
+    {
+        if (!request["LocusIds"].is_array())
+        {
+            throw std::invalid_argument("LocusIds of job request must be a list of strings");
+        }
+        for (const auto& locusId : request["LocusIds"])
+        {
+            if (!locusId.is_string())
+            {
+                throw std::invalid_argument("LocusIds of job request must be a list of strings");
+            }
+            locusIds.push_back(locusId.get<string>());
+        }
+    }
+
+    InputPaths inputPaths(htsFilePath, serverInputPaths.reference(), serverInputPaths.catalog());
+    ProgramParameters jobParams(
+        inputPaths, makeOutputPaths(outputPrefix), makeSampleParameters(htsFilePath, sexEncoding),
+        serverParams.heuristics(), analysisMode, serverParams.logLevel(), serverParams.threadCount,
+        serverParams.disableBamletOutput, serverParams.writeAlignmentCache, false);
+    jobParams.depthSource = serverParams.depthSource;
+    jobParams.inferSampleSex = sexEncoding == kInferredSexEncoding;
+    jobParams.pinThreads = serverParams.pinThreads;
+    jobParams.prefetchLoci = serverParams.prefetchLoci;
+
+    return { id, std::move(jobParams), std::move(locusIds) };
+}
+
+RegionCatalog selectLoci(const RegionCatalog& regionCatalog, const vector<string>& locusIds)
+{
+    if (locusIds.empty())
+    {
+        return regionCatalog;
+    }
+
+    std::unordered_map<string, bool> isLocusFound;
+    for (const auto& locusId : locusIds)
+    {
+        isLocusFound[locusId] = false;
+    }
+
+    RegionCatalog selectedLoci;
+    for (const auto& locusSpec : regionCatalog)
+    {
+        auto locusIterator = isLocusFound.find(locusSpec.locusId());
+        if (locusIterator != isLocusFound.end())
+        {
+            locusIterator->second = true;
+            selectedLoci.push_back(locusSpec);
+        }
+    }
+
+    for (const auto& locusIdAndStatus : isLocusFound)
+    {
+        if (!locusIdAndStatus.second)
+        {
+            throw std::invalid_argument("Locus " + locusIdAndStatus.first + " is not present in the catalog");
+        }
+    }
+
+    return selectedLoci;
+}
+
+void runAnalysisServer(
+    const ProgramParameters& serverParams, FastaReference& reference, const RegionCatalog& regionCatalog,
+    std::istream& requests, std::ostream& responses)
+{
+    ConcurrentQueue<QueuedRequest> requestQueue(kMaxQueuedRequests);
+
+    std::thread requestReader(
+        [&]()
+        {
+            string line;
+            while (std::getline(requests, line))
+            {
+                if (line.find_first_not_of(" \t\r") != string::npos)
+                {
+                    requestQueue.push({ line, Clock::now(), false });
+                }
+            }
+            requestQueue.push({ "", Clock::now(), true });
+        });
+
+    // Output records of the catalog are rendered once and shared by all jobs
+    const VariantRecordTemplates recordTemplates(reference, regionCatalog);
+
+    spdlog::info("Server is ready to accept jobs");
+    while (true)
+    {
+        QueuedRequest request;
+        requestQueue.pop(request);
+        if (request.isEndOfInput)
+        {
+            break;
+        }
+
+        const Json response = runJob(request, serverParams, reference, regionCatalog, recordTemplates);
+        responses << response.dump() << std::endl;
+    }
+
+    requestReader.join();
+    spdlog::info("Server input is exhausted; shutting down");
+}
+
+}
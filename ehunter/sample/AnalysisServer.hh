@@ -0,0 +1,71 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/Parameters.hh"
+#include "core/Reference.hh"
+#include "locus/LocusSpecification.hh"
+
+namespace ehunter
+{
+
+// In server mode, each line of the input is a JSON job request such as
+//
+//   {"Id": "job1", "Reads": "sample.bam", "Sex": "male", "OutputPrefix": "sample", "LocusIds": ["HTT"]}
+//
+// where all fields except "Id" are optional and default to the values given on the command line of the server
+// ("OutputPrefix" defaults to the server prefix followed by "_<Id>" and "LocusIds" defaults to the whole catalog).
+// "AnalysisMode" may be set to either seeking or streaming and defaults to the mode of the server, which cannot be
+// started in extract mode. A JSON line describing the outcome, the time the job spent in the queue, and the analysis
+// throughput is written to the output once the job is finished.
+//
+// The reference, the catalog (including the locus graphs), and the output record templates are shared by all jobs.
+// Locus analyzers and their aligners hold per-sample state and are built anew for each job.
+
+struct ServerJob
+{
+    std::string id;
+    ProgramParameters params;
+    std::vector<std::string> locusIds;
+};
+
+/// \brief Decode a job request
+///
+/// \param[in] serverParams Parameters of the server providing the defaults for fields missing from the request
+///
+ServerJob decodeServerJob(const std::string& encoding, const ProgramParameters& serverParams);
+
+/// Loci of the catalog with the given ids in catalog order; an empty list of ids selects the whole catalog
+RegionCatalog selectLoci(const RegionCatalog& regionCatalog, const std::vector<std::string>& locusIds);
+
+/// \brief Run job requests read from the input against the loaded reference and catalog
+///
+/// Jobs are queued as they are read and run one at a time in the order they were received; the function returns
+/// once the input is exhausted and all queued jobs are finished
+///
+void runAnalysisServer(
+    const ProgramParameters& serverParams, FastaReference& reference, const RegionCatalog& regionCatalog,
+    std::istream& requests, std::ostream& responses);
+
+}
@@ -0,0 +1,197 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/AnalysisSession.hh"
+
+#include <stdexcept>
+#include <utility>
+
+#include "core/HtsHelpers.hh"
+
+using ehunter::locus::LocusAnalyzer;
+using graphtools::AlignerSelector;
+using std::vector;
+
+namespace ehunter
+{
+
+AnalysisSession::AnalysisSession(
+    const RegionCatalog& regionCatalog, const HeuristicParameters& heuristicParams, Sex sampleSex,
+    locus::AlignWriterPtr alignmentWriter)
+    : regionCatalog_(regionCatalog)
+    , heuristicParams_(heuristicParams)
+    , sampleSex_(sampleSex)
+    , alignmentWriter_(std::move(alignmentWriter))
+    , genomeQuery_(regionCatalog)
+    , locusMutexes_(regionCatalog.size())
+    , locusAnalyzers_(regionCatalog.size())
+    , numActiveAdds_(0)
+    , isFinished_(false)
+{
+}
+
+void AnalysisSession::addReadPair(
+    Read read, const LinearAlignmentStats& readStats, Read mate, const LinearAlignmentStats& mateStats)
+{
+    beginAddingReadPair(read.fragmentId());
+    try
+    {
+        dispatchReadPair(read, readStats, mate, mateStats);
+    }
+    catch (...)
+    {
+        endAddingReadPair();
+        throw;
+    }
+    endAddingReadPair();
+}
+
+void AnalysisSession::addReadPair(bam1_t* read, bam1_t* mate)
+{
+    addReadPair(
+        htshelpers::decodeRead(read), htshelpers::decodeAlignmentStats(read), htshelpers::decodeRead(mate),
+        htshelpers::decodeAlignmentStats(mate));
+}
+
+void AnalysisSession::beginAddingReadPair(const std::string& fragmentId)
+{
+    std::lock_guard<std::mutex> stateLock(stateMutex_);
+    if (isFinished_)
+    {
+        throw std::logic_error("Cannot add read pair " + fragmentId + " to a finished analysis session");
+    }
+    ++numActiveAdds_;
+}
+
+void AnalysisSession::endAddingReadPair()
+{
+    std::lock_guard<std::mutex> stateLock(stateMutex_);
+    --numActiveAdds_;
+    if (numActiveAdds_ == 0)
+    {
+        noActiveAddsCv_.notify_all();
+    }
+}
+
+void AnalysisSession::dispatchReadPair(
+    Read& read, const LinearAlignmentStats& readStats, Read& mate, const LinearAlignmentStats& mateStats)
+{
+    const bool isReadNearTargetRegion = genomeQuery_.targetRegionMask.query(readStats.chromId, readStats.pos);
+    const bool isMateNearTargetRegion = genomeQuery_.targetRegionMask.query(mateStats.chromId, mateStats.pos);
+    if (!isReadNearTargetRegion && !isMateNearTargetRegion)
+    {
+        return;
+    }
+
+    const int64_t readEnd = readStats.pos + read.sequence().length();
+    const int64_t mateEnd = mateStats.pos + mate.sequence().length();
+    const vector<AnalyzerBundle> analyzerBundles = genomeQuery_.analyzerFinder.query(
+        readStats.chromId, readStats.pos, readEnd, mateStats.chromId, mateStats.pos, mateEnd);
+    if (analyzerBundles.empty())
+    {
+        return;
+    }
+
+    std::unique_ptr<AlignerSelector> alignerSelector = acquireAlignerSelector();
+    auto processReadPair = [&](const AnalyzerBundle& bundle, Read& bundleRead, Read& bundleMate)
+    {
+        std::lock_guard<std::mutex> locusLock(locusMutexes_[bundle.locusIndex]);
+        auto& locusAnalyzer = locusAnalyzers_[bundle.locusIndex];
+        if (!locusAnalyzer)
+        {
+            locusAnalyzer.reset(
+                new LocusAnalyzer(regionCatalog_[bundle.locusIndex], heuristicParams_, alignmentWriter_));
+        }
+        processAnalyzerBundleReadPair(
+            *locusAnalyzer, bundle.regionType, bundle.inputType, bundleRead, bundleMate, *alignerSelector);
+    };
+
+    try
+    {
+        // Analyzers may modify the reads, so all but the last locus receive copies
+        const unsigned bundleCount(analyzerBundles.size());
+        for (unsigned bundleIndex(0); bundleIndex + 1 < bundleCount; ++bundleIndex)
+        {
+            Read readCopy(read);
+            Read mateCopy(mate);
+            processReadPair(analyzerBundles[bundleIndex], readCopy, mateCopy);
+        }
+        processReadPair(analyzerBundles.back(), read, mate);
+    }
+    catch (...)
+    {
+        releaseAlignerSelector(std::move(alignerSelector));
+        throw;
+    }
+    releaseAlignerSelector(std::move(alignerSelector));
+}
+
+void AnalysisSession::finish(const FindingsCallback& callback, boost::optional<double> genomeWideDepth)
+{
+    {
+        std::unique_lock<std::mutex> stateLock(stateMutex_);
+        if (isFinished_)
+        {
+            throw std::logic_error("Analysis session is already finished");
+        }
+        isFinished_ = true;
+        noActiveAddsCv_.wait(stateLock, [this] { return numActiveAdds_ == 0; });
+    }
+
+    for (unsigned locusIndex(0); locusIndex < regionCatalog_.size(); ++locusIndex)
+    {
+        std::unique_ptr<LocusAnalyzer> locusAnalyzer;
+        {
+            std::lock_guard<std::mutex> locusLock(locusMutexes_[locusIndex]);
+            locusAnalyzer = std::move(locusAnalyzers_[locusIndex]);
+        }
+
+        const auto& locusSpec = regionCatalog_[locusIndex];
+        const auto sampleDepth = locusSpec.requiresGenomeWideDepth() ? genomeWideDepth : boost::none;
+        if (locusAnalyzer)
+        {
+            callback(locusSpec, locusAnalyzer->analyze(sampleSex_, sampleDepth));
+        }
+        else
+        {
+            callback(locusSpec, LocusAnalyzer::analyzeWithoutReads(locusSpec, sampleSex_, sampleDepth));
+        }
+    }
+}
+
+std::unique_ptr<AlignerSelector> AnalysisSession::acquireAlignerSelector()
+{
+    std::lock_guard<std::mutex> selectorLock(alignerSelectorMutex_);
+    if (idleAlignerSelectors_.empty())
+    {
+        return std::unique_ptr<AlignerSelector>(new AlignerSelector(heuristicParams_.alignerType()));
+    }
+
+    std::unique_ptr<AlignerSelector> alignerSelector = std::move(idleAlignerSelectors_.back());
+    idleAlignerSelectors_.pop_back();
+    return alignerSelector;
+}
+
+void AnalysisSession::releaseAlignerSelector(std::unique_ptr<AlignerSelector> alignerSelector)
+{
+    std::lock_guard<std::mutex> selectorLock(alignerSelectorMutex_);
+    idleAlignerSelectors_.push_back(std::move(alignerSelector));
+}
+
+}
@@ -0,0 +1,120 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+extern "C"
+{
+#include "htslib/sam.h"
+}
+
+#include "graphalign/GappedAligner.hh"
+#include "graphio/AlignmentWriter.hh"
+
+#include "core/Parameters.hh"
+#include "core/Read.hh"
+#include "locus/LocusAnalyzer.hh"
+#include "locus/LocusFindings.hh"
+#include "locus/LocusSpecification.hh"
+#include "sample/GenomeQueryCollection.hh"
+
+namespace ehunter
+{
+
+/// \brief Analysis of a single sample from reads supplied by the caller
+///
+/// The session allows the genotyper to be embedded into applications that already hold decoded reads in memory. Read
+/// pairs are dispatched to the loci whose target or off-target regions contain them, exactly as in streaming mode, and
+/// the findings of all loci are delivered through a callback once the session is finished. No files are read or
+/// written unless the caller supplies an alignment writer.
+///
+/// Read pairs can be added from any number of threads concurrently. The catalog must outlive the session.
+///
+class AnalysisSession : private boost::noncopyable
+{
+public:
+    /// Receives the findings of a single locus
+    using FindingsCallback = std::function<void(const LocusSpecification& locusSpec, LocusFindings locusFindings)>;
+
+    /// \param[in] alignmentWriter Destination of graph alignments of the reads; alignments are discarded by default
+    AnalysisSession(
+        const RegionCatalog& regionCatalog, const HeuristicParameters& heuristicParams, Sex sampleSex,
+        locus::AlignWriterPtr alignmentWriter = std::make_shared<graphtools::BlankAlignmentWriter>());
+
+    /// \brief Add a read pair together with the linear alignments of both mates
+    ///
+    /// Reads are expected in their original sequencing orientation, as produced by htshelpers::decodeRead
+    ///
+    void addReadPair(
+        Read read, const LinearAlignmentStats& readStats, Read mate, const LinearAlignmentStats& mateStats);
+
+    /// Add a read pair from htslib records; only primary alignments should be supplied
+    void addReadPair(bam1_t* read, bam1_t* mate);
+
+    /// \brief Analyze all loci and report their findings in catalog order
+    ///
+    /// Read pairs that are being added when this is called are processed before any locus is analyzed. The session
+    /// cannot accept reads after it is finished.
+    ///
+    /// \param[in] genomeWideDepth Depth used for genotyping loci requiring genome-wide depth (such as SMN) in place of
+    /// the depth estimated from their reads; other loci do not use it
+    ///
+    void finish(const FindingsCallback& callback, boost::optional<double> genomeWideDepth = boost::none);
+
+private:
+    /// Register a read pair that is being added; throws if the session is finished
+    void beginAddingReadPair(const std::string& fragmentId);
+    void endAddingReadPair();
+    void dispatchReadPair(
+        Read& read, const LinearAlignmentStats& readStats, Read& mate, const LinearAlignmentStats& mateStats);
+
+    std::unique_ptr<graphtools::AlignerSelector> acquireAlignerSelector();
+    void releaseAlignerSelector(std::unique_ptr<graphtools::AlignerSelector> alignerSelector);
+
+    const RegionCatalog& regionCatalog_;
+    HeuristicParameters heuristicParams_;
+    Sex sampleSex_;
+    locus::AlignWriterPtr alignmentWriter_;
+    GenomeQueryCollection genomeQuery_;
+
+    // Each locus analyzer is constructed when the first read pair of its locus arrives and is guarded by its own mutex
+    std::vector<std::mutex> locusMutexes_;
+    std::vector<std::unique_ptr<locus::LocusAnalyzer>> locusAnalyzers_;
+
+    // Aligner selectors hold alignment buffers, so they are reused across calls instead of being built for each pair
+    std::mutex alignerSelectorMutex_;
+    std::vector<std::unique_ptr<graphtools::AlignerSelector>> idleAlignerSelectors_;
+
+    // Finishing the session waits for read pairs that are still being added so that none of them is lost
+    std::mutex stateMutex_;
+    std::condition_variable noActiveAddsCv_;
+    int numActiveAdds_;
+    bool isFinished_;
+};
+
+}
@@ -36,7 +36,6 @@ namespace
 {
 bool areMatesNearby(int32_t readContigId, int64_t readPosition, int32_t mateContigId, int64_t matePosition)
 {
-    const int kMaxMateDistance = 1000;
     return ((readContigId == mateContigId) && (std::abs(readPosition - matePosition) < kMaxMateDistance));
 }
 
@@ -178,16 +177,35 @@ void processAnalyzerBundleReadPair(
 }
 
 AnalyzerFinder::AnalyzerFinder(vector<unique_ptr<LocusAnalyzer>>& locusAnalyzers)
+{
+    vector<const LocusSpecification*> locusSpecs;
+    for (const auto& locusAnalyzer : locusAnalyzers)
+    {
+        locusSpecs.push_back(&locusAnalyzer->locusSpec());
+    }
+    initializeIntervalTrees(locusSpecs);
+}
+
+AnalyzerFinder::AnalyzerFinder(const RegionCatalog& regionCatalog)
+{
+    vector<const LocusSpecification*> locusSpecs;
+    for (const auto& locusSpec : regionCatalog)
+    {
+        locusSpecs.push_back(&locusSpec);
+    }
+    initializeIntervalTrees(locusSpecs);
+}
+
+void AnalyzerFinder::initializeIntervalTrees(const vector<const LocusSpecification*>& locusSpecs)
 {
     using IntervalWithLocusTypeAndAnalyzer = Interval<std::size_t, AnalyzerBundle>;
 
     unordered_map<int32_t, vector<IntervalWithLocusTypeAndAnalyzer>> contigToIntervals;
 
-    const unsigned locusAnalzerCount(locusAnalyzers.size());
+    const unsigned locusAnalzerCount(locusSpecs.size());
     for (unsigned locusAnalyzerIndex(0); locusAnalyzerIndex < locusAnalzerCount; ++locusAnalyzerIndex)
     {
-        const auto& locusAnalyzer(locusAnalyzers[locusAnalyzerIndex]);
-        const LocusSpecification& locusSpec = locusAnalyzer->locusSpec();
+        const LocusSpecification& locusSpec = *locusSpecs[locusAnalyzerIndex];
         for (const auto& region : locusSpec.targetReadExtractionRegions())
         {
             AnalyzerBundle bundle(RegionType::kTarget, locusAnalyzerIndex);
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -35,6 +36,9 @@
 namespace ehunter
 {
 
+// Mates on the same contig closer than this are dispatched to the analyzers of both mates together
+const int64_t kMaxMateDistance = 1000;
+
 // Specifies which mates should be processed with a given locus analyzer
 enum class AnalyzerInputType
 {
@@ -68,6 +72,9 @@ class AnalyzerFinder
 public:
     AnalyzerFinder(std::vector<std::unique_ptr<locus::LocusAnalyzer>>& locusAnalyzers);
 
+    // Enables lookup of analyzers which have not been constructed yet; bundles refer to indexes of \p regionCatalog
+    AnalyzerFinder(const RegionCatalog& regionCatalog);
+
     // Retrieves analyzers appropriate for the given read pair
     std::vector<AnalyzerBundle> query(
         int32_t readContigId, int64_t readStart, int64_t readEnd, int32_t mateContigId, int64_t mateStart,
@@ -80,6 +87,8 @@ private:
     using AnalyzerIntervalTree = IntervalTree<std::size_t, AnalyzerBundle>;
     using AnalyzerIntervalTrees = std::unordered_map<int32_t, AnalyzerIntervalTree>;
 
+    void initializeIntervalTrees(const std::vector<const LocusSpecification*>& locusSpecs);
+
     AnalyzerIntervalTrees intervalTrees_;
 };
 
@@ -21,21 +21,15 @@
 
 #include "sample/GenomeQueryCollection.hh"
 
-using ehunter::locus::LocusAnalyzer;
-using std::unique_ptr;
-using std::vector;
-
 namespace ehunter
 {
 
 namespace
 {
-void initializeGenomeMask(GenomeMask& genomeMask, vector<unique_ptr<locus::LocusAnalyzer>>& locusAnalyzers)
+void initializeGenomeMask(GenomeMask& genomeMask, const RegionCatalog& regionCatalog)
 {
-    for (auto& locusAnalyzer : locusAnalyzers)
+    for (const auto& locusSpec : regionCatalog)
     {
-        const LocusSpecification& locusSpec = locusAnalyzer->locusSpec();
-
         for (const auto& region : locusSpec.targetReadExtractionRegions())
         {
             genomeMask.addRegion(region.contigIndex(), region.start(), region.end());
@@ -49,10 +43,10 @@ void initializeGenomeMask(GenomeMask& genomeMask, vector<unique_ptr<locus::Locus
 }
 }
 
-GenomeQueryCollection::GenomeQueryCollection(vector<unique_ptr<LocusAnalyzer>>& locusAnalyzers)
-    : analyzerFinder(locusAnalyzers)
+GenomeQueryCollection::GenomeQueryCollection(const RegionCatalog& regionCatalog)
+    : analyzerFinder(regionCatalog)
 {
-    initializeGenomeMask(targetRegionMask, locusAnalyzers);
+    initializeGenomeMask(targetRegionMask, regionCatalog);
 }
 
 }
@@ -0,0 +1,157 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/HtsBlockPrefetcher.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "spdlog/spdlog.h"
+
+#include "core/Common.hh"
+
+using std::pair;
+using std::string;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace htshelpers
+{
+
+namespace
+{
+// BGZF blocks hold at most 64kb of compressed data
+const int64_t kMaxBgzfBlockSize = 65536;
+}
+
+vector<FileRange> computeBlockRanges(vector<pair<uint64_t, uint64_t>> chunks)
+{
+    std::sort(chunks.begin(), chunks.end());
+
+    vector<FileRange> ranges;
+    for (const auto& chunk : chunks)
+    {
+        // The upper 48 bits of a virtual offset are the file offset of the block
+        const int64_t rangeStart = static_cast<int64_t>(chunk.first >> 16);
+        const int64_t rangeEnd = static_cast<int64_t>(chunk.second >> 16) + kMaxBgzfBlockSize;
+        if (!ranges.empty() && rangeStart <= ranges.back().second)
+        {
+            ranges.back().second = std::max(ranges.back().second, rangeEnd);
+        }
+        else
+        {
+            ranges.emplace_back(rangeStart, rangeEnd);
+        }
+    }
+
+    return ranges;
+}
+
+HtsBlockPrefetcher::HtsBlockPrefetcher(const string& htsFilePath)
+{
+#ifdef __linux__
+    if (isURL(htsFilePath) || isStreamOnlyPath(htsFilePath))
+    {
+        return;
+    }
+
+    htsFilePtr_ = sam_open(htsFilePath.c_str(), "r");
+    if (!htsFilePtr_ || hts_get_format(htsFilePtr_)->format != bam)
+    {
+        spdlog::debug("Alignment file blocks of {} are not prefetched because it is not a BAM file", htsFilePath);
+        return;
+    }
+
+    htsIndexPtr_ = sam_index_load(htsFilePtr_, htsFilePath.c_str());
+    if (!htsIndexPtr_)
+    {
+        throw std::runtime_error("Failed to read index of " + htsFilePath);
+    }
+
+    fileDescriptor_ = open(htsFilePath.c_str(), O_RDONLY);
+    if (fileDescriptor_ == -1)
+    {
+        throw std::runtime_error("Failed to open " + htsFilePath + " for prefetching");
+    }
+#else
+    (void)htsFilePath;
+#endif
+}
+
+HtsBlockPrefetcher::~HtsBlockPrefetcher()
+{
+    if (fileDescriptor_ != -1)
+    {
+        close(fileDescriptor_);
+    }
+
+    if (htsIndexPtr_)
+    {
+        hts_idx_destroy(htsIndexPtr_);
+    }
+
+    if (htsFilePtr_)
+    {
+        sam_close(htsFilePtr_);
+    }
+}
+
+void HtsBlockPrefetcher::prefetch(const vector<GenomicRegion>& regions)
+{
+#ifdef __linux__
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> prefetchLock(prefetchMutex_);
+    vector<pair<uint64_t, uint64_t>> chunks;
+    for (const auto& region : regions)
+    {
+        hts_itr_t* htsRegionPtr = sam_itr_queryi(htsIndexPtr_, region.contigIndex(), region.start(), region.end());
+        if (!htsRegionPtr)
+        {
+            continue;
+        }
+
+        for (int chunkIndex = 0; chunkIndex != htsRegionPtr->n_off; ++chunkIndex)
+        {
+            chunks.emplace_back(htsRegionPtr->off[chunkIndex].u, htsRegionPtr->off[chunkIndex].v);
+        }
+        hts_itr_destroy(htsRegionPtr);
+    }
+
+    // The advice is only a hint, so failures are not errors
+    for (const auto& range : computeBlockRanges(std::move(chunks)))
+    {
+        (void)posix_fadvise(fileDescriptor_, range.first, range.second - range.first, POSIX_FADV_WILLNEED);
+    }
+#else
+    (void)regions;
+#endif
+}
+
+}
+
+}
@@ -0,0 +1,82 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "boost/noncopyable.hpp"
+extern "C"
+{
+#include "htslib/hts.h"
+#include "htslib/sam.h"
+}
+
+#include "core/GenomicRegion.hh"
+
+namespace ehunter
+{
+
+namespace htshelpers
+{
+
+/// Half-open range of byte offsets in a file
+using FileRange = std::pair<int64_t, int64_t>;
+
+/// \brief Convert the index chunks of a region into the byte ranges of the compressed blocks holding them
+///
+/// Each chunk is a pair of BGZF virtual offsets. The range of a chunk runs from the start of its first block to the
+/// end of its last block, which is assumed to be as long as the longest possible block. Overlapping and adjacent
+/// ranges are merged.
+///
+std::vector<FileRange> computeBlockRanges(std::vector<std::pair<uint64_t, uint64_t>> chunks);
+
+/// \brief Asks the operating system to read ahead the parts of a BAM file that upcoming loci will seek to
+///
+/// The compressed blocks holding the alignments of the given regions are located with the BAM index and then
+/// advised to the kernel with posix_fadvise, so that they are read into the page cache while the worker threads are
+/// busy with other loci. Prefetching is skipped for CRAM files, remote files, and on platforms without
+/// posix_fadvise.
+///
+/// Thread safe
+///
+class HtsBlockPrefetcher : private boost::noncopyable
+{
+public:
+    explicit HtsBlockPrefetcher(const std::string& htsFilePath);
+    ~HtsBlockPrefetcher();
+
+    bool isEnabled() const { return fileDescriptor_ != -1; }
+
+    void prefetch(const std::vector<GenomicRegion>& regions);
+
+private:
+    std::mutex prefetchMutex_;
+    htsFile* htsFilePtr_ = nullptr;
+    hts_idx_t* htsIndexPtr_ = nullptr;
+    int fileDescriptor_ = -1;
+};
+
+}
+
+}
@@ -0,0 +1,338 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/HtsEvidenceExtraction.hh"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "spdlog/spdlog.h"
+
+#include "core/HtsHelpers.hh"
+
+using std::string;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace
+{
+
+using HtsAlignmentPtr = std::unique_ptr<bam1_t, decltype(&bam_destroy1)>;
+using AlignmentVisitor = std::function<void(bam1_t*)>;
+
+// Mates closer to each other than this are recovered with a single index query
+const int kMaxMateQueryGap = 1000;
+
+string getReadKey(const bam1_t* htsAlignPtr)
+{
+    return string(bam_get_qname(htsAlignPtr)) + ((htsAlignPtr->core.flag & BAM_FREAD1) ? "/1" : "/2");
+}
+
+string getMateKey(const bam1_t* htsAlignPtr)
+{
+    return string(bam_get_qname(htsAlignPtr)) + ((htsAlignPtr->core.flag & BAM_FREAD1) ? "/2" : "/1");
+}
+
+/// True if any of the sorted and disjoint regions overlaps the interval
+bool overlapsAnyRegion(const vector<GenomicRegion>& regions, int32_t contigIndex, int64_t start, int64_t end)
+{
+    // Disjoint regions sorted by start are also sorted by end, so this finds the first region ending after the start
+    const auto regionIterator = std::lower_bound(
+        regions.begin(), regions.end(), GenomicRegion(contigIndex, start, start),
+        [](const GenomicRegion& region, const GenomicRegion& interval)
+        {
+            return region.contigIndex() < interval.contigIndex()
+                || (region.contigIndex() == interval.contigIndex() && region.end() <= interval.start());
+        });
+
+    return regionIterator != regions.end() && regionIterator->contigIndex() == contigIndex
+        && regionIterator->start() < end;
+}
+
+/// Reads primary alignments from regions of an indexed alignment file
+class EvidenceReader
+{
+public:
+    EvidenceReader(const string& htsFilePath, const string& htsReferencePath)
+        : htsFilePath_(htsFilePath)
+        , filePtr_(sam_open(htsFilePath.c_str(), "r"), hts_close)
+        , headerPtr_(nullptr, bam_hdr_destroy)
+        , indexPtr_(nullptr, hts_idx_destroy)
+        , alignmentPtr_(bam_init1(), bam_destroy1)
+    {
+        if (!filePtr_)
+        {
+            throw std::runtime_error("Failed to read BAM file " + htsFilePath_);
+        }
+
+        // Required step for parsing of some CRAMs
+        if (hts_set_fai_filename(filePtr_.get(), htsReferencePath.c_str()) != 0)
+        {
+            throw std::runtime_error("Failed to set index of: " + htsReferencePath);
+        }
+
+        headerPtr_.reset(sam_hdr_read(filePtr_.get()));
+        if (!headerPtr_)
+        {
+            throw std::runtime_error("Failed to read header of " + htsFilePath_);
+        }
+
+        indexPtr_.reset(sam_index_load(filePtr_.get(), htsFilePath_.c_str()));
+        if (!indexPtr_)
+        {
+            throw std::runtime_error("Failed to read index of " + htsFilePath_);
+        }
+    }
+
+    const bam_hdr_t* header() const { return headerPtr_.get(); }
+
+    /// Visit all primary alignments overlapping the region in file order
+    void visitPrimaryAlignments(const GenomicRegion& region, const AlignmentVisitor& visit)
+    {
+        std::unique_ptr<hts_itr_t, decltype(&hts_itr_destroy)> regionPtr(
+            sam_itr_queryi(indexPtr_.get(), region.contigIndex(), region.start(), region.end()), hts_itr_destroy);
+        if (!regionPtr)
+        {
+            throw std::runtime_error(
+                "Failed to extract reads from region " + std::to_string(region.contigIndex()) + ":"
+                + std::to_string(region.start()) + "-" + std::to_string(region.end()) + " of " + htsFilePath_);
+        }
+
+        int returnCode = 0;
+        while ((returnCode = sam_itr_next(filePtr_.get(), regionPtr.get(), alignmentPtr_.get())) >= 0)
+        {
+            if (htshelpers::isPrimaryAlignment(alignmentPtr_.get()))
+            {
+                visit(alignmentPtr_.get());
+            }
+        }
+
+        if (returnCode < -1)
+        {
+            throw std::runtime_error("Failed to extract a record from " + htsFilePath_);
+        }
+    }
+
+    /// \brief Visit the primary alignments overlapping the sorted and disjoint regions once each in genomic order
+    ///
+    /// An alignment overlapping several regions is returned by the query of each of them but is only visited with the
+    /// first one
+    ///
+    void visitPrimaryAlignments(const vector<GenomicRegion>& regions, const AlignmentVisitor& visit)
+    {
+        for (unsigned regionIndex(0); regionIndex < regions.size(); ++regionIndex)
+        {
+            const GenomicRegion* previousRegionPtr = regionIndex == 0 ? nullptr : &regions[regionIndex - 1];
+            visitPrimaryAlignments(
+                regions[regionIndex],
+                [&](bam1_t* htsAlignPtr)
+                {
+                    const bool isVisited = previousRegionPtr
+                        && htsAlignPtr->core.tid == previousRegionPtr->contigIndex()
+                        && htsAlignPtr->core.pos < previousRegionPtr->end();
+                    if (!isVisited)
+                    {
+                        visit(htsAlignPtr);
+                    }
+                });
+        }
+    }
+
+private:
+    string htsFilePath_;
+    std::unique_ptr<htsFile, decltype(&hts_close)> filePtr_;
+    std::unique_ptr<bam_hdr_t, decltype(&bam_hdr_destroy)> headerPtr_;
+    std::unique_ptr<hts_idx_t, decltype(&hts_idx_destroy)> indexPtr_;
+    HtsAlignmentPtr alignmentPtr_;
+};
+
+/// Writes a BAM file from records supplied in genomic order and indexes it
+class EvidenceWriter
+{
+public:
+    EvidenceWriter(const string& evidencePath, const bam_hdr_t* headerPtr)
+        : evidencePath_(evidencePath)
+        , headerPtr_(headerPtr)
+        , filePtr_(sam_open(evidencePath.c_str(), "wb"), hts_close)
+    {
+        if (!filePtr_)
+        {
+            throw std::runtime_error("Failed to open " + evidencePath_ + " for writing");
+        }
+
+        if (sam_hdr_write(filePtr_.get(), headerPtr_) != 0)
+        {
+            throw std::runtime_error("Failed to write header to " + evidencePath_);
+        }
+    }
+
+    void write(const bam1_t* htsAlignPtr)
+    {
+        if (sam_write1(filePtr_.get(), headerPtr_, htsAlignPtr) < 0)
+        {
+            throw std::runtime_error("Failed to write a record to " + evidencePath_);
+        }
+    }
+
+    void closeAndIndex()
+    {
+        // The file must be closed before it can be indexed
+        filePtr_.reset();
+        if (sam_index_build(evidencePath_.c_str(), 0) != 0)
+        {
+            throw std::runtime_error("Failed to index " + evidencePath_);
+        }
+    }
+
+private:
+    string evidencePath_;
+    const bam_hdr_t* headerPtr_;
+    std::unique_ptr<htsFile, decltype(&hts_close)> filePtr_;
+};
+
+}
+
+vector<GenomicRegion> computeEvidenceRegions(const RegionCatalog& regionCatalog)
+{
+    vector<GenomicRegion> regions;
+    for (const auto& locusSpec : regionCatalog)
+    {
+        const auto& targetRegions = locusSpec.targetReadExtractionRegions();
+        const auto& offtargetRegions = locusSpec.offtargetReadExtractionRegions();
+        regions.insert(regions.end(), targetRegions.begin(), targetRegions.end());
+        regions.insert(regions.end(), offtargetRegions.begin(), offtargetRegions.end());
+    }
+    return merge(regions);
+}
+
+bool isMateRecoveryNeeded(const LinearAlignmentStats& alignmentStats)
+{
+    return alignmentStats.isPaired && alignmentStats.mateChromId >= 0
+        && !checkIfMatesWereMappedNearby(alignmentStats);
+}
+
+vector<GenomicRegion> computeMateQueryRegions(vector<GenomicRegion> matePositions, int maxGap)
+{
+    return merge(std::move(matePositions), maxGap);
+}
+
+bool isBeforeInEvidenceFile(int32_t contigIndex1, int64_t position1, int32_t contigIndex2, int64_t position2)
+{
+    // Casting makes the negative index of unplaced records larger than any contig index
+    const auto unsignedContigIndex1 = static_cast<uint32_t>(contigIndex1);
+    const auto unsignedContigIndex2 = static_cast<uint32_t>(contigIndex2);
+    if (unsignedContigIndex1 != unsignedContigIndex2)
+    {
+        return unsignedContigIndex1 < unsignedContigIndex2;
+    }
+    return position1 < position2;
+}
+
+void htsEvidenceExtraction(const InputPaths& inputPaths, const RegionCatalog& regionCatalog, const string& evidencePath)
+{
+    const vector<GenomicRegion> regions = computeEvidenceRegions(regionCatalog);
+    EvidenceReader reader(inputPaths.htsFile(), inputPaths.reference());
+
+    // The first pass over the regions only finds the mates to look up, so that no region records are kept in memory
+    unsigned regionAlignmentCount(0);
+    vector<GenomicRegion> matePositions;
+    std::unordered_set<string> mateKeys;
+    reader.visitPrimaryAlignments(
+        regions,
+        [&](bam1_t* htsAlignPtr)
+        {
+            ++regionAlignmentCount;
+            const LinearAlignmentStats alignmentStats = htshelpers::decodeAlignmentStats(htsAlignPtr);
+            const int32_t mateContigIndex = alignmentStats.mateChromId;
+            const int64_t matePosition = alignmentStats.matePos;
+            if (isMateRecoveryNeeded(alignmentStats)
+                && !overlapsAnyRegion(regions, mateContigIndex, matePosition, matePosition + 1))
+            {
+                matePositions.emplace_back(mateContigIndex, matePosition, matePosition + 1);
+                mateKeys.insert(getMateKey(htsAlignPtr));
+            }
+        });
+
+    // Mates overlapping the regions are written together with the other region records
+    vector<HtsAlignmentPtr> mates;
+    const vector<GenomicRegion> mateQueryRegions = computeMateQueryRegions(std::move(matePositions), kMaxMateQueryGap);
+    for (const auto& mateQueryRegion : mateQueryRegions)
+    {
+        reader.visitPrimaryAlignments(
+            mateQueryRegion,
+            [&](bam1_t* htsAlignPtr)
+            {
+                const auto mateKeyIterator = mateKeys.find(getReadKey(htsAlignPtr));
+                if (mateKeyIterator == mateKeys.end())
+                {
+                    return;
+                }
+                mateKeys.erase(mateKeyIterator);
+
+                if (!overlapsAnyRegion(regions, htsAlignPtr->core.tid, htsAlignPtr->core.pos, bam_endpos(htsAlignPtr)))
+                {
+                    mates.emplace_back(bam_dup1(htsAlignPtr), bam_destroy1);
+                }
+            });
+    }
+
+    spdlog::info(
+        "Extracted {} reads from {} regions and recovered {} mates with {} queries", regionAlignmentCount,
+        regions.size(), mates.size(), mateQueryRegions.size());
+    if (!mateKeys.empty())
+    {
+        spdlog::warn("Could not recover {} mates", mateKeys.size());
+    }
+
+    std::sort(
+        mates.begin(), mates.end(),
+        [](const HtsAlignmentPtr& mate1, const HtsAlignmentPtr& mate2)
+        { return isBeforeInEvidenceFile(mate1->core.tid, mate1->core.pos, mate2->core.tid, mate2->core.pos); });
+
+    // The second pass writes the region records as they are read, merging in the recovered mates
+    EvidenceWriter writer(evidencePath, reader.header());
+    auto mateIterator = mates.begin();
+    reader.visitPrimaryAlignments(
+        regions,
+        [&](bam1_t* htsAlignPtr)
+        {
+            while (mateIterator != mates.end()
+                   && isBeforeInEvidenceFile(
+                       (*mateIterator)->core.tid, (*mateIterator)->core.pos, htsAlignPtr->core.tid,
+                       htsAlignPtr->core.pos))
+            {
+                writer.write(mateIterator->get());
+                ++mateIterator;
+            }
+            writer.write(htsAlignPtr);
+        });
+    for (; mateIterator != mates.end(); ++mateIterator)
+    {
+        writer.write(mateIterator->get());
+    }
+
+    writer.closeAndIndex();
+}
+
+}
@@ -0,0 +1,67 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/GenomicRegion.hh"
+#include "core/Parameters.hh"
+#include "core/Read.hh"
+#include "locus/LocusSpecification.hh"
+
+namespace ehunter
+{
+
+/// Merged target and offtarget read extraction regions of all catalog loci in genomic order
+std::vector<GenomicRegion> computeEvidenceRegions(const RegionCatalog& regionCatalog);
+
+/// \brief Check if the mate of a read collected from the evidence regions must be looked up separately
+///
+/// Seeking mode only looks up mates mapped far from their reads, so mates mapped nearby are needed only if they are in
+/// the evidence regions themselves, in which case they are collected with the regions
+///
+bool isMateRecoveryNeeded(const LinearAlignmentStats& alignmentStats);
+
+/// \brief Group the positions of mates to recover into the regions queried to recover them
+///
+/// Mates closer to each other than \p maxGap are recovered with a single index query
+///
+std::vector<GenomicRegion> computeMateQueryRegions(std::vector<GenomicRegion> matePositions, int maxGap);
+
+/// True if a record at the first position precedes a record at the second position in the evidence file; unplaced
+/// records (negative contig index) come last
+bool isBeforeInEvidenceFile(int32_t contigIndex1, int64_t position1, int32_t contigIndex2, int64_t position2);
+
+/// \brief Copy all reads that could be used in the analysis of the catalog loci to a sorted and indexed BAM file
+///
+/// The evidence file contains the primary alignments of all reads overlapping the target and offtarget read extraction
+/// regions of the catalog together with the mates that seeking mode looks up. Seeking-mode analysis of the evidence
+/// file with any catalog whose read extraction regions are contained in the regions of \p regionCatalog gives the
+/// same results as the analysis of the original alignment file.
+///
+/// Records are written as they are read from the regions, so memory use is bounded by the number of mates that are
+/// looked up rather than by the number of extracted reads.
+///
+void htsEvidenceExtraction(
+    const InputPaths& inputPaths, const RegionCatalog& regionCatalog, const std::string& evidencePath);
+
+}
@@ -72,6 +72,7 @@ void HtsFileStreamer::loadHeader()
     }
 
     contigInfo_ = htshelpers::decodeContigInfo(htsHeaderPtr_);
+    isCoordinateSorted_ = htshelpers::isCoordinateSorted(htsHeaderPtr_);
 }
 
 void HtsFileStreamer::prepareForStreamingAlignments() { htsAlignmentPtr_ = bam_init1(); }
@@ -68,6 +68,12 @@ public:
 
     bool currentIsPaired() const { return (htsAlignmentPtr_->core.flag & BAM_FPAIRED); }
 
+    /// Contigs declared in the file header
+    const ReferenceContigInfo& contigInfo() const { return contigInfo_; }
+
+    /// True if the file header declares the alignments to be sorted by coordinate
+    bool isCoordinateSorted() const { return isCoordinateSorted_; }
+
     bool isStreamingAlignedReads() const;
 
     Read decodeRead() const;
@@ -87,6 +93,7 @@ private:
     const std::string htsReferencePath_;
     ReferenceContigInfo contigInfo_;
     Status status_ = Status::kStreamingReads;
+    bool isCoordinateSorted_ = false;
 
     htsFile* htsFilePtr_ = nullptr;
     bam1_t* htsAlignmentPtr_ = nullptr;
@@ -22,6 +22,7 @@
 
 #include "sample/HtsSeekingSampleAnalysis.hh"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <memory>
@@ -41,14 +42,16 @@
 // clang-format on
 
 #include "core/ReadPairs.hh"
+#include "core/ThreadPlacement.hh"
 #include "locus/LocusAnalyzer.hh"
 #include "sample/AnalyzerFinder.hh"
+#include "sample/HtsBlockPrefetcher.hh"
 #include "sample/HtsFileSeeker.hh"
-#include "sample/IndexBasedDepthEstimate.hh"
 #include "sample/MateExtractor.hh"
 
 using boost::make_unique;
 using boost::optional;
+using ehunter::htshelpers::HtsBlockPrefetcher;
 using ehunter::htshelpers::HtsFileSeeker;
 using ehunter::locus::LocusAnalyzer;
 using graphtools::AlignmentWriter;
@@ -73,17 +76,6 @@ combineRegions(const vector<GenomicRegion>& targetRegions, const vector<GenomicR
     return combinedRegions;
 }
 
-bool checkIfMatesWereMappedNearby(const LinearAlignmentStats& alignmentStats)
-{
-    const int kMaxMateDistance = 1000;
-    if ((alignmentStats.chromId == alignmentStats.mateChromId)
-        && (std::abs(alignmentStats.pos - alignmentStats.matePos) < kMaxMateDistance))
-    {
-        return true;
-    }
-    return false;
-}
-
 void recoverMates(
     htshelpers::MateExtractor& mateExtractor, AlignmentStatsCatalog& alignmentStatsCatalog, ReadPairs& readPairs)
 {
@@ -248,11 +240,14 @@ public:
     LocusThreadSharedData()
         : isWorkerThreadException(false)
         , locusIndex(0)
+        , prefetchedLocusCount(0)
     {
     }
 
     std::atomic<bool> isWorkerThreadException;
     std::atomic<unsigned> locusIndex;
+    /// Loci with indexes below this count have been prefetched or taken up by a thread
+    std::atomic<unsigned> prefetchedLocusCount;
 };
 
 /// \brief Data isolated to each locus-processing thread
@@ -262,12 +257,40 @@ struct LocusThreadLocalData
     std::exception_ptr threadExceptionPtr = nullptr;
 };
 
+/// Prefetch the reads of the loci following the given locus that no thread has prefetched yet
+void prefetchUpcomingLoci(
+    HtsBlockPrefetcher& prefetcher, const RegionCatalog& regionCatalog, const unsigned locusIndex,
+    const int prefetchLoci, std::atomic<unsigned>& prefetchedLocusCount)
+{
+    const unsigned windowEnd = std::min<unsigned>(regionCatalog.size(), locusIndex + 1 + prefetchLoci);
+    unsigned windowStart = prefetchedLocusCount.load();
+    do
+    {
+        if (windowStart >= windowEnd)
+        {
+            return;
+        }
+    } while (!prefetchedLocusCount.compare_exchange_weak(windowStart, windowEnd));
+
+    for (unsigned upcomingLocusIndex = std::max(windowStart, locusIndex + 1); upcomingLocusIndex < windowEnd;
+         ++upcomingLocusIndex)
+    {
+        const LocusSpecification& locusSpec = regionCatalog[upcomingLocusIndex];
+        prefetcher.prefetch(
+            combineRegions(locusSpec.targetReadExtractionRegions(), locusSpec.offtargetReadExtractionRegions()));
+    }
+}
+
 /// \brief Process a series of loci on one thread
 ///
+/// \param[in] prefetcher Prefetcher of the alignment file blocks of upcoming loci; prefetching is off if null
+///
 void processLocus(
-    const int threadIndex, const InputPaths& inputPaths, const Sex sampleSex,
+    const int threadIndex, const ThreadPlacement& threadPlacement, const InputPaths& inputPaths, const Sex sampleSex,
     const HeuristicParameters& heuristicParams, const RegionCatalog& regionCatalog,
-    locus::AlignWriterPtr alignmentWriter, SampleFindings& sampleFindings, LocusThreadSharedData& locusThreadSharedData,
+    locus::AlignWriterPtr alignmentWriter, AlignmentCacheWriterPtr alignmentCacheWriter,
+    const IndexDepthEstimate* depthEstimate, HtsBlockPrefetcher* prefetcher, const int prefetchLoci,
+    SampleFindings& sampleFindings, LocusThreadSharedData& locusThreadSharedData,
     std::vector<LocusThreadLocalData>& locusThreadLocalDataPool)
 {
     LocusThreadLocalData& locusThreadData(locusThreadLocalDataPool[threadIndex]);
@@ -275,6 +298,9 @@ void processLocus(
 
     try
     {
+        // Pinning the thread before any allocations places its seekers and locus state on the memory of its node
+        threadPlacement.pinCurrentThread(threadIndex);
+
         HtsFileSeeker htsFileSeeker(inputPaths.htsFile(), inputPaths.reference());
         htshelpers::MateExtractor mateExtractor(inputPaths.htsFile(), inputPaths.reference());
         graphtools::AlignerSelector alignerSelector(heuristicParams.alignerType());
@@ -292,12 +318,22 @@ void processLocus(
                 return;
             }
 
+            if (prefetcher)
+            {
+                prefetchUpcomingLoci(
+                    *prefetcher, regionCatalog, locusIndex, prefetchLoci, locusThreadSharedData.prefetchedLocusCount);
+            }
+
             const auto& locusSpec(regionCatalog[locusIndex]);
             locusId = locusSpec.locusId();
 
             spdlog::info("Analyzing {}", locusId);
             vector<unique_ptr<LocusAnalyzer>> locusAnalyzers;
             auto analyzer(make_unique<LocusAnalyzer>(locusSpec, heuristicParams, alignmentWriter));
+            if (alignmentCacheWriter)
+            {
+                analyzer->enableAlignmentRecording();
+            }
             locusAnalyzers.emplace_back(std::move(analyzer));
             AnalyzerFinder analyzerFinder(locusAnalyzers);
 
@@ -308,7 +344,12 @@ void processLocus(
 
             processReads(locusAnalyzers, readPairs, alignmentStats, analyzerFinder, alignerSelector);
 
-            sampleFindings[locusIndex] = locusAnalyzers.front()->analyze(sampleSex, boost::none);
+            sampleFindings[locusIndex]
+                = locusAnalyzers.front()->analyze(sampleSex, getIndexBasedLocusDepth(depthEstimate, locusSpec));
+            if (alignmentCacheWriter)
+            {
+                alignmentCacheWriter->write(locusId, *locusAnalyzers.front()->alignmentRecord());
+            }
         }
     }
     catch (const std::exception& e)
@@ -332,7 +373,9 @@ void processLocus(
 
 SampleFindings htsSeekingSampleAnalysis(
     const InputPaths& inputPaths, Sex sampleSex, const HeuristicParameters& heuristicParams, const int threadCount,
-    const RegionCatalog& regionCatalog, locus::AlignWriterPtr alignmentWriter)
+    const RegionCatalog& regionCatalog, locus::AlignWriterPtr alignmentWriter,
+    AlignmentCacheWriterPtr alignmentCacheWriter, const IndexDepthEstimate* depthEstimate, const bool pinThreads,
+    const int prefetchLoci)
 {
     if (ehunter::isURL(inputPaths.htsFile()))
     {
@@ -346,6 +389,18 @@ SampleFindings htsSeekingSampleAnalysis(
         }
     }
 
+    unique_ptr<HtsBlockPrefetcher> prefetcher;
+    if (prefetchLoci > 0)
+    {
+        prefetcher = make_unique<HtsBlockPrefetcher>(inputPaths.htsFile());
+        if (!prefetcher->isEnabled())
+        {
+            spdlog::warn("Prefetching of alignment file blocks is not supported for {}", inputPaths.htsFile());
+            prefetcher.reset();
+        }
+    }
+
+    const ThreadPlacement threadPlacement = makeThreadPlacement(threadCount, pinThreads);
     LocusThreadSharedData locusThreadSharedData;
     std::vector<LocusThreadLocalData> locusThreadLocalDataPool(threadCount);
 
@@ -357,8 +412,9 @@ SampleFindings htsSeekingSampleAnalysis(
     for (int threadIndex(0); threadIndex < threadCount; ++threadIndex)
     {
         locusThreads.emplace_back(
-            processLocus, threadIndex, std::cref(inputPaths), sampleSex, std::cref(heuristicParams),
-            std::cref(regionCatalog), alignmentWriter, std::ref(sampleFindings), std::ref(locusThreadSharedData),
+            processLocus, threadIndex, std::cref(threadPlacement), std::cref(inputPaths), sampleSex,
+            std::cref(heuristicParams), std::cref(regionCatalog), alignmentWriter, alignmentCacheWriter, depthEstimate,
+            prefetcher.get(), prefetchLoci, std::ref(sampleFindings), std::ref(locusThreadSharedData),
             std::ref(locusThreadLocalDataPool));
     }
 
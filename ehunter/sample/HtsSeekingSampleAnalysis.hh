@@ -27,15 +27,22 @@
 #include "graphio/AlignmentWriter.hh"
 
 #include "core/Parameters.hh"
+#include "io/AlignmentCache.hh"
 #include "locus/LocusAnalyzer.hh"
 #include "locus/LocusFindings.hh"
 #include "locus/LocusSpecification.hh"
+#include "sample/IndexBasedDepthEstimate.hh"
 
 namespace ehunter
 {
 
+/// \param[in] depthEstimate Index-based depth applied to each locus (see LocusAnalyzer::analyze); ignored if null
+/// \param[in] pinThreads Pin worker threads to CPUs spread over the NUMA nodes
+/// \param[in] prefetchLoci Number of loci ahead of the worker threads whose reads are prefetched (0 to disable)
 SampleFindings htsSeekingSampleAnalysis(
     const InputPaths& inputPaths, Sex sampleSex, const HeuristicParameters& heuristicParams, int threadCount,
-    const RegionCatalog& regionCatalog, locus::AlignWriterPtr alignmentWriter);
+    const RegionCatalog& regionCatalog, locus::AlignWriterPtr alignmentWriter,
+    AlignmentCacheWriterPtr alignmentCacheWriter, const IndexDepthEstimate* depthEstimate = nullptr,
+    bool pinThreads = false, int prefetchLoci = 0);
 
 }
@@ -21,31 +21,56 @@
 
 #include "sample/HtsStreamingReadPairQueue.hh"
 
+#include <stdexcept>
+#include <string>
+
 namespace ehunter
 {
 
+void HtsStreamingReadPairQueue::activateQueue(LocusAnalyzerQueue& locusAnalyzerQueue)
+{
+    std::unique_lock<std::mutex> globalLock(mutex_);
+    while (activeLocusAnalyzerQueues_ >= maxActiveLocusAnalyzerQueues_)
+    {
+        cv_.wait(globalLock);
+    }
+    activeLocusAnalyzerQueues_++;
+    globalLock.unlock();
+
+    locusAnalyzerQueue.isActive = true;
+}
+
 bool HtsStreamingReadPairQueue::insertReadPair(const unsigned locusIndex, ReadPair readPair)
 {
     auto& locusAnalyzerQueue(queues_[locusIndex]);
     std::unique_lock<std::mutex> locusAnalyzerQueueLock(locusAnalyzerQueue.mutex);
+    if (locusAnalyzerQueue.isRetired)
+    {
+        throw std::logic_error("Attempting to insert a read pair into retired queue " + std::to_string(locusIndex));
+    }
     const bool wasInActive(not locusAnalyzerQueue.isActive);
     if (wasInActive)
     {
-        std::unique_lock<std::mutex> globalLock(mutex_);
-        while (activeLocusAnalyzerQueues_ >= maxActiveLocusAnalyzerQueues_)
-        {
-            cv_.wait(globalLock);
-        }
-        activeLocusAnalyzerQueues_++;
-        globalLock.unlock();
-
-        locusAnalyzerQueue.isActive = true;
+        activateQueue(locusAnalyzerQueue);
     }
     locusAnalyzerQueue.queue.emplace(std::move(readPair));
     return wasInActive;
 }
 
-void HtsStreamingReadPairQueue::getNextReadPair(const unsigned locusIndex, boost::optional<ReadPair>& readPair)
+bool HtsStreamingReadPairQueue::retireQueue(const unsigned locusIndex)
+{
+    auto& locusAnalyzerQueue(queues_[locusIndex]);
+    std::unique_lock<std::mutex> locusAnalyzerQueueLock(locusAnalyzerQueue.mutex);
+    locusAnalyzerQueue.isRetired = true;
+    const bool wasInActive(not locusAnalyzerQueue.isActive);
+    if (wasInActive)
+    {
+        activateQueue(locusAnalyzerQueue);
+    }
+    return wasInActive;
+}
+
+bool HtsStreamingReadPairQueue::getNextReadPair(const unsigned locusIndex, boost::optional<ReadPair>& readPair)
 {
     auto& locusAnalyzerQueue(queues_[locusIndex]);
     std::unique_lock<std::mutex> locusAnalyzerQueueLock(locusAnalyzerQueue.mutex);
@@ -57,15 +82,18 @@ void HtsStreamingReadPairQueue::getNextReadPair(const unsigned locusIndex, boost
         globalLock.unlock();
 
         locusAnalyzerQueue.isActive = false;
+        const bool isRetired(locusAnalyzerQueue.isRetired);
         locusAnalyzerQueueLock.unlock();
 
         cv_.notify_one();
         readPair = boost::none;
+        return isRetired;
     }
     else
     {
         readPair = std::move(locusAnalyzerQueue.queue.front());
         locusAnalyzerQueue.queue.pop();
+        return false;
     }
 }
 
@@ -80,7 +80,20 @@ public:
     ///
     /// \param[out] readPair Next read pair enqueued for \p locusIndex, or none if the queue is empty
     ///
-    void getNextReadPair(unsigned locusIndex, boost::optional<ReadPair>& readPair);
+    /// \return True if the queue is empty and has been retired, in which case the calling thread is responsible for
+    /// finalizing the corresponding LocusAnalyzer
+    ///
+    bool getNextReadPair(unsigned locusIndex, boost::optional<ReadPair>& readPair);
+
+    /// \brief Mark the \p locusIndex queue as retired, so that no further read pairs can be inserted into it
+    ///
+    /// If \p locusIndex corresponds to an inactive queue, this will block until the queue can be activated without
+    /// exceeding maxActiveLocusAnalyzerQueues.
+    ///
+    /// \return True if the queue was inactive before this method call, in which case the caller must schedule a thread
+    /// to process (and thereby finalize) the queue
+    ///
+    bool retireQueue(unsigned locusIndex);
 
 private:
     struct LocusAnalyzerQueue
@@ -92,8 +105,14 @@ private:
 
         /// True if a thread is either processing or scheduled to process this queue already
         bool isActive = false;
+
+        /// True if no more read pairs will be inserted into this queue
+        bool isRetired = false;
     };
 
+    /// Wait for a free slot under the max active queue limit and mark \p locusAnalyzerQueue as active
+    void activateQueue(LocusAnalyzerQueue& locusAnalyzerQueue);
+
     const unsigned maxActiveLocusAnalyzerQueues_;
     unsigned activeLocusAnalyzerQueues_;
     std::vector<LocusAnalyzerQueue> queues_;
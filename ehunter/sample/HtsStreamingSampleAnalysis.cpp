@@ -22,6 +22,7 @@
 
 #include "sample/HtsStreamingSampleAnalysis.hh"
 
+#include <algorithm>
 #include <memory>
 
 #include "absl/container/flat_hash_set.h"
@@ -29,14 +30,15 @@
 #include <boost/optional.hpp>
 
 #include "core/HtsHelpers.hh"
+#include "core/ThreadPlacement.hh"
 #include "core/ThreadPool.hh"
 #include "locus/LocusAnalyzer.hh"
-#include "locus/LocusAnalyzerUtil.hh"
 #include "sample/GenomeQueryCollection.hh"
 #include "sample/HtsFileStreamer.hh"
 #include "sample/HtsStreamingReadPairQueue.hh"
+#include "sample/LocusRetirementTracker.hh"
+#include "sample/UnmappedIrrScreen.hh"
 
-using ehunter::locus::initializeLocusAnalyzers;
 using ehunter::locus::LocusAnalyzer;
 using graphtools::AlignmentWriter;
 using std::string;
@@ -53,15 +55,73 @@ namespace
 class LocusAnalyzerThreadSharedData
 {
 public:
-    LocusAnalyzerThreadSharedData(const unsigned maxActiveLocusAnalyzerQueues, const unsigned locusAnalyzerCount)
+    LocusAnalyzerThreadSharedData(
+        const unsigned maxActiveLocusAnalyzerQueues, const RegionCatalog& initRegionCatalog,
+        const HeuristicParameters& initHeuristicParams, locus::AlignWriterPtr initBamletWriter,
+        AlignmentCacheWriterPtr initAlignmentCacheWriter, const Sex initSampleSex,
+        const IndexDepthEstimate* initDepthEstimate)
         : isWorkerThreadException(false)
-        , readPairQueue(maxActiveLocusAnalyzerQueues, locusAnalyzerCount)
+        , readPairQueue(maxActiveLocusAnalyzerQueues, initRegionCatalog.size())
+        , locusAnalyzers(initRegionCatalog.size())
+        , regionCatalog(initRegionCatalog)
+        , heuristicParams(initHeuristicParams)
+        , bamletWriter(std::move(initBamletWriter))
+        , alignmentCacheWriter(std::move(initAlignmentCacheWriter))
+        , sampleSex(initSampleSex)
+        , depthEstimate(initDepthEstimate)
+        , sampleFindings(initRegionCatalog.size())
     {
     }
 
+    std::unique_ptr<LocusAnalyzer> makeLocusAnalyzer(const unsigned locusIndex) const
+    {
+        std::unique_ptr<LocusAnalyzer> locusAnalyzer(
+            new LocusAnalyzer(regionCatalog[locusIndex], heuristicParams, bamletWriter));
+        if (alignmentCacheWriter)
+        {
+            locusAnalyzer->enableAlignmentRecording();
+        }
+        return locusAnalyzer;
+    }
+
+    /// Store the findings of the locus and its alignments if the alignment cache is enabled
+    void finalizeLocus(const unsigned locusIndex, LocusAnalyzer& locusAnalyzer)
+    {
+        const auto sampleDepth = getIndexBasedLocusDepth(depthEstimate, regionCatalog[locusIndex]);
+        sampleFindings[locusIndex] = locusAnalyzer.analyze(sampleSex, sampleDepth);
+        if (alignmentCacheWriter)
+        {
+            alignmentCacheWriter->write(locusAnalyzer.locusId(), *locusAnalyzer.alignmentRecord());
+        }
+    }
+
+    /// Store the findings of a locus that received no read pairs without constructing its LocusAnalyzer
+    void finalizeLocusWithoutReads(const unsigned locusIndex)
+    {
+        const LocusSpecification& locusSpec = regionCatalog[locusIndex];
+        const auto sampleDepth = getIndexBasedLocusDepth(depthEstimate, locusSpec);
+        sampleFindings[locusIndex] = LocusAnalyzer::analyzeWithoutReads(locusSpec, sampleSex, sampleDepth);
+        if (alignmentCacheWriter)
+        {
+            alignmentCacheWriter->write(locusSpec.locusId(), locus::LocusAlignmentRecord());
+        }
+    }
+
     std::atomic<bool> isWorkerThreadException;
     HtsStreamingReadPairQueue readPairQueue;
+
+    /// Each LocusAnalyzer is constructed when the first read pair for its locus is processed; loci without read pairs
+    /// never get one
     vector<std::unique_ptr<LocusAnalyzer>> locusAnalyzers;
+    const RegionCatalog& regionCatalog;
+    const HeuristicParameters& heuristicParams;
+    locus::AlignWriterPtr bamletWriter;
+    AlignmentCacheWriterPtr alignmentCacheWriter;
+
+    const Sex sampleSex;
+    const IndexDepthEstimate* depthEstimate;
+    /// Findings of loci retired while streaming are stored here as soon as they are available
+    SampleFindings sampleFindings;
 };
 
 /// \brief Data isolated to each LocusAnalyzer-processing thread
@@ -83,23 +143,49 @@ void processLocusAnalyzerQueue(
     }
 
     LocusAnalyzerThreadLocalData& locusAnalyzerThreadData(locusAnalyzerThreadLocalDataPool[threadIndex]);
-    auto& locusAnalyzer(*locusAnalyzerThreadSharedData.locusAnalyzers[locusIndex]);
+    const LocusSpecification& locusSpec(locusAnalyzerThreadSharedData.regionCatalog[locusIndex]);
+    auto& locusAnalyzerPtr(locusAnalyzerThreadSharedData.locusAnalyzers[locusIndex]);
 
     boost::optional<HtsStreamingReadPairQueue::ReadPair> readPair;
+    bool isQueueRetired(false);
 
     try
     {
+        // Thread state is created by the worker itself, so that it is allocated on the memory of the worker's node
+        if (not locusAnalyzerThreadData.alignerSelectorPtr)
+        {
+            locusAnalyzerThreadData.alignerSelectorPtr.reset(
+                new graphtools::AlignerSelector(locusAnalyzerThreadSharedData.heuristicParams.alignerType()));
+        }
+
         while (true)
         {
-            locusAnalyzerThreadSharedData.readPairQueue.getNextReadPair(locusIndex, readPair);
+            isQueueRetired = locusAnalyzerThreadSharedData.readPairQueue.getNextReadPair(locusIndex, readPair);
             if (not readPair)
             {
                 break;
             }
+            if (not locusAnalyzerPtr)
+            {
+                locusAnalyzerPtr = locusAnalyzerThreadSharedData.makeLocusAnalyzer(locusIndex);
+            }
             processAnalyzerBundleReadPair(
-                locusAnalyzer, readPair->regionType, readPair->inputType, readPair->read, readPair->mate,
+                *locusAnalyzerPtr, readPair->regionType, readPair->inputType, readPair->read, readPair->mate,
                 *locusAnalyzerThreadData.alignerSelectorPtr);
         }
+
+        // The queue of a retired locus has been fully drained, so the locus can be finalized and its state released:
+        if (isQueueRetired)
+        {
+            if (locusAnalyzerPtr)
+            {
+                locusAnalyzerThreadSharedData.finalizeLocus(locusIndex, *locusAnalyzerPtr);
+            }
+            else
+            {
+                locusAnalyzerThreadSharedData.finalizeLocusWithoutReads(locusIndex);
+            }
+        }
     }
     catch (const std::exception& e)
     {
@@ -108,7 +194,7 @@ void processLocusAnalyzerQueue(
 
         std::ostringstream oss;
         oss << "Exception caught in thread " << threadIndex << " while processing read pair queue for locus: `"
-            << locusAnalyzer.locusId() << "`";
+            << locusSpec.locusId() << "`";
         if (readPair)
         {
             oss << " current readPair: `" << readPair->read.fragmentId() << "`";
@@ -124,7 +210,7 @@ void processLocusAnalyzerQueue(
 
         std::ostringstream oss;
         oss << "Exception caught in thread " << threadIndex << " while processing read pair queue for locus: `"
-            << locusAnalyzer.locusId() << "`";
+            << locusSpec.locusId() << "`";
         if (readPair)
         {
             oss << " current readPair: `" << readPair->read.fragmentId() << "`";
@@ -132,6 +218,11 @@ void processLocusAnalyzerQueue(
         spdlog::error(oss.str());
         throw;
     }
+
+    if (isQueueRetired)
+    {
+        locusAnalyzerPtr.reset();
+    }
 }
 
 /// \brief Mutable data shared by all SampleFindings-processing threads
@@ -159,16 +250,19 @@ struct SampleFindingsThreadLocalData
 /// \brief Analyze a series of loci on one thread
 ///
 void analyzeLocus(
-    const int threadIndex, const Sex sampleSex, vector<std::unique_ptr<LocusAnalyzer>>& locusAnalyzers,
-    SampleFindings& sampleFindings, SampleFindingsThreadSharedData& sampleFindingsThreadSharedData,
+    const int threadIndex, const ThreadPlacement& threadPlacement,
+    LocusAnalyzerThreadSharedData& locusAnalyzerThreadSharedData, const vector<bool>& isLocusRetired,
+    SampleFindingsThreadSharedData& sampleFindingsThreadSharedData,
     std::vector<SampleFindingsThreadLocalData>& sampleFindingsThreadLocalData)
 {
     SampleFindingsThreadLocalData& sampleFindingsThreadData(sampleFindingsThreadLocalData[threadIndex]);
     std::string locusId = "Unknown";
+    threadPlacement.pinCurrentThread(threadIndex);
 
     try
     {
 
+        auto& locusAnalyzers(locusAnalyzerThreadSharedData.locusAnalyzers);
         const unsigned size(locusAnalyzers.size());
         while (true)
         {
@@ -182,9 +276,23 @@ void analyzeLocus(
                 return;
             }
 
-            auto& locusAnalyzer(*locusAnalyzers[locusIndex]);
-            locusId = locusAnalyzer.locusId();
-            sampleFindings[locusIndex] = locusAnalyzer.analyze(sampleSex, boost::none);
+            // Loci retired during streaming have already been analyzed:
+            if (isLocusRetired[locusIndex])
+            {
+                continue;
+            }
+
+            locusId = locusAnalyzerThreadSharedData.regionCatalog[locusIndex].locusId();
+
+            // Loci without any read pairs report their (empty) findings without an analyzer:
+            if (not locusAnalyzers[locusIndex])
+            {
+                locusAnalyzerThreadSharedData.finalizeLocusWithoutReads(locusIndex);
+                continue;
+            }
+
+            locusAnalyzerThreadSharedData.finalizeLocus(locusIndex, *locusAnalyzers[locusIndex]);
+            locusAnalyzers[locusIndex].reset();
         }
     }
     catch (const std::exception& e)
@@ -207,28 +315,62 @@ void analyzeLocus(
 
 }
 
+std::unique_ptr<htshelpers::HtsFileStreamer> openAlignmentStream(const InputPaths& inputPaths, const int threadCount)
+{
+    const unsigned htsDecompressionThreads(std::min(threadCount, 12));
+    return std::unique_ptr<htshelpers::HtsFileStreamer>(
+        new htshelpers::HtsFileStreamer(inputPaths.htsFile(), inputPaths.reference(), htsDecompressionThreads));
+}
+
 SampleFindings htsStreamingSampleAnalysis(
     const InputPaths& inputPaths, Sex sampleSex, const HeuristicParameters& heuristicParams, const int threadCount,
-    const RegionCatalog& regionCatalog, locus::AlignWriterPtr bamletWriter)
+    const RegionCatalog& regionCatalog, locus::AlignWriterPtr bamletWriter,
+    AlignmentCacheWriterPtr alignmentCacheWriter, const IndexDepthEstimate* depthEstimate, const bool pinThreads)
+{
+    auto readStreamer = openAlignmentStream(inputPaths, threadCount);
+    return htsStreamingSampleAnalysis(
+        *readStreamer, sampleSex, heuristicParams, threadCount, regionCatalog, bamletWriter, alignmentCacheWriter,
+        depthEstimate, pinThreads);
+}
+
+SampleFindings htsStreamingSampleAnalysis(
+    htshelpers::HtsFileStreamer& readStreamer, Sex sampleSex, const HeuristicParameters& heuristicParams,
+    const int threadCount, const RegionCatalog& regionCatalog, locus::AlignWriterPtr bamletWriter,
+    AlignmentCacheWriterPtr alignmentCacheWriter, const IndexDepthEstimate* depthEstimate, const bool pinThreads)
 {
     // Setup thread-specific data structures and thread pool
     const unsigned maxActiveLocusAnalyzerQueues(threadCount + 5);
     const unsigned locusAnalyzerCount(regionCatalog.size());
-    LocusAnalyzerThreadSharedData locusAnalyzerThreadSharedData(maxActiveLocusAnalyzerQueues, locusAnalyzerCount);
+    LocusAnalyzerThreadSharedData locusAnalyzerThreadSharedData(
+        maxActiveLocusAnalyzerQueues, regionCatalog, heuristicParams, bamletWriter, alignmentCacheWriter, sampleSex,
+        depthEstimate);
     std::vector<LocusAnalyzerThreadLocalData> locusAnalyzerThreadLocalDataPool(threadCount);
-    for (int threadIndex(0); threadIndex < threadCount; ++threadIndex)
+
+    // Each NUMA domain has its own pool and all read pairs of a locus are processed by the pool of one domain
+    const ThreadPlacement threadPlacement = makeThreadPlacement(threadCount, pinThreads);
+    vector<std::unique_ptr<ctpl::thread_pool>> pools;
+    for (int domainIndex(0); domainIndex < threadPlacement.domainCount(); ++domainIndex)
     {
-        auto& locusAnalyzerThreadData(locusAnalyzerThreadLocalDataPool[threadIndex]);
-        locusAnalyzerThreadData.alignerSelectorPtr.reset(
-            new graphtools::AlignerSelector(heuristicParams.alignerType()));
+        pools.emplace_back(new ctpl::thread_pool(threadPlacement.threadCountOfDomain(domainIndex)));
     }
-    ctpl::thread_pool pool(threadCount);
 
-    spdlog::info("Initializing all loci");
-    graphtools::AlignerSelector alignerSelector(heuristicParams.alignerType());
-    locusAnalyzerThreadSharedData.locusAnalyzers
-        = initializeLocusAnalyzers(regionCatalog, heuristicParams, bamletWriter, threadCount);
-    GenomeQueryCollection genomeQuery(locusAnalyzerThreadSharedData.locusAnalyzers);
+    auto scheduleLocusQueue = [&](const unsigned locusIndex)
+    {
+        const int domainIndex = locusIndex % threadPlacement.domainCount();
+        const int firstThreadIndex = threadPlacement.firstThreadOfDomain(domainIndex);
+        pools[domainIndex]->push(
+            [&, firstThreadIndex](const int poolThreadIndex, const unsigned queueLocusIndex)
+            {
+                const int threadIndex = firstThreadIndex + poolThreadIndex;
+                threadPlacement.pinCurrentThread(threadIndex);
+                processLocusAnalyzerQueue(
+                    threadIndex, locusAnalyzerThreadSharedData, locusAnalyzerThreadLocalDataPool, queueLocusIndex);
+            },
+            locusIndex);
+    };
+
+    // Locus analyzers are constructed on demand by the worker threads, so only the region index is built up front
+    GenomeQueryCollection genomeQuery(regionCatalog);
 
     spdlog::info("Streaming reads");
 
@@ -237,9 +379,105 @@ SampleFindings htsStreamingSampleAnalysis(
     using ReadCatalog = absl::flat_hash_set<Read, decltype(ReadHash), decltype(ReadEq)>;
     ReadCatalog unpairedReads(1000, ReadHash, ReadEq);
 
-    const unsigned htsDecompressionThreads(std::min(threadCount, 12));
-    htshelpers::HtsFileStreamer readStreamer(inputPaths.htsFile(), inputPaths.reference(), htsDecompressionThreads);
-    while (readStreamer.trySeekingToNextPrimaryAlignment() && readStreamer.isStreamingAlignedReads())
+    // Unless unaligned reads are skipped, unmapped read pairs are screened for in-repeat reads of rare-repeat loci
+    std::unique_ptr<UnmappedIrrScreen> unmappedIrrScreen;
+    vector<unsigned> rescueTargetLoci;
+    if (!heuristicParams.skipUnaligned())
+    {
+        unmappedIrrScreen.reset(new UnmappedIrrScreen(regionCatalog));
+        rescueTargetLoci = unmappedIrrScreen->targetLoci();
+        if (unmappedIrrScreen->empty())
+        {
+            spdlog::warn("Catalog contains no rare repeats; unmapped reads will not be screened");
+            unmappedIrrScreen.reset();
+        }
+        else
+        {
+            spdlog::info(
+                "Unmapped read pairs will be screened for in-repeat reads of {} loci", rescueTargetLoci.size());
+        }
+    }
+    ReadCatalog unmappedReads(1000, ReadHash, ReadEq);
+    int rescuedPairCount(0);
+
+    // For coordinate-sorted input, loci are analyzed and released as soon as the stream moves past them
+    const bool isEarlyLocusRetirementEnabled(readStreamer.isCoordinateSorted());
+    LocusRetirementTracker retirementTracker(regionCatalog, kMaxMateDistance, rescueTargetLoci);
+    vector<bool> isLocusRetired(locusAnalyzerCount, false);
+    vector<unsigned> lociToRetire;
+    unsigned retiredLocusCount(0);
+    if (isEarlyLocusRetirementEnabled)
+    {
+        spdlog::info(
+            "Input is coordinate-sorted; {} of {} loci will be analyzed during streaming",
+            retirementTracker.numRetirableLoci(), locusAnalyzerCount);
+    }
+
+    auto retireLoci = [&]()
+    {
+        for (const unsigned locusIndex : lociToRetire)
+        {
+            isLocusRetired[locusIndex] = true;
+            ++retiredLocusCount;
+            if (locusAnalyzerThreadSharedData.readPairQueue.retireQueue(locusIndex))
+            {
+                scheduleLocusQueue(locusIndex);
+            }
+        }
+        lociToRetire.clear();
+    };
+
+    auto sendReadPair = [&](unsigned locusIndex, HtsStreamingReadPairQueue::ReadPair readPair)
+    {
+        if (isLocusRetired[locusIndex])
+        {
+            throw std::logic_error(
+                "Read pair " + readPair.read.fragmentId() + " was assigned to already analyzed locus "
+                + regionCatalog[locusIndex].locusId());
+        }
+
+        if (locusAnalyzerThreadSharedData.readPairQueue.insertReadPair(locusIndex, std::move(readPair)))
+        {
+            scheduleLocusQueue(locusIndex);
+        }
+    };
+
+    // Fully unmapped pairs passing the screen are sent to the matching loci as offtarget read pairs, so that their IRR
+    // pair finders make the final call
+    auto screenUnmappedRead = [&]()
+    {
+        if (not readStreamer.currentIsPaired())
+        {
+            return;
+        }
+
+        Read read = readStreamer.decodeRead();
+        const auto mateIterator = unmappedReads.find(read);
+        if (!unmappedIrrScreen->isCandidateRead(read.sequence()))
+        {
+            if (mateIterator != unmappedReads.end())
+            {
+                unmappedReads.erase(mateIterator);
+            }
+            return;
+        }
+
+        if (mateIterator == unmappedReads.end())
+        {
+            unmappedReads.emplace(std::move(read));
+            return;
+        }
+        Read mate = std::move(*mateIterator);
+        unmappedReads.erase(mateIterator);
+
+        for (const unsigned locusIndex : unmappedIrrScreen->findCandidateLoci(read.sequence(), mate.sequence()))
+        {
+            sendReadPair(locusIndex, { locus::RegionType::kOfftarget, AnalyzerInputType::kBothReads, read, mate });
+            ++rescuedPairCount;
+        }
+    };
+
+    while (readStreamer.trySeekingToNextPrimaryAlignment())
     {
         // Stop processing reads if an exception is thrown in the worker pool:
         if (locusAnalyzerThreadSharedData.isWorkerThreadException.load())
@@ -247,6 +485,28 @@ SampleFindings htsStreamingSampleAnalysis(
             break;
         }
 
+        // Unplaced reads are stored at the end of sorted files but may appear anywhere in unsorted streams
+        if (!readStreamer.isStreamingAlignedReads())
+        {
+            if (unmappedIrrScreen)
+            {
+                screenUnmappedRead();
+                continue;
+            }
+            if (readStreamer.isCoordinateSorted())
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (isEarlyLocusRetirementEnabled)
+        {
+            retirementTracker.advance(
+                readStreamer.currentReadContigId(), readStreamer.currentReadPosition(), lociToRetire);
+            retireLoci();
+        }
+
         const bool isReadNearTargetRegion = genomeQuery.targetRegionMask.query(
             readStreamer.currentReadContigId(), readStreamer.currentReadPosition());
         const bool isMateNearTargetRegion = genomeQuery.targetRegionMask.query(
@@ -265,12 +525,29 @@ SampleFindings htsStreamingSampleAnalysis(
         const auto mateIterator = unpairedReads.find(read);
         if (mateIterator == unpairedReads.end())
         {
+            if (isEarlyLocusRetirementEnabled)
+            {
+                // Loci with this read in their extraction regions must stay open until the read is paired
+                const int64_t readEnd = readStreamer.currentReadPosition() + read.sequence().length();
+                vector<unsigned> pendingLoci;
+                for (const auto& bundle : genomeQuery.analyzerFinder.query(
+                         readStreamer.currentReadContigId(), readStreamer.currentReadPosition(), readEnd))
+                {
+                    pendingLoci.push_back(bundle.locusIndex);
+                }
+                retirementTracker.addPendingRead(read.fragmentId(), pendingLoci);
+            }
             unpairedReads.emplace(std::move(read));
             continue;
         }
         Read mate = std::move(*mateIterator);
         unpairedReads.erase(mateIterator);
 
+        if (isEarlyLocusRetirementEnabled)
+        {
+            retirementTracker.removePendingRead(mate.fragmentId(), lociToRetire);
+        }
+
         const int64_t readEnd = readStreamer.currentReadPosition() + read.sequence().length();
         const int64_t mateEnd = readStreamer.currentMatePosition() + mate.sequence().length();
 
@@ -282,28 +559,27 @@ SampleFindings htsStreamingSampleAnalysis(
         for (unsigned bundleIndex(0); bundleIndex < bundleCount; ++bundleIndex)
         {
             auto& bundle(analyzerBundles[bundleIndex]);
-            auto sendReadPair = [&](HtsStreamingReadPairQueue::ReadPair readPair)
-            {
-                if (locusAnalyzerThreadSharedData.readPairQueue.insertReadPair(bundle.locusIndex, std::move(readPair)))
-                {
-                    pool.push(
-                        processLocusAnalyzerQueue, std::ref(locusAnalyzerThreadSharedData),
-                        std::ref(locusAnalyzerThreadLocalDataPool), bundle.locusIndex);
-                }
-            };
-
             if ((bundleIndex + 1) < bundleCount)
             {
-                sendReadPair({ bundle.regionType, bundle.inputType, read, mate });
+                sendReadPair(bundle.locusIndex, { bundle.regionType, bundle.inputType, read, mate });
             }
             else
             {
-                sendReadPair({ bundle.regionType, bundle.inputType, std::move(read), std::move(mate) });
+                sendReadPair(
+                    bundle.locusIndex, { bundle.regionType, bundle.inputType, std::move(read), std::move(mate) });
             }
         }
+
+        if (isEarlyLocusRetirementEnabled)
+        {
+            retireLoci();
+        }
     }
 
-    pool.stop(true);
+    for (auto& pool : pools)
+    {
+        pool->stop(true);
+    }
 
     // Rethrow exceptions from the pool in thread order:
     if (locusAnalyzerThreadSharedData.isWorkerThreadException.load())
@@ -318,21 +594,30 @@ SampleFindings htsStreamingSampleAnalysis(
         }
     }
 
+    if (isEarlyLocusRetirementEnabled)
+    {
+        spdlog::info("Analyzed {} loci during streaming", retiredLocusCount);
+    }
+
+    if (unmappedIrrScreen)
+    {
+        spdlog::info("Sent {} unmapped read pairs to rare-repeat loci", rescuedPairCount);
+    }
+
     spdlog::info("Analyzing read evidence");
 
     SampleFindingsThreadSharedData sampleFindingsThreadSharedData;
     std::vector<SampleFindingsThreadLocalData> sampleFindingsThreadLocalDataPool(threadCount);
 
-    const unsigned locusCount(locusAnalyzerThreadSharedData.locusAnalyzers.size());
-    SampleFindings sampleFindings(locusCount);
+    SampleFindings& sampleFindings(locusAnalyzerThreadSharedData.sampleFindings);
 
     // Start all sampleFindings worker threads
     std::vector<std::thread> sampleFindingsThreads;
     for (int threadIndex(0); threadIndex < threadCount; ++threadIndex)
     {
         sampleFindingsThreads.emplace_back(
-            analyzeLocus, threadIndex, sampleSex, std::ref(locusAnalyzerThreadSharedData.locusAnalyzers),
-            std::ref(sampleFindings), std::ref(sampleFindingsThreadSharedData),
+            analyzeLocus, threadIndex, std::cref(threadPlacement), std::ref(locusAnalyzerThreadSharedData),
+            std::cref(isLocusRetired), std::ref(sampleFindingsThreadSharedData),
             std::ref(sampleFindingsThreadLocalDataPool));
     }
 
@@ -354,7 +639,7 @@ SampleFindings htsStreamingSampleAnalysis(
         sampleFindingsThreads[threadIndex].join();
     }
 
-    return sampleFindings;
+    return std::move(sampleFindings);
 }
 
 }
@@ -28,15 +28,36 @@
 #include "graphio/AlignmentWriter.hh"
 
 #include "core/Parameters.hh"
+#include "io/AlignmentCache.hh"
 #include "locus/LocusAnalyzer.hh"
 #include "locus/LocusFindings.hh"
 #include "locus/LocusSpecification.hh"
+#include "sample/HtsFileStreamer.hh"
+#include "sample/IndexBasedDepthEstimate.hh"
 
 namespace ehunter
 {
 
+/// \param[in] depthEstimate Index-based depth applied to each locus (see LocusAnalyzer::analyze); ignored if null
+/// \param[in] pinThreads Pin worker threads to CPUs spread over the NUMA nodes and route each locus to one node
 SampleFindings htsStreamingSampleAnalysis(
     const InputPaths& inputPaths, Sex sampleSex, const HeuristicParameters& heuristicParams, const int threadCount,
-    const RegionCatalog& regionCatalog, locus::AlignWriterPtr alignmentWriter);
+    const RegionCatalog& regionCatalog, locus::AlignWriterPtr alignmentWriter,
+    AlignmentCacheWriterPtr alignmentCacheWriter, const IndexDepthEstimate* depthEstimate = nullptr,
+    bool pinThreads = false);
+
+/// \brief Analyze reads from an alignment stream that was opened by the caller
+///
+/// This allows the header of input that can only be read once, such as the standard input, to be used for setting up
+/// the analysis before streaming the reads
+///
+SampleFindings htsStreamingSampleAnalysis(
+    htshelpers::HtsFileStreamer& readStreamer, Sex sampleSex, const HeuristicParameters& heuristicParams,
+    const int threadCount, const RegionCatalog& regionCatalog, locus::AlignWriterPtr alignmentWriter,
+    AlignmentCacheWriterPtr alignmentCacheWriter, const IndexDepthEstimate* depthEstimate = nullptr,
+    bool pinThreads = false);
+
+/// Open the alignment file for streaming with decompression threads appropriate for the given thread count
+std::unique_ptr<htshelpers::HtsFileStreamer> openAlignmentStream(const InputPaths& inputPaths, int threadCount);
 
 }
@@ -21,8 +21,8 @@
 
 #include "sample/IndexBasedDepthEstimate.hh"
 
-#include <cassert>
-#include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <unordered_set>
 
 #include <boost/accumulators/accumulators.hpp>
@@ -39,6 +39,7 @@ extern "C"
 
 using std::string;
 using std::unordered_set;
+using std::vector;
 using namespace boost::accumulators;
 
 namespace ehunter
@@ -61,43 +62,106 @@ static bool isAutosome(const string& contigName)
     return false;
 }
 
-double estimateDepthFromHtsIndex(const std::string& htsFilePath, int readLength)
+double IndexDepthEstimate::getLocusDepth(const LocusSpecification& locusSpec) const
 {
-    htsFile* htsFilePtr = sam_open(htsFilePath.c_str(), "r");
+    const auto& targetRegions = locusSpec.targetReadExtractionRegions();
+    if (locusSpec.requiresGenomeWideDepth() || targetRegions.empty())
+    {
+        return genomeWideDepth_;
+    }
+
+    return contigDepth(targetRegions.front().contigIndex());
+}
+
+IndexDepthEstimate computeIndexDepthEstimate(
+    const ReferenceContigInfo& contigInfo, const vector<uint64_t>& mappedReadCounts, int readLength)
+{
+    if (static_cast<int32_t>(mappedReadCounts.size()) != contigInfo.numContigs())
+    {
+        throw std::logic_error("Expected mapped read counts of all contigs");
+    }
+
+    vector<double> contigDepths;
+    contigDepths.reserve(mappedReadCounts.size());
+    accumulator_set<double, features<tag::median>> autosomeDepths;
+    bool hasAutosomes = false;
+
+    for (int32_t contigIndex = 0; contigIndex != contigInfo.numContigs(); ++contigIndex)
+    {
+        const int64_t contigLength = contigInfo.getContigSize(contigIndex);
+        const double contigDepth
+            = contigLength > 0 ? (readLength * mappedReadCounts[contigIndex]) / static_cast<double>(contigLength) : 0;
+        contigDepths.push_back(contigDepth);
+
+        if (isAutosome(contigInfo.getContigName(contigIndex)))
+        {
+            autosomeDepths(contigDepth);
+            hasAutosomes = true;
+        }
+    }
+
+    if (!hasAutosomes)
+    {
+        throw std::runtime_error("Cannot estimate genome-wide depth of a reference without autosomes");
+    }
+
+    return IndexDepthEstimate(median(autosomeDepths), std::move(contigDepths));
+}
+
+IndexDepthEstimate estimateDepthFromHtsIndex(const std::string& htsFilePath, int readLength)
+{
+    std::unique_ptr<htsFile, decltype(&hts_close)> htsFilePtr(sam_open(htsFilePath.c_str(), "r"), hts_close);
     if (!htsFilePtr)
     {
         throw std::runtime_error("Failed to open HTS file " + htsFilePath);
     }
 
-    bam_hdr_t* htsHeaderPtr = sam_hdr_read(htsFilePtr);
+    std::unique_ptr<bam_hdr_t, decltype(&bam_hdr_destroy)> htsHeaderPtr(
+        sam_hdr_read(htsFilePtr.get()), bam_hdr_destroy);
     if (!htsHeaderPtr)
     {
         throw std::runtime_error("Failed to load header of " + htsFilePath);
     }
 
-    hts_idx_t* htsIndexPtr = sam_index_load(htsFilePtr, htsFilePath.c_str());
+    std::unique_ptr<hts_idx_t, decltype(&hts_idx_destroy)> htsIndexPtr(
+        sam_index_load(htsFilePtr.get(), htsFilePath.c_str()), hts_idx_destroy);
     if (!htsIndexPtr)
     {
         throw std::runtime_error("Failed to load index of " + htsFilePath);
     }
 
-    const auto contigInfo = htshelpers::decodeContigInfo(htsHeaderPtr);
-
-    accumulator_set<double, features<tag::median>> contigDepths;
+    const auto contigInfo = htshelpers::decodeContigInfo(htsHeaderPtr.get());
 
+    // Contigs without reads may lack statistics, while CRAM indexes do not store them for any contig
+    vector<uint64_t> mappedReadCounts(contigInfo.numContigs(), 0);
+    bool hasReadCounts = false;
     for (int contigIndex = 0; contigIndex != contigInfo.numContigs(); ++contigIndex)
     {
         uint64_t numMappedReads, numUnmappedReads;
-        hts_idx_get_stat(htsIndexPtr, contigIndex, &numMappedReads, &numUnmappedReads);
-        if (isAutosome(contigInfo.getContigName(contigIndex)))
+        if (hts_idx_get_stat(htsIndexPtr.get(), contigIndex, &numMappedReads, &numUnmappedReads) == 0)
         {
-            const int64_t contigLength = contigInfo.getContigSize(contigIndex);
-            const double contigDepth = (readLength * numMappedReads) / static_cast<double>(contigLength);
-            contigDepths(contigDepth);
+            mappedReadCounts[contigIndex] = numMappedReads;
+            hasReadCounts = true;
         }
     }
 
-    return median(contigDepths);
+    if (!hasReadCounts)
+    {
+        throw std::runtime_error("Index of " + htsFilePath + " does not contain mapped read counts");
+    }
+
+    return computeIndexDepthEstimate(contigInfo, mappedReadCounts, readLength);
+}
+
+boost::optional<double>
+getIndexBasedLocusDepth(const IndexDepthEstimate* depthEstimate, const LocusSpecification& locusSpec)
+{
+    if (!depthEstimate)
+    {
+        return boost::none;
+    }
+
+    return depthEstimate->getLocusDepth(locusSpec);
 }
 
 }
@@ -21,11 +21,56 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "core/ReferenceContigInfo.hh"
+#include "locus/LocusSpecification.hh"
 
 namespace ehunter
 {
 
-double estimateDepthFromHtsIndex(const std::string& htsFilePath, int readLength);
+/// Read depth of a sample estimated from the mapped read counts stored in the index of its alignment file
+class IndexDepthEstimate
+{
+public:
+    IndexDepthEstimate(double genomeWideDepth, std::vector<double> contigDepths)
+        : genomeWideDepth_(genomeWideDepth)
+        , contigDepths_(std::move(contigDepths))
+    {
+    }
+
+    /// Median depth of the autosomes
+    double genomeWideDepth() const { return genomeWideDepth_; }
+    double contigDepth(int32_t contigIndex) const { return contigDepths_.at(contigIndex); }
+
+    /// \brief Index-based depth of the given locus
+    ///
+    /// Loci requiring genome-wide depth (such as SMN) get the genome-wide depth, which they are genotyped with. Other
+    /// loci get the depth of the contig they are located on, which only caps the depth estimated from their reads.
+    ///
+    double getLocusDepth(const LocusSpecification& locusSpec) const;
+
+private:
+    double genomeWideDepth_;
+    std::vector<double> contigDepths_;
+};
+
+/// \brief Compute contig and genome-wide depths from the number of reads mapped to each contig
+///
+/// \param[in] mappedReadCounts Number of mapped reads of each contig listed in the contig info
+///
+IndexDepthEstimate computeIndexDepthEstimate(
+    const ReferenceContigInfo& contigInfo, const std::vector<uint64_t>& mappedReadCounts, int readLength);
+
+/// Estimate depth from the BAI, CSI, or CRAI index of an alignment file without reading any alignments
+IndexDepthEstimate estimateDepthFromHtsIndex(const std::string& htsFilePath, int readLength);
+
+/// Depth of the given locus if an index-based estimate is available
+boost::optional<double>
+getIndexBasedLocusDepth(const IndexDepthEstimate* depthEstimate, const LocusSpecification& locusSpec);
 
 }
@@ -0,0 +1,142 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/LocusRetirementTracker.hh"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using std::vector;
+
+namespace ehunter
+{
+
+LocusRetirementTracker::LocusRetirementTracker(
+    const RegionCatalog& regionCatalog, int64_t mateDistanceWindow, const vector<unsigned>& lociKeptOpen)
+    : pendingReadCounts_(regionCatalog.size(), 0)
+    , isCursorPastLocus_(regionCatalog.size(), false)
+{
+    vector<bool> isLocusKeptOpen(regionCatalog.size(), false);
+    for (const unsigned locusIndex : lociKeptOpen)
+    {
+        isLocusKeptOpen[locusIndex] = true;
+    }
+
+    const unsigned locusCount(regionCatalog.size());
+    for (unsigned locusIndex(0); locusIndex < locusCount; ++locusIndex)
+    {
+        const LocusSpecification& locusSpec = regionCatalog[locusIndex];
+        if (isLocusKeptOpen[locusIndex] || !locusSpec.offtargetReadExtractionRegions().empty()
+            || locusSpec.targetReadExtractionRegions().empty())
+        {
+            continue;
+        }
+
+        RetirementPoint point = { -1, -1, locusIndex };
+        for (const auto& region : locusSpec.targetReadExtractionRegions())
+        {
+            const int64_t regionRetirementPosition = region.end() + mateDistanceWindow;
+            if (region.contigIndex() > point.contigIndex
+                || (region.contigIndex() == point.contigIndex && regionRetirementPosition > point.position))
+            {
+                point.contigIndex = region.contigIndex();
+                point.position = regionRetirementPosition;
+            }
+        }
+        retirementPoints_.push_back(point);
+    }
+
+    std::sort(
+        retirementPoints_.begin(), retirementPoints_.end(),
+        [](const RetirementPoint& point1, const RetirementPoint& point2)
+        {
+            if (point1.contigIndex != point2.contigIndex)
+            {
+                return point1.contigIndex < point2.contigIndex;
+            }
+            return point1.position < point2.position;
+        });
+}
+
+void LocusRetirementTracker::advance(int32_t contigIndex, int64_t position, vector<unsigned>& retiredLoci)
+{
+    if (contigIndex < cursorContigIndex_ || (contigIndex == cursorContigIndex_ && position < cursorPosition_))
+    {
+        throw std::runtime_error(
+            "Alignment file is not coordinate-sorted: encountered position " + std::to_string(position)
+            + " on contig index " + std::to_string(contigIndex) + " after position " + std::to_string(cursorPosition_)
+            + " on contig index " + std::to_string(cursorContigIndex_));
+    }
+    cursorContigIndex_ = contigIndex;
+    cursorPosition_ = position;
+
+    while (nextRetirementPointIndex_ < retirementPoints_.size())
+    {
+        const RetirementPoint& point = retirementPoints_[nextRetirementPointIndex_];
+        const bool isCursorPastPoint
+            = point.contigIndex < contigIndex || (point.contigIndex == contigIndex && point.position < position);
+        if (!isCursorPastPoint)
+        {
+            break;
+        }
+
+        isCursorPastLocus_[point.locusIndex] = true;
+        if (pendingReadCounts_[point.locusIndex] == 0)
+        {
+            retiredLoci.push_back(point.locusIndex);
+        }
+        ++nextRetirementPointIndex_;
+    }
+}
+
+void LocusRetirementTracker::addPendingRead(const std::string& fragmentId, const vector<unsigned>& locusIndexes)
+{
+    if (locusIndexes.empty())
+    {
+        return;
+    }
+
+    for (const unsigned locusIndex : locusIndexes)
+    {
+        ++pendingReadCounts_[locusIndex];
+    }
+    pendingReads_.emplace(fragmentId, locusIndexes);
+}
+
+void LocusRetirementTracker::removePendingRead(const std::string& fragmentId, vector<unsigned>& retiredLoci)
+{
+    const auto pendingReadIterator = pendingReads_.find(fragmentId);
+    if (pendingReadIterator == pendingReads_.end())
+    {
+        return;
+    }
+
+    for (const unsigned locusIndex : pendingReadIterator->second)
+    {
+        --pendingReadCounts_[locusIndex];
+        if (pendingReadCounts_[locusIndex] == 0 && isCursorPastLocus_[locusIndex])
+        {
+            retiredLoci.push_back(locusIndex);
+        }
+    }
+    pendingReads_.erase(pendingReadIterator);
+}
+
+}
@@ -0,0 +1,84 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "locus/LocusSpecification.hh"
+
+namespace ehunter
+{
+
+/// \brief Determines when a locus can be finalized while streaming a coordinate-sorted alignment file
+///
+/// A locus is retired once the stream has moved past the end of its last read extraction region (plus the
+/// mate-distance window) and no read that could still be paired into one of its extraction regions is waiting for its
+/// mate. Loci with offtarget regions are never retired early, because relevant read pairs can be completed anywhere in
+/// the genome.
+///
+class LocusRetirementTracker
+{
+public:
+    /// \param[in] lociKeptOpen Indexes of loci that are never retired early, such as loci receiving read pairs from
+    /// the unmapped reads at the end of the file
+    LocusRetirementTracker(
+        const RegionCatalog& regionCatalog, int64_t mateDistanceWindow,
+        const std::vector<unsigned>& lociKeptOpen = std::vector<unsigned>());
+
+    /// \brief Move the stream cursor to the given position
+    ///
+    /// \param[out] retiredLoci Indexes of loci which became ready for retirement are appended to this list
+    ///
+    void advance(int32_t contigIndex, int64_t position, std::vector<unsigned>& retiredLoci);
+
+    /// Register a read which is waiting for its mate and is contained in extraction regions of \p locusIndexes
+    void addPendingRead(const std::string& fragmentId, const std::vector<unsigned>& locusIndexes);
+
+    /// \brief Unregister a read previously registered with addPendingRead; has no effect for unregistered reads
+    ///
+    /// \param[out] retiredLoci Indexes of loci which became ready for retirement are appended to this list
+    ///
+    void removePendingRead(const std::string& fragmentId, std::vector<unsigned>& retiredLoci);
+
+    unsigned numRetirableLoci() const { return retirementPoints_.size(); }
+
+private:
+    struct RetirementPoint
+    {
+        int32_t contigIndex;
+        int64_t position;
+        unsigned locusIndex;
+    };
+
+    std::vector<RetirementPoint> retirementPoints_;
+    unsigned nextRetirementPointIndex_ = 0;
+
+    std::unordered_map<std::string, std::vector<unsigned>> pendingReads_;
+    std::vector<int> pendingReadCounts_;
+    std::vector<bool> isCursorPastLocus_;
+
+    int32_t cursorContigIndex_ = -1;
+    int64_t cursorPosition_ = -1;
+};
+
+}
@@ -0,0 +1,405 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/SampleAnalysis.hh"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "spdlog/spdlog.h"
+
+#include "app/Version.hh"
+#include "io/AlignmentCache.hh"
+#include "io/BamletWriter.hh"
+#include "io/JsonWriter.hh"
+#include "io/SampleStats.hh"
+#include "io/VcfWriter.hh"
+#include "sample/AlignmentCacheSampleAnalysis.hh"
+#include "sample/HtsEvidenceExtraction.hh"
+#include "sample/HtsSeekingSampleAnalysis.hh"
+#include "sample/HtsStreamingSampleAnalysis.hh"
+#include "sample/IndexBasedDepthEstimate.hh"
+
+namespace ehunter
+{
+
+namespace
+{
+
+template <typename T> void writeToFile(std::string fileName, T streamable)
+{
+    std::ofstream out;
+
+    out.open(fileName.c_str());
+    if (!out.is_open())
+    {
+        throw std::runtime_error("Failed to open " + fileName + " for writing (" + strerror(errno) + ")");
+    }
+
+    out << streamable;
+}
+
+/// Identifies the alignment file by its path, size, and modification time; URLs and streams are identified by the path
+std::string computeSampleFingerprint(const std::string& htsFilePath)
+{
+    std::ostringstream fingerprint;
+    fingerprint << htsFilePath;
+    if (!isURL(htsFilePath) && !isStreamOnlyPath(htsFilePath))
+    {
+        const boost::filesystem::path path(htsFilePath);
+        fingerprint << '|' << boost::filesystem::file_size(path) << '|' << boost::filesystem::last_write_time(path);
+    }
+    return fingerprint.str();
+}
+
+/// \brief Compute the alignment cache keys of all loci
+///
+/// A key changes whenever the alignment-relevant part of the locus definition, the settings affecting read alignment,
+/// or the program version change, so a cached record can be reused only if its key matches. Genotyping parameters are
+/// not part of the key, so cached records can be re-genotyped with different settings. The alignment file is
+/// identified by the sample fingerprint in the cache header instead, so that a cache can be genotyped without it.
+///
+AlignmentCacheKeys computeAlignmentCacheKeys(const ProgramParameters& params, const RegionCatalog& regionCatalog)
+{
+    const HeuristicParameters& heuristics = params.heuristics();
+    std::ostringstream settings;
+    settings << kProgramVersion << '|' << heuristics.regionExtensionLength() << ' '
+             << heuristics.qualityCutoffForGoodBaseCall() << ' ' << heuristics.skipUnaligned() << ' '
+             << static_cast<int>(heuristics.alignerType()) << ' ' << heuristics.kmerLenForAlignment() << ' '
+             << heuristics.paddingLength() << ' ' << heuristics.seedAffixTrimLength() << ' '
+             << heuristics.orientationPredictorKmerLen() << ' ' << heuristics.orientationPredictorMinKmerCount() << ' '
+             << heuristics.trimLowQualityEnds() << ' ' << heuristics.alignInRepeatReadsDirectly();
+    return computeAlignmentCacheKeys(regionCatalog, computeStableHash(settings.str()));
+}
+
+/// Check that an alignment cache was written for the given alignment file unless the file is not available
+void assertAlignmentCacheMatchesSample(const std::string& alignmentCachePath, const std::string& htsFilePath)
+{
+    const boost::optional<std::string> cachedFingerprint = AlignmentCacheReader(alignmentCachePath).sampleFingerprint();
+    if (!cachedFingerprint)
+    {
+        return;
+    }
+
+    if (!isURL(htsFilePath) && !boost::filesystem::exists(htsFilePath))
+    {
+        spdlog::info(
+            "Alignment file {} is not available; genotyping from the alignment cache written for {}", htsFilePath,
+            *cachedFingerprint);
+        return;
+    }
+
+    if (computeSampleFingerprint(htsFilePath) != *cachedFingerprint)
+    {
+        throw std::runtime_error(
+            "Alignment cache " + alignmentCachePath + " was written for a different alignment file ("
+            + *cachedFingerprint + "); rebuild the cache with --write-alignment-cache");
+    }
+}
+
+SampleQcSummary runSampleQcPass(const InputPaths& inputPaths)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    SampleQcSummary sampleQc = runSampleQc(inputPaths.htsFile(), inputPaths.reference());
+    const auto elapsedTime
+        = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    spdlog::info(
+        "Sample QC sampled {} reads in {} ms; read length {}-{} (median {}), median fragment length {}",
+        sampleQc.sampledReadCount, elapsedTime.count(), sampleQc.minReadLength, sampleQc.maxReadLength,
+        sampleQc.medianReadLength, sampleQc.medianFragmentLength);
+    if (sampleQc.minReadLength != sampleQc.maxReadLength)
+    {
+        spdlog::warn("Reads of the sample have different lengths; loci use the mean length of their own reads");
+    }
+
+    return sampleQc;
+}
+
+SampleFindings analyzeAlignmentFile(
+    const ProgramParameters& params, const Sex sampleSex, const RegionCatalog& regionCatalog,
+    locus::AlignWriterPtr bamletWriter, AlignmentCacheWriterPtr alignmentCacheWriter,
+    const IndexDepthEstimate* depthEstimate, htshelpers::HtsFileStreamer* readStreamer = nullptr)
+{
+    const InputPaths& inputPaths = params.inputPaths();
+    const HeuristicParameters& heuristicParams = params.heuristics();
+
+    if (readStreamer)
+    {
+        spdlog::info("Running sample analysis in streaming mode on an open alignment stream");
+        return htsStreamingSampleAnalysis(
+            *readStreamer, sampleSex, heuristicParams, params.threadCount, regionCatalog, bamletWriter,
+            alignmentCacheWriter, depthEstimate, params.pinThreads);
+    }
+    else if (params.analysisMode() == AnalysisMode::kSeeking)
+    {
+        spdlog::info("Running sample analysis in seeking mode");
+        return htsSeekingSampleAnalysis(
+            inputPaths, sampleSex, heuristicParams, params.threadCount, regionCatalog, bamletWriter,
+            alignmentCacheWriter, depthEstimate, params.pinThreads, params.prefetchLoci);
+    }
+    else
+    {
+        spdlog::info("Running sample analysis in streaming mode");
+        return htsStreamingSampleAnalysis(
+            inputPaths, sampleSex, heuristicParams, params.threadCount, regionCatalog, bamletWriter,
+            alignmentCacheWriter, depthEstimate, params.pinThreads);
+    }
+}
+
+/// \brief Resume an interrupted run or update an earlier run
+///
+/// Loci recorded in the alignment cache of the earlier run with a matching key are genotyped from the cache; the
+/// remaining loci, including those whose definition changed since the earlier run, are analyzed from the alignment file
+/// and appended to the cache. If the alignment file differs from the one recorded in the cache header, all loci are
+/// analyzed again and the cache is replaced. The reason each locus is analyzed again is logged.
+///
+SampleFindings resumeAnalysis(
+    const ProgramParameters& params, const Sex sampleSex, const RegionCatalog& regionCatalog,
+    locus::AlignWriterPtr bamletWriter, const IndexDepthEstimate* depthEstimate)
+{
+    const std::string& alignmentCachePath = params.outputPaths().alignmentCache();
+    const std::string sampleFingerprint = computeSampleFingerprint(params.inputPaths().htsFile());
+    AlignmentCacheKeys locusKeys = computeAlignmentCacheKeys(params, regionCatalog);
+
+    bool isCacheReusable = isAlignmentCachePresent(alignmentCachePath);
+    if (!isCacheReusable)
+    {
+        spdlog::info("No alignment cache found at {}; starting a new analysis", alignmentCachePath);
+    }
+    else
+    {
+        const boost::optional<std::string> cachedFingerprint
+            = AlignmentCacheReader(alignmentCachePath).sampleFingerprint();
+        if (!cachedFingerprint)
+        {
+            spdlog::info(
+                "All {} loci are analyzed again because alignment cache {} does not record the alignment file it was "
+                "written for",
+                regionCatalog.size(), alignmentCachePath);
+            isCacheReusable = false;
+        }
+        else if (*cachedFingerprint != sampleFingerprint)
+        {
+            spdlog::info(
+                "All {} loci are analyzed again because the alignment file changed since alignment cache {} was "
+                "written (was {}, now {})",
+                regionCatalog.size(), alignmentCachePath, *cachedFingerprint, sampleFingerprint);
+            isCacheReusable = false;
+        }
+    }
+
+    if (!isCacheReusable)
+    {
+        const bool append(false);
+        AlignmentCacheWriterPtr alignmentCacheWriter(
+            new AlignmentCacheWriter(alignmentCachePath, append, std::move(locusKeys), sampleFingerprint));
+        return analyzeAlignmentFile(
+            params, sampleSex, regionCatalog, bamletWriter, alignmentCacheWriter, depthEstimate);
+    }
+
+    RegionCatalog completedLoci;
+    RegionCatalog pendingLoci;
+    std::vector<unsigned> completedLocusIndexes;
+    std::vector<unsigned> pendingLocusIndexes;
+    int outdatedLocusCount = 0;
+    {
+        const AlignmentCacheReader cacheReader(alignmentCachePath);
+        for (unsigned locusIndex(0); locusIndex < regionCatalog.size(); ++locusIndex)
+        {
+            const auto& locusSpec = regionCatalog[locusIndex];
+            const std::string& locusId = locusSpec.locusId();
+            const std::string& locusKey = locusKeys.at(locusId);
+            if (cacheReader.contains(locusId, locusKey))
+            {
+                completedLoci.push_back(locusSpec);
+                completedLocusIndexes.push_back(locusIndex);
+                continue;
+            }
+
+            pendingLoci.push_back(locusSpec);
+            pendingLocusIndexes.push_back(locusIndex);
+            const boost::optional<std::string> cachedKey = cacheReader.locusKey(locusId);
+            if (cachedKey)
+            {
+                spdlog::info(
+                    "Locus {} is analyzed again because its {}", locusId,
+                    describeAlignmentCacheKeyChange(*cachedKey, locusKey));
+                ++outdatedLocusCount;
+            }
+            else if (cacheReader.contains(locusId))
+            {
+                spdlog::info("Locus {} is analyzed again because its cached record has no key", locusId);
+                ++outdatedLocusCount;
+            }
+            else
+            {
+                spdlog::debug("Locus {} was not completed earlier", locusId);
+            }
+        }
+    }
+    spdlog::info(
+        "Resuming analysis; {} of {} loci were completed earlier with unchanged inputs, {} have outdated records, and "
+        "{} were not completed earlier",
+        completedLoci.size(), regionCatalog.size(), outdatedLocusCount,
+        pendingLoci.size() - static_cast<size_t>(outdatedLocusCount));
+
+    SampleFindings sampleFindings(regionCatalog.size());
+    SampleFindings completedFindings = alignmentCacheSampleAnalysis(
+        alignmentCachePath, locusKeys, sampleSex, params.heuristics(), params.threadCount, completedLoci, bamletWriter,
+        depthEstimate);
+    for (unsigned completedIndex(0); completedIndex < completedLocusIndexes.size(); ++completedIndex)
+    {
+        sampleFindings[completedLocusIndexes[completedIndex]] = std::move(completedFindings[completedIndex]);
+    }
+
+    if (!pendingLoci.empty())
+    {
+        const bool append(true);
+        AlignmentCacheWriterPtr alignmentCacheWriter(
+            new AlignmentCacheWriter(alignmentCachePath, append, std::move(locusKeys), sampleFingerprint));
+        SampleFindings pendingFindings = analyzeAlignmentFile(
+            params, sampleSex, pendingLoci, bamletWriter, alignmentCacheWriter, depthEstimate);
+        for (unsigned pendingIndex(0); pendingIndex < pendingLocusIndexes.size(); ++pendingIndex)
+        {
+            sampleFindings[pendingLocusIndexes[pendingIndex]] = std::move(pendingFindings[pendingIndex]);
+        }
+    }
+
+    return sampleFindings;
+}
+
+}
+
+void analyzeSample(
+    const ProgramParameters& params, FastaReference& reference, const RegionCatalog& regionCatalog,
+    htshelpers::HtsFileStreamer* readStreamer, const VariantRecordTemplates* recordTemplates)
+{
+    const InputPaths& inputPaths = params.inputPaths();
+    const HeuristicParameters& heuristicParams = params.heuristics();
+    const OutputPaths& outputPaths = params.outputPaths();
+
+    if (params.analysisMode() == AnalysisMode::kExtract)
+    {
+        spdlog::info("Extracting read evidence to {}", outputPaths.evidence());
+        htsEvidenceExtraction(inputPaths, regionCatalog, outputPaths.evidence());
+        return;
+    }
+
+    locus::AlignWriterPtr bamletWriter;
+    if (params.disableBamletOutput)
+    {
+        bamletWriter.reset(new graphtools::BlankAlignmentWriter());
+    }
+    else
+    {
+        bamletWriter.reset(new BamletWriter(outputPaths.bamlet(), reference.contigInfo(), regionCatalog));
+    }
+
+    boost::optional<SampleQcSummary> sampleQc;
+    if (params.inferSampleSex)
+    {
+        sampleQc = runSampleQcPass(inputPaths);
+    }
+
+    SampleParameters sampleParams = params.sample();
+    if (params.inferSampleSex && sampleQc->inferredSex)
+    {
+        sampleParams = SampleParameters(sampleParams.id(), *sampleQc->inferredSex);
+        spdlog::info("Inferred sex of the sample is {}", streamToString(sampleParams.sex()));
+    }
+    else if (params.inferSampleSex)
+    {
+        spdlog::warn(
+            "Sex of the sample could not be inferred because chromosome X is not covered by reads or is missing from "
+            "the reference; assuming the sample is {}",
+            streamToString(sampleParams.sex()));
+    }
+
+    boost::optional<IndexDepthEstimate> depthEstimate;
+    if (params.depthSource == DepthSource::kIndex)
+    {
+        // Without the sample QC pass, the read length is taken from the first read of the alignment file
+        const int readLength = sampleQc ? sampleQc->medianReadLength
+                                        : extractReadLength(inputPaths.htsFile(), inputPaths.reference());
+        depthEstimate = estimateDepthFromHtsIndex(inputPaths.htsFile(), readLength);
+        spdlog::info("Genome-wide depth estimated from the alignment file index: {}", depthEstimate->genomeWideDepth());
+    }
+    const IndexDepthEstimate* depthEstimatePtr = depthEstimate ? &*depthEstimate : nullptr;
+
+    SampleFindings sampleFindings;
+    if (inputPaths.alignmentCache())
+    {
+        spdlog::info("Running sample analysis from alignment cache {}", *inputPaths.alignmentCache());
+        assertAlignmentCacheMatchesSample(*inputPaths.alignmentCache(), inputPaths.htsFile());
+        sampleFindings = alignmentCacheSampleAnalysis(
+            *inputPaths.alignmentCache(), computeAlignmentCacheKeys(params, regionCatalog), sampleParams.sex(),
+            heuristicParams, params.threadCount, regionCatalog, bamletWriter, depthEstimatePtr);
+    }
+    else if (params.resume)
+    {
+        sampleFindings = resumeAnalysis(params, sampleParams.sex(), regionCatalog, bamletWriter, depthEstimatePtr);
+    }
+    else
+    {
+        AlignmentCacheWriterPtr alignmentCacheWriter;
+        if (params.writeAlignmentCache)
+        {
+            const bool append(false);
+            alignmentCacheWriter.reset(new AlignmentCacheWriter(
+                outputPaths.alignmentCache(), append, computeAlignmentCacheKeys(params, regionCatalog),
+                computeSampleFingerprint(inputPaths.htsFile())));
+        }
+        sampleFindings = analyzeAlignmentFile(
+            params, sampleParams.sex(), regionCatalog, bamletWriter, alignmentCacheWriter, depthEstimatePtr,
+            readStreamer);
+    }
+
+    spdlog::info("Writing output to disk");
+    std::unique_ptr<VariantRecordTemplates> catalogRecordTemplates;
+    if (!recordTemplates)
+    {
+        catalogRecordTemplates.reset(new VariantRecordTemplates(reference, regionCatalog));
+        recordTemplates = catalogRecordTemplates.get();
+    }
+
+    VcfWriter vcfWriter(sampleParams.id(), *recordTemplates, regionCatalog, sampleFindings);
+    writeToFile(outputPaths.vcf(), vcfWriter);
+
+    boost::optional<double> genomeWideDepth;
+    if (depthEstimate)
+    {
+        genomeWideDepth = depthEstimate->genomeWideDepth();
+    }
+    JsonWriter jsonWriter(
+        sampleParams, *recordTemplates, regionCatalog, sampleFindings, genomeWideDepth,
+        sampleQc ? &*sampleQc : nullptr);
+    writeToFile(outputPaths.json(), jsonWriter);
+}
+
+}
@@ -0,0 +1,44 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#pragma once
+
+#include "core/Parameters.hh"
+#include "core/Reference.hh"
+#include "io/VariantRecordTemplates.hh"
+#include "locus/LocusSpecification.hh"
+#include "sample/HtsFileStreamer.hh"
+
+namespace ehunter
+{
+
+/// \brief Run the analysis requested by the program parameters on a single sample and write the output files
+///
+/// \param[in] reference Reference with contig info matching the alignment file of the sample
+/// \param[in] regionCatalog Loci to analyze
+/// \param[in] readStreamer Alignment stream already opened by the caller for input that can only be read once; such
+/// input is analyzed in streaming mode
+/// \param[in] recordTemplates Output record templates of a catalog containing all analyzed loci; rendered from the
+/// given catalog if not provided
+///
+void analyzeSample(
+    const ProgramParameters& params, FastaReference& reference, const RegionCatalog& regionCatalog,
+    htshelpers::HtsFileStreamer* readStreamer = nullptr, const VariantRecordTemplates* recordTemplates = nullptr);
+
+}
@@ -0,0 +1,212 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "sample/UnmappedIrrScreen.hh"
+
+#include <algorithm>
+#include <iterator>
+
+#include "graphutils/SequenceOperations.hh"
+
+using std::string;
+using std::vector;
+
+namespace ehunter
+{
+
+namespace
+{
+
+const int kKmerLength = 8;
+const uint32_t kKmerMask = (1u << (2 * kKmerLength)) - 1;
+
+// Sequencing errors and low-quality base calls break k-mers, so the match cutoff is well below the purity cutoff of
+// the IRR pair finders
+const double kMinKmerMatchFraction = 0.3;
+
+int encodeBase(char base)
+{
+    switch (base)
+    {
+    case 'A':
+    case 'a':
+        return 0;
+    case 'C':
+    case 'c':
+        return 1;
+    case 'G':
+    case 'g':
+        return 2;
+    case 'T':
+    case 't':
+        return 3;
+    default:
+        return -1;
+    }
+}
+
+/// Calls the function on each packed k-mer of the sequence; k-mers containing bases other than ACGT are skipped
+template <typename KmerFunction> void forEachKmer(const string& sequence, KmerFunction kmerFunction)
+{
+    uint32_t kmer = 0;
+    int validBaseCount = 0;
+    for (const char base : sequence)
+    {
+        const int baseCode = encodeBase(base);
+        if (baseCode == -1)
+        {
+            validBaseCount = 0;
+            continue;
+        }
+
+        kmer = ((kmer << 2) | static_cast<uint32_t>(baseCode)) & kKmerMask;
+        if (++validBaseCount >= kKmerLength)
+        {
+            kmerFunction(kmer);
+        }
+    }
+}
+
+}
+
+UnmappedIrrScreen::UnmappedIrrScreen(const RegionCatalog& regionCatalog)
+{
+    const unsigned locusCount(regionCatalog.size());
+    for (unsigned locusIndex(0); locusIndex < locusCount; ++locusIndex)
+    {
+        const LocusSpecification& locusSpec = regionCatalog[locusIndex];
+        for (const auto& variantSpec : locusSpec.variantSpecs())
+        {
+            if (variantSpec.classification().subtype != VariantSubtype::kRareRepeat)
+            {
+                continue;
+            }
+
+            const string& motif = locusSpec.regionGraph().nodeSeq(variantSpec.nodes().front());
+            const auto motifIterator = std::find(motifs_.begin(), motifs_.end(), motif);
+            const unsigned motifIndex = std::distance(motifs_.begin(), motifIterator);
+            if (motifIterator == motifs_.end())
+            {
+                motifs_.push_back(motif);
+                motifLocusIndexes_.emplace_back();
+                addMotifKmers(motif, motifIndex);
+            }
+            motifLocusIndexes_[motifIndex].push_back(locusIndex);
+        }
+    }
+}
+
+void UnmappedIrrScreen::addMotifKmers(const string& motif, unsigned motifIndex)
+{
+    for (const string& unit : { motif, graphtools::reverseComplement(motif) })
+    {
+        // Each rotation of the unit starts one of the first unit-length k-mers of the repeated unit
+        string repeat;
+        while (repeat.length() < unit.length() + kKmerLength - 1)
+        {
+            repeat += unit;
+        }
+        repeat.resize(unit.length() + kKmerLength - 1);
+
+        forEachKmer(
+            repeat,
+            [&](uint32_t kmer)
+            {
+                vector<unsigned>& motifIndexes = kmerToMotifIndexes_[kmer];
+                if (motifIndexes.empty() || motifIndexes.back() != motifIndex)
+                {
+                    motifIndexes.push_back(motifIndex);
+                }
+            });
+    }
+}
+
+vector<unsigned> UnmappedIrrScreen::targetLoci() const
+{
+    vector<unsigned> locusIndexes;
+    for (const auto& motifLocusIndexes : motifLocusIndexes_)
+    {
+        locusIndexes.insert(locusIndexes.end(), motifLocusIndexes.begin(), motifLocusIndexes.end());
+    }
+    std::sort(locusIndexes.begin(), locusIndexes.end());
+    locusIndexes.erase(std::unique(locusIndexes.begin(), locusIndexes.end()), locusIndexes.end());
+    return locusIndexes;
+}
+
+vector<unsigned> UnmappedIrrScreen::screenSequence(const string& sequence) const
+{
+    if (sequence.length() < static_cast<size_t>(kKmerLength))
+    {
+        return {};
+    }
+
+    vector<int> matchCounts(motifs_.size(), 0);
+    forEachKmer(
+        sequence,
+        [&](uint32_t kmer)
+        {
+            const auto kmerIterator = kmerToMotifIndexes_.find(kmer);
+            if (kmerIterator != kmerToMotifIndexes_.end())
+            {
+                for (const unsigned motifIndex : kmerIterator->second)
+                {
+                    ++matchCounts[motifIndex];
+                }
+            }
+        });
+
+    const double kmerCount = sequence.length() - kKmerLength + 1;
+    vector<unsigned> matchedMotifIndexes;
+    for (unsigned motifIndex(0); motifIndex != matchCounts.size(); ++motifIndex)
+    {
+        if (matchCounts[motifIndex] >= kMinKmerMatchFraction * kmerCount)
+        {
+            matchedMotifIndexes.push_back(motifIndex);
+        }
+    }
+
+    return matchedMotifIndexes;
+}
+
+vector<unsigned> UnmappedIrrScreen::findCandidateLoci(const string& read, const string& mate) const
+{
+    const vector<unsigned> readMotifIndexes = screenSequence(read);
+    if (readMotifIndexes.empty())
+    {
+        return {};
+    }
+    const vector<unsigned> mateMotifIndexes = screenSequence(mate);
+
+    vector<unsigned> sharedMotifIndexes;
+    std::set_intersection(
+        readMotifIndexes.begin(), readMotifIndexes.end(), mateMotifIndexes.begin(), mateMotifIndexes.end(),
+        std::back_inserter(sharedMotifIndexes));
+
+    vector<unsigned> locusIndexes;
+    for (const unsigned motifIndex : sharedMotifIndexes)
+    {
+        const auto& motifLocusIndexes = motifLocusIndexes_[motifIndex];
+        locusIndexes.insert(locusIndexes.end(), motifLocusIndexes.begin(), motifLocusIndexes.end());
+    }
+    std::sort(locusIndexes.begin(), locusIndexes.end());
+    return locusIndexes;
+}
+
+}
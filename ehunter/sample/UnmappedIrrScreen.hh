@@ -0,0 +1,66 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "locus/LocusSpecification.hh"
+
+namespace ehunter
+{
+
+/// \brief Screens unmapped read pairs for in-repeat reads of loci with rare repeats
+///
+/// Both reads of a pair are screened with an index of packed k-mers of the repeat units (all rotations on both
+/// strands): a read matches a repeat unit if a sufficient fraction of its k-mers belongs to that unit. The screen is
+/// only a fast prefilter; read pairs it passes are checked by the IRR pair finders of the matching loci.
+///
+class UnmappedIrrScreen
+{
+public:
+    explicit UnmappedIrrScreen(const RegionCatalog& regionCatalog);
+
+    /// True if the catalog contains no loci with rare repeats
+    bool empty() const { return motifLocusIndexes_.empty(); }
+
+    /// Indexes of loci with rare repeats in catalog order
+    std::vector<unsigned> targetLoci() const;
+
+    /// True if the read matches the repeat unit of any locus
+    bool isCandidateRead(const std::string& read) const { return !screenSequence(read).empty(); }
+
+    /// Indexes of loci whose repeat unit matches both reads of the pair
+    std::vector<unsigned> findCandidateLoci(const std::string& read, const std::string& mate) const;
+
+private:
+    /// Indexes of repeat units matched by the sequence
+    std::vector<unsigned> screenSequence(const std::string& sequence) const;
+    void addMotifKmers(const std::string& motif, unsigned motifIndex);
+
+    std::vector<std::string> motifs_;
+    std::vector<std::vector<unsigned>> motifLocusIndexes_;
+    std::unordered_map<uint32_t, std::vector<unsigned>> kmerToMotifIndexes_;
+};
+
+}
@@ -0,0 +1,103 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/AlignmentCacheSampleAnalysis.hh"
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+#include "locus/VariantFindings.hh"
+
+using namespace ehunter;
+using namespace locus;
+
+using graphtools::AlignerType;
+
+static RegionCatalog buildStrCatalog(const GenotyperParameters& params)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    NodeToRegionAssociation dummyAssociation;
+    LocusSpecification locusSpec(
+        "locus", ChromType::kAutosome, { GenomicRegion(1, 0, 1000) }, graph, dummyAssociation, params, false);
+    VariantClassification classification(VariantType::kRepeat, VariantSubtype::kCommonRepeat);
+    locusSpec.addVariantSpecification("repeat", classification, GenomicRegion(1, 500, 501), { 1 }, 1);
+    return { locusSpec };
+}
+
+TEST(GenotypingFromAlignmentCache, ChangedGenotypingParameters_CacheReused)
+{
+    const uint64_t alignmentSettingsHash = 12345;
+    // The locus is too shallow to be genotyped with the original minimal locus coverage
+    const RegionCatalog originalCatalog = buildStrCatalog(GenotyperParameters(1000));
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER, 4, 1, 5, 4, 1);
+    auto writer = std::make_shared<graphtools::BlankAlignmentWriter>();
+    const std::string cachePath = ::testing::TempDir() + "GenotypingFromAlignmentCache.alignment_cache";
+
+    {
+        graphtools::AlignerSelector selector(heuristicParams.alignerType());
+        LocusAnalyzer locusAnalyzer(originalCatalog.front(), heuristicParams, writer);
+        locusAnalyzer.enableAlignmentRecording();
+        Read read(ReadId("read1", MateNumber::kFirstMate), "CGACCCATGT", true);
+        Read mate(ReadId("read1", MateNumber::kSecondMate), "GACCCATGTC", true);
+        locusAnalyzer.processMates(read, &mate, RegionType::kTarget, selector);
+
+        AlignmentCacheWriter cacheWriter(
+            cachePath, false, computeAlignmentCacheKeys(originalCatalog, alignmentSettingsHash));
+        cacheWriter.write("locus", *locusAnalyzer.alignmentRecord());
+    }
+
+    GenotyperParameters changedParams(0);
+    changedParams.errorRate = 0.05;
+    const RegionCatalog changedCatalog = buildStrCatalog(changedParams);
+
+    SampleFindings sampleFindings;
+    ASSERT_NO_THROW(
+        sampleFindings = alignmentCacheSampleAnalysis(
+            cachePath, computeAlignmentCacheKeys(changedCatalog, alignmentSettingsHash), Sex::kFemale,
+            heuristicParams, 1, changedCatalog, writer));
+
+    ASSERT_EQ(1ul, sampleFindings.size());
+    const auto* repeatFindings
+        = dynamic_cast<const RepeatFindings*>(sampleFindings.front().findingsForEachVariant.at("repeat").get());
+    ASSERT_NE(nullptr, repeatFindings);
+    EXPECT_EQ(2, repeatFindings->countsOfSpanningReads().countOf(3));
+}
+
+TEST(DescribingAlignmentCacheKeyChanges, ChangedInputs_ChangesDescribed)
+{
+    const RegionCatalog catalog = buildStrCatalog(GenotyperParameters(10));
+    RegionCatalog changedCatalog = buildStrCatalog(GenotyperParameters(10));
+    changedCatalog.front().addVariantSpecification(
+        "swap", VariantClassification(VariantType::kSmallVariant, VariantSubtype::kSwap), GenomicRegion(1, 400, 401),
+        { 0 }, 0);
+
+    const std::string key = computeAlignmentCacheKeys(catalog, 1).at("locus");
+    const std::string changedSettingsKey = computeAlignmentCacheKeys(catalog, 2).at("locus");
+    const std::string changedDefinitionKey = computeAlignmentCacheKeys(changedCatalog, 1).at("locus");
+    const std::string changedKey = computeAlignmentCacheKeys(changedCatalog, 2).at("locus");
+
+    EXPECT_EQ("unchanged", describeAlignmentCacheKeyChange(key, key));
+    EXPECT_EQ(
+        "alignment settings or program version changed", describeAlignmentCacheKeyChange(key, changedSettingsKey));
+    EXPECT_EQ("locus definition changed", describeAlignmentCacheKeyChange(key, changedDefinitionKey));
+    EXPECT_EQ(
+        "locus definition and alignment settings or program version changed",
+        describeAlignmentCacheKeyChange(key, changedKey));
+}
@@ -0,0 +1,208 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "io/AlignmentCache.hh"
+
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "graphalign/GraphAlignmentOperations.hh"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using graphtools::decodeGraphAlignment;
+using graphtools::Graph;
+
+using namespace ehunter;
+using namespace locus;
+
+TEST(EncodingAlignmentCacheRecords, TypicalRecord_RecordRestored)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+
+    LocusAlignmentRecord record;
+    record.alignedPairs.emplace_back(
+        AlignedRead { Read(ReadId("frag1", MateNumber::kFirstMate), "CGACCATG", false),
+                      decodeGraphAlignment(3, "0[3M]1[1M]1[1M]2[3M]", &graph) },
+        AlignedRead { Read(ReadId("frag1", MateNumber::kSecondMate), "ATTCGA", true),
+                      decodeGraphAlignment(0, "0[6M]", &graph) });
+    record.alignedSingleReads.push_back(
+        { Read(ReadId("frag2", MateNumber::kSecondMate), "ATGTCG", false), decodeGraphAlignment(0, "2[6M]", &graph) });
+    record.irrPairCount = 3;
+
+    std::stringstream cache;
+    writeLocusAlignmentRecord(cache, "locus", record);
+    const LocusAlignmentRecord restored = readLocusAlignmentRecord(cache, "locus", graph);
+
+    ASSERT_EQ(1ul, restored.alignedPairs.size());
+    EXPECT_EQ(record.alignedPairs.front().first.read, restored.alignedPairs.front().first.read);
+    EXPECT_EQ(record.alignedPairs.front().first.alignment, restored.alignedPairs.front().first.alignment);
+    EXPECT_EQ(record.alignedPairs.front().second.read, restored.alignedPairs.front().second.read);
+    EXPECT_EQ(record.alignedPairs.front().second.alignment, restored.alignedPairs.front().second.alignment);
+    EXPECT_TRUE(restored.alignedPairs.front().second.read.isReversed());
+
+    ASSERT_EQ(1ul, restored.alignedSingleReads.size());
+    EXPECT_EQ(record.alignedSingleReads.front().read, restored.alignedSingleReads.front().read);
+    EXPECT_EQ(record.alignedSingleReads.front().alignment, restored.alignedSingleReads.front().alignment);
+
+    EXPECT_EQ(3, restored.irrPairCount);
+}
+
+TEST(EncodingAlignmentCacheRecords, RecordOfAnotherLocus_ExceptionThrown)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+
+    std::stringstream cache;
+    writeLocusAlignmentRecord(cache, "locus1", LocusAlignmentRecord());
+
+    EXPECT_ANY_THROW(readLocusAlignmentRecord(cache, "locus2", graph));
+}
+
+TEST(JournalingAlignmentCache, InterruptedIndexWrite_IncompleteEntryIgnored)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    const std::string cachePath = ::testing::TempDir() + "JournalingAlignmentCache.alignment_cache";
+
+    {
+        AlignmentCacheWriter writer(cachePath);
+        writer.write("locus1", LocusAlignmentRecord());
+    }
+    {
+        const bool append(true);
+        AlignmentCacheWriter writer(cachePath, append);
+        LocusAlignmentRecord record;
+        record.irrPairCount = 2;
+        writer.write("locus2", record);
+    }
+    {
+        std::ofstream index(cachePath + ".idx", std::ios::app);
+        index << "locus3\t12";
+    }
+
+    AlignmentCacheReader reader(cachePath);
+    EXPECT_TRUE(reader.contains("locus1"));
+    EXPECT_TRUE(reader.contains("locus2"));
+    EXPECT_FALSE(reader.contains("locus3"));
+    EXPECT_EQ(2, reader.read("locus2", graph)->irrPairCount);
+    EXPECT_EQ(0, reader.read("locus1", graph)->irrPairCount);
+}
+
+TEST(JournalingAlignmentCache, RepeatedlyInterruptedRun_ResumedEachTime)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    const std::string cachePath = ::testing::TempDir() + "ResumedAlignmentCache.alignment_cache";
+    const bool append(true);
+
+    {
+        AlignmentCacheWriter writer(cachePath);
+        writer.write("locus1", LocusAlignmentRecord());
+    }
+
+    for (int runIndex(2); runIndex <= 3; ++runIndex)
+    {
+        // Interrupt the run in the middle of a block and of its index line
+        {
+            std::ofstream cache(cachePath, std::ios::binary | std::ios::app);
+            cache << "#locus9\t1\t0\t0\nfrag";
+            std::ofstream index(cachePath + ".idx", std::ios::app);
+            index << "locus9\t2";
+        }
+
+        AlignmentCacheWriter writer(cachePath, append);
+        LocusAlignmentRecord record;
+        record.irrPairCount = runIndex;
+        writer.write("locus" + std::to_string(runIndex), record);
+    }
+
+    AlignmentCacheReader reader(cachePath);
+    EXPECT_FALSE(reader.contains("locus9"));
+    EXPECT_EQ(0, reader.read("locus1", graph)->irrPairCount);
+    EXPECT_EQ(2, reader.read("locus2", graph)->irrPairCount);
+    EXPECT_EQ(3, reader.read("locus3", graph)->irrPairCount);
+}
+
+TEST(JournalingAlignmentCache, KeyedRecords_LatestRecordOfLocusUsed)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    const std::string cachePath = ::testing::TempDir() + "KeyedAlignmentCache.alignment_cache";
+
+    {
+        AlignmentCacheWriter writer(cachePath, false, { { "locus1", "key1" } });
+        writer.write("locus1", LocusAlignmentRecord());
+        writer.write("locus2", LocusAlignmentRecord());
+    }
+    {
+        const bool append(true);
+        AlignmentCacheWriter writer(cachePath, append, { { "locus1", "key2" } });
+        LocusAlignmentRecord record;
+        record.irrPairCount = 3;
+        writer.write("locus1", record);
+    }
+
+    AlignmentCacheReader reader(cachePath);
+    EXPECT_TRUE(reader.contains("locus1", "key2"));
+    EXPECT_FALSE(reader.contains("locus1", "key1"));
+    EXPECT_TRUE(reader.contains("locus2"));
+    EXPECT_FALSE(reader.contains("locus2", "key1"));
+    EXPECT_EQ(3, reader.read("locus1", graph)->irrPairCount);
+}
+
+TEST(JournalingAlignmentCache, CacheWithSampleFingerprint_FingerprintKeptWhenAppended)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    const std::string cachePath = ::testing::TempDir() + "FingerprintedAlignmentCache.alignment_cache";
+    const bool append(true);
+
+    {
+        AlignmentCacheWriter writer(cachePath, false, {}, "sample.bam|100|200");
+    }
+    // Interrupt the run before its first block is indexed
+    {
+        std::ofstream cache(cachePath, std::ios::binary | std::ios::app);
+        cache << "#locus9\t1\t0\t0\nfrag";
+    }
+    {
+        AlignmentCacheWriter writer(cachePath, append, {}, "other.bam|100|200");
+        LocusAlignmentRecord record;
+        record.irrPairCount = 2;
+        writer.write("locus1", record);
+    }
+
+    AlignmentCacheReader reader(cachePath);
+    ASSERT_TRUE(reader.sampleFingerprint());
+    EXPECT_EQ("sample.bam|100|200", *reader.sampleFingerprint());
+    EXPECT_FALSE(reader.contains("locus9"));
+    EXPECT_EQ(2, reader.read("locus1", graph)->irrPairCount);
+}
+
+TEST(JournalingAlignmentCache, CacheWithoutSampleFingerprint_NoFingerprintReported)
+{
+    const std::string cachePath = ::testing::TempDir() + "UnfingerprintedAlignmentCache.alignment_cache";
+    {
+        AlignmentCacheWriter writer(cachePath);
+        writer.write("locus1", LocusAlignmentRecord());
+    }
+
+    AlignmentCacheReader reader(cachePath);
+    EXPECT_FALSE(reader.sampleFingerprint());
+    EXPECT_TRUE(reader.contains("locus1"));
+}
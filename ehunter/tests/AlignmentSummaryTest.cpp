@@ -19,19 +19,108 @@
 //
 //
 
+#include "alignment/AlignmentSummary.hh"
+
 #include <map>
 #include <memory>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "graphalign/GraphAlignmentOperations.hh"
+
+#include "alignment/OperationsOnAlignments.hh"
 #include "core/Read.hh"
+#include "genotyping/StrAlign.hh"
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
 
+using graphtools::decodeGraphAlignment;
+using graphtools::Graph;
+using graphtools::GraphAlignment;
 using namespace ehunter;
 
 using std::map;
 using std::vector;
 
+TEST(SummarizingAlignments, AlignmentAcrossRepeat_FeaturesSummarized)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    const GraphAlignment alignment = decodeGraphAlignment(3, "0[2S3M]1[1M]1[1X]1[1M]2[1M1D2M1S]", &graph);
+    const AlignmentSummary summary(alignment);
+
+    EXPECT_EQ(0u, summary.firstNodeId());
+    EXPECT_EQ(3, summary.startPosition());
+    EXPECT_EQ(static_cast<int>(alignment.queryLength()), summary.queryLength());
+    EXPECT_EQ(static_cast<int>(alignment.numMatches()), summary.numMatches());
+    EXPECT_EQ(2, summary.leftSoftclipLength());
+    EXPECT_EQ(1, summary.rightSoftclipLength());
+
+    EXPECT_EQ(3, summary.numVisitsToNode(1));
+    EXPECT_EQ(1, summary.firstIndexOfNode(1));
+    EXPECT_EQ(3, summary.lastIndexOfNode(1));
+    EXPECT_TRUE(summary.areVisitsToNodeConsecutive(1));
+
+    EXPECT_EQ(3, summary.referenceSpanOnNodes(0, 1));
+    EXPECT_EQ(3, summary.referenceSpanOnNodes(1, 2));
+    EXPECT_EQ(4, summary.referenceSpanOnNodes(2, AlignmentSummary::kEndOfGraph));
+    EXPECT_EQ(5, summary.numVisitsToNodes(0, AlignmentSummary::kEndOfGraph));
+
+    EXPECT_EQ(15, summary.scoreOnNodes(0, 1));
+    EXPECT_EQ(6, summary.scoreOfIndexes(1, 4));
+    EXPECT_EQ(1, summary.numIndelsOfIndexes(0, 5));
+    EXPECT_EQ(2, summary.numMatchesOfIndexes(1, 4));
+    EXPECT_EQ(22, summary.scoreToNonloopNodes());
+    EXPECT_EQ(scoreAlignmentToNonloopNodes(alignment), summary.scoreToNonloopNodes());
+}
+
+TEST(SummarizingAlignments, NodesNotVisited_EmptyFeatures)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    const AlignmentSummary summary(decodeGraphAlignment(0, "0[6M]", &graph));
+
+    EXPECT_EQ(0, summary.numVisitsToNode(1));
+    EXPECT_EQ(-1, summary.firstIndexOfNode(2));
+    EXPECT_EQ(-1, summary.lastIndexOfNode(2));
+    EXPECT_EQ(0, summary.numVisitsToNode(100));
+    EXPECT_EQ(0, summary.referenceSpanOnNodes(1, AlignmentSummary::kEndOfGraph));
+    EXPECT_EQ(0, summary.leftSoftclipLength());
+    EXPECT_EQ(0, summary.rightSoftclipLength());
+}
+
+TEST(SummarizingAlignments, StrAlignmentsFromSummaries_MatchStrAlignmentsFromAlignments)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    ConsistentAlignmentCalculator calculator(1);
+
+    const vector<GraphAlignment> alignments
+        = { decodeGraphAlignment(0, "0[5M2I1M]1[1M]1[1M]1[1M]2[1M1D2M]", &graph),
+            decodeGraphAlignment(3, "0[3M]1[1M]1[1X]1[1M]2[4M]", &graph),
+            decodeGraphAlignment(0, "1[1M]1[1M]1[1M]2[4M]", &graph),
+            decodeGraphAlignment(3, "0[3M]1[1M]1[1M]1[1M]", &graph),
+            decodeGraphAlignment(0, "1[1M]1[1M]1[1M]", &graph),
+            decodeGraphAlignment(0, "0[6M]", &graph),
+            decodeGraphAlignment(1, "2[5M]", &graph),
+            decodeGraphAlignment(2, "0[4M]2[3X3M]", &graph) };
+
+    for (const auto& alignment : alignments)
+    {
+        const AlignmentSummary summary(alignment);
+        for (int numMotifs = 0; numMotifs != 6; ++numMotifs)
+        {
+            EXPECT_EQ(
+                calculator.clipFromLeft(numMotifs, alignment), calculator.clipFromLeft(numMotifs, alignment, summary))
+                << alignment;
+            EXPECT_EQ(
+                calculator.clipFromRight(numMotifs, alignment), calculator.clipFromRight(numMotifs, alignment, summary))
+                << alignment;
+            EXPECT_EQ(
+                calculator.removeStutter(numMotifs, alignment), calculator.removeStutter(numMotifs, alignment, summary))
+                << alignment;
+        }
+    }
+}
+
 /*
 TEST(SummarizingAlignments, TypicalAlignments_Summarized)
 {
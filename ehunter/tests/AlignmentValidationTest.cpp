@@ -0,0 +1,130 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "graphalign/ValidationLevel.hh"
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "graphalign/GappedAligner.hh"
+#include "graphalign/GraphAlignment.hh"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using graphtools::AlignerSelector;
+using graphtools::AlignerType;
+using graphtools::GappedGraphAligner;
+using graphtools::Graph;
+using graphtools::GraphAlignment;
+using graphtools::ValidationLevel;
+using std::list;
+using std::string;
+using std::vector;
+
+using namespace ehunter;
+
+namespace
+{
+
+// Restores the validation level in effect when the test started
+class ValidationLevelGuard
+{
+public:
+    ValidationLevelGuard()
+        : level_(graphtools::getValidationLevel())
+    {
+    }
+    ~ValidationLevelGuard() { graphtools::setValidationLevel(level_); }
+
+private:
+    ValidationLevel level_;
+};
+
+vector<list<GraphAlignment>>
+alignAtLevel(ValidationLevel level, AlignerType alignerType, const Graph& graph, const vector<string>& queries)
+{
+    ValidationLevelGuard guard;
+    graphtools::setValidationLevel(level);
+
+    GappedGraphAligner aligner(&graph, 14, 10, 5);
+    AlignerSelector alignerSelector(alignerType);
+    vector<list<GraphAlignment>> alignments;
+    for (const auto& query : queries)
+    {
+        alignments.push_back(aligner.align(query, alignerSelector));
+    }
+    return alignments;
+}
+
+}
+
+class AligningWithValidationLevels : public ::testing::TestWithParam<AlignerType>
+{
+};
+
+TEST_P(AligningWithValidationLevels, ReadsAlignedWithAndWithoutChecks_IdenticalAlignments)
+{
+    const string leftFlank = "AGCCCCATTCATTGCCCCGGTGCTGAGCGGCGCCGCGAGTCGGCCCGAGGCCTCCGGGGACTGCCGTGCC";
+    const string rightFlank = "CCTCCTCAGCTTCCTCAGCCGCCGCCGCAGGCACAGCCGCTGCTGCCTCAGCCGCAGCCGCCCCCGCCGCC";
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex(leftFlank + "(CAG)*CAACAG(CCG)*" + rightFlank));
+
+    const vector<string> queries
+        = { "GGCCTCCGGGGACTGCCGTGCCCAGCAGCAGCAGCAACAGCCGCCGCCGCCTCCTCAGCTTCCTCAGCC",
+            "GGCCTCCGGGTACTGCCGTGCCCAGCAGCAGCAGCAACAGCCGCCGCCGCCTCCTCAGCTTCGTCAGCC",
+            "GGCCTCCGGGGACTGCCGTGCCCAGCAGCAGCAGCAGCAGCAGCAGCAGCAGCAGCAGCAGCAGCAGCAG",
+            "CAGCAGCAGCAACAGCCGCCGCCGCCGCCGCCGCCGCCGCCGCCCCTCCTCAGCTTCCTCAGCCGCCG",
+            "GGCCTCCGGGGACTGCCGTGCCCAGCAGCAGAGCAACAGCCGCCGCCGCCTCCTCAGCTTCCTCAGCC",
+            "GGCCTCCGGGGACTGCCGTGCCCAGCAGCAGCAGCAACAGCCGCCGCCGCCGCCTCCTCAGCTTCCTCAGCC",
+            "TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT" };
+
+    const auto alignmentsWithChecks = alignAtLevel(ValidationLevel::kFull, GetParam(), graph, queries);
+    const auto sampledAlignments = alignAtLevel(ValidationLevel::kSampled, GetParam(), graph, queries);
+    const auto alignmentsWithoutChecks = alignAtLevel(ValidationLevel::kOff, GetParam(), graph, queries);
+
+    ASSERT_FALSE(alignmentsWithChecks.front().empty());
+    EXPECT_EQ(alignmentsWithChecks, sampledAlignments);
+    EXPECT_EQ(alignmentsWithChecks, alignmentsWithoutChecks);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AlignmentValidationTestsInstantiation, AligningWithValidationLevels,
+    ::testing::Values(AlignerType::PATH_ALIGNER, AlignerType::DAG_ALIGNER));
+
+TEST(SettingValidationLevel, SampledLevel_EveryCheckPeriodValidated)
+{
+    ValidationLevelGuard guard;
+
+    graphtools::setValidationLevel(ValidationLevel::kFull);
+    EXPECT_TRUE(graphtools::shouldValidate());
+
+    graphtools::setValidationLevel(ValidationLevel::kOff);
+    EXPECT_FALSE(graphtools::shouldValidate());
+
+    graphtools::setValidationLevel(ValidationLevel::kSampled);
+    int validatedCheckCount = 0;
+    for (int checkIndex = 0; checkIndex != 640; ++checkIndex)
+    {
+        validatedCheckCount += graphtools::shouldValidate() ? 1 : 0;
+    }
+    EXPECT_EQ(10, validatedCheckCount);
+}
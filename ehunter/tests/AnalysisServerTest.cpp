@@ -0,0 +1,112 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/AnalysisServer.hh"
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/ParameterLoading.hh"
+#include "io/RegionGraph.hh"
+
+using namespace ehunter;
+using std::string;
+using std::vector;
+
+static ProgramParameters makeServerParameters()
+{
+    InputPaths inputPaths("/data/server.bam", "/data/genome.fa", "/data/catalog.json");
+    HeuristicParameters heuristicParams(1000, 10, 20, true, graphtools::AlignerType::DAG_ALIGNER);
+    return ProgramParameters(
+        inputPaths, makeOutputPaths("/out/server"), SampleParameters("server", Sex::kFemale), heuristicParams,
+        AnalysisMode::kSeeking, LogLevel::kInfo, 4, true, false, false, true);
+}
+
+static LocusSpecification buildLocusSpec(const string& locusId)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    return LocusSpecification(
+        locusId, ChromType::kAutosome, { GenomicRegion(0, 100, 200) }, graph, dummyAssociation, params, false);
+}
+
+TEST(DecodingServerJobs, MinimalRequest_ServerParametersUsed)
+{
+    const ServerJob job = decodeServerJob(R"({"Id": "job1"})", makeServerParameters());
+
+    EXPECT_EQ("job1", job.id);
+    EXPECT_EQ("/data/server.bam", job.params.inputPaths().htsFile());
+    EXPECT_EQ("/data/genome.fa", job.params.inputPaths().reference());
+    EXPECT_EQ("/out/server_job1.vcf", job.params.outputPaths().vcf());
+    EXPECT_EQ(Sex::kFemale, job.params.sample().sex());
+    EXPECT_EQ(AnalysisMode::kSeeking, job.params.analysisMode());
+    EXPECT_EQ(4, job.params.threadCount);
+    EXPECT_FALSE(job.params.server);
+    EXPECT_TRUE(job.locusIds.empty());
+}
+
+TEST(DecodingServerJobs, FullRequest_RequestParametersUsed)
+{
+    const string encoding = R"({"Id": "job2", "Reads": "/data/sample.cram", "Sex": "male", "OutputPrefix": "/out/s",)"
+                            R"( "AnalysisMode": "streaming", "LocusIds": ["ATXN1", "HTT"]})";
+    const ServerJob job = decodeServerJob(encoding, makeServerParameters());
+
+    EXPECT_EQ("/data/sample.cram", job.params.inputPaths().htsFile());
+    EXPECT_EQ("sample", job.params.sample().id());
+    EXPECT_EQ(Sex::kMale, job.params.sample().sex());
+    EXPECT_EQ("/out/s.json", job.params.outputPaths().json());
+    EXPECT_EQ(AnalysisMode::kStreaming, job.params.analysisMode());
+    EXPECT_EQ(vector<string>({ "ATXN1", "HTT" }), job.locusIds);
+}
+
+TEST(DecodingServerJobs, StreamingServer_JobsStreamByDefault)
+{
+    const ProgramParameters seekingServerParams = makeServerParameters();
+    ProgramParameters serverParams(
+        seekingServerParams.inputPaths(), seekingServerParams.outputPaths(), seekingServerParams.sample(),
+        seekingServerParams.heuristics(), AnalysisMode::kStreaming, LogLevel::kInfo, 4, true, false, false, true);
+
+    EXPECT_EQ(AnalysisMode::kStreaming, decodeServerJob(R"({"Id": "job"})", serverParams).params.analysisMode());
+}
+
+TEST(DecodingServerJobs, InvalidRequests_ExceptionThrown)
+{
+    const ProgramParameters serverParams = makeServerParameters();
+    EXPECT_THROW(decodeServerJob("not json", serverParams), std::invalid_argument);
+    EXPECT_THROW(decodeServerJob(R"({"Reads": "/data/sample.bam"})", serverParams), std::invalid_argument);
+    EXPECT_THROW(decodeServerJob(R"({"Id": "job", "Sex": "unknown"})", serverParams), std::invalid_argument);
+    EXPECT_THROW(decodeServerJob(R"({"Id": "job", "AnalysisMode": "extract"})", serverParams), std::invalid_argument);
+    EXPECT_THROW(decodeServerJob(R"({"Id": "job", "LocusIds": "HTT"})", serverParams), std::invalid_argument);
+    EXPECT_THROW(decodeServerJob(R"({"Id": "job", "Reads": "-"})", serverParams), std::invalid_argument);
+}
+
+TEST(SelectingLoci, LocusIdsGiven_LociSelectedInCatalogOrder)
+{
+    RegionCatalog catalog = { buildLocusSpec("locus1"), buildLocusSpec("locus2"), buildLocusSpec("locus3") };
+
+    EXPECT_EQ(3u, selectLoci(catalog, {}).size());
+
+    const RegionCatalog selectedLoci = selectLoci(catalog, { "locus3", "locus1" });
+    ASSERT_EQ(2u, selectedLoci.size());
+    EXPECT_EQ("locus1", selectedLoci[0].locusId());
+    EXPECT_EQ("locus3", selectedLoci[1].locusId());
+
+    EXPECT_THROW(selectLoci(catalog, { "locus4" }), std::invalid_argument);
+}
@@ -0,0 +1,202 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/AnalysisSession.hh"
+
+#include <atomic>
+#include <map>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+#include "locus/RepeatAnalyzer.hh"
+
+using namespace ehunter;
+
+using graphtools::AlignerType;
+using std::string;
+using std::vector;
+
+static RegionCatalog buildStrCatalog()
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    LocusSpecification locusSpec(
+        "locus", ChromType::kAutosome, { GenomicRegion(1, 0, 1000) }, graph, dummyAssociation, params, false);
+    VariantClassification classification(VariantType::kRepeat, VariantSubtype::kCommonRepeat);
+    locusSpec.addVariantSpecification("repeat", classification, GenomicRegion(1, 500, 501), { 1 }, 1);
+    return { locusSpec };
+}
+
+static LocusSpecification buildSmnLocusSpec()
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C|T)ATGTCG"));
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    const GenomicRegion region(2, 500, 501);
+    LocusSpecification locusSpec("smn", ChromType::kAutosome, { region }, graph, dummyAssociation, params, false);
+    VariantClassification classification(VariantType::kSmallVariant, VariantSubtype::kSMN);
+    locusSpec.addVariantSpecification("variant", classification, region, { 1, 2 }, 1);
+    return locusSpec;
+}
+
+static LinearAlignmentStats makeAlignmentStats(int32_t chromId, int32_t pos, int32_t matePos)
+{
+    LinearAlignmentStats stats;
+    stats.chromId = chromId;
+    stats.pos = pos;
+    stats.mapq = 60;
+    stats.mateChromId = chromId;
+    stats.matePos = matePos;
+    stats.isPaired = true;
+    stats.isMapped = true;
+    stats.isMateMapped = true;
+    return stats;
+}
+
+TEST(RunningAnalysisSession, ReadPairsAdded_FindingsReported)
+{
+    const RegionCatalog catalog = buildStrCatalog();
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER, 4, 1, 5, 4, 1);
+    AnalysisSession session(catalog, heuristicParams, Sex::kFemale);
+
+    session.addReadPair(
+        Read(ReadId("read1", MateNumber::kFirstMate), "CGACCCATGT", true), makeAlignmentStats(1, 495, 496),
+        Read(ReadId("read1", MateNumber::kSecondMate), "GACCCATGTC", true), makeAlignmentStats(1, 496, 495));
+    session.addReadPair(
+        Read(ReadId("read2", MateNumber::kFirstMate), "CGACATGT", true), makeAlignmentStats(1, 495, 496),
+        Read(ReadId("read2", MateNumber::kSecondMate), "GACATGTC", true), makeAlignmentStats(1, 496, 495));
+    // Read pair far from the locus is ignored
+    session.addReadPair(
+        Read(ReadId("read3", MateNumber::kFirstMate), "CGACCCATGT", true), makeAlignmentStats(0, 495, 496),
+        Read(ReadId("read3", MateNumber::kSecondMate), "GACCCATGTC", true), makeAlignmentStats(0, 496, 495));
+
+    vector<string> reportedLoci;
+    boost::optional<RepeatFindings> observed;
+    session.finish(
+        [&](const LocusSpecification& locusSpec, LocusFindings locusFindings)
+        {
+            reportedLoci.push_back(locusSpec.locusId());
+            observed = *dynamic_cast<RepeatFindings*>(locusFindings.findingsForEachVariant["repeat"].get());
+        });
+
+    EXPECT_EQ(vector<string>({ "locus" }), reportedLoci);
+    CountTable spanningCounts({ { 1, 2 }, { 3, 2 } });
+    RepeatGenotype genotype(1, { 1, 3 });
+    RepeatFindings expected(spanningCounts, {}, {}, AlleleCount::kTwo, genotype, {});
+    ASSERT_TRUE(observed);
+    EXPECT_EQ(expected, *observed);
+}
+
+TEST(RunningAnalysisSession, FinishedSession_ReadPairsRejected)
+{
+    const RegionCatalog catalog = buildStrCatalog();
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER);
+    AnalysisSession session(catalog, heuristicParams, Sex::kFemale);
+    session.finish([](const LocusSpecification&, LocusFindings) {});
+
+    EXPECT_THROW(
+        session.addReadPair(
+            Read(ReadId("read1", MateNumber::kFirstMate), "CGACCCATGT", true), makeAlignmentStats(1, 495, 496),
+            Read(ReadId("read1", MateNumber::kSecondMate), "GACCCATGTC", true), makeAlignmentStats(1, 496, 495)),
+        std::logic_error);
+    EXPECT_THROW(session.finish([](const LocusSpecification&, LocusFindings) {}), std::logic_error);
+}
+
+TEST(RunningAnalysisSession, SessionFinishedWhileReadPairsAdded_AcceptedReadPairsAnalyzed)
+{
+    const RegionCatalog catalog = buildStrCatalog();
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER, 4, 1, 5, 4, 1);
+    AnalysisSession session(catalog, heuristicParams, Sex::kFemale);
+
+    std::atomic<int> numAcceptedPairs(0);
+    vector<std::thread> producers;
+    for (int threadIndex = 0; threadIndex != 4; ++threadIndex)
+    {
+        producers.emplace_back(
+            [&]()
+            {
+                try
+                {
+                    for (int pairIndex = 0; pairIndex != 1000; ++pairIndex)
+                    {
+                        session.addReadPair(
+                            Read(ReadId("read", MateNumber::kFirstMate), "CGACCCATGT", true),
+                            makeAlignmentStats(1, 495, 496),
+                            Read(ReadId("read", MateNumber::kSecondMate), "GACCCATGTC", true),
+                            makeAlignmentStats(1, 496, 495));
+                        ++numAcceptedPairs;
+                    }
+                }
+                catch (const std::logic_error&)
+                {
+                }
+            });
+    }
+
+    boost::optional<RepeatFindings> observed;
+    session.finish(
+        [&](const LocusSpecification&, LocusFindings locusFindings)
+        { observed = *dynamic_cast<RepeatFindings*>(locusFindings.findingsForEachVariant["repeat"].get()); });
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_TRUE(observed);
+    EXPECT_EQ(2 * numAcceptedPairs.load(), observed->countsOfSpanningReads().countOf(3));
+}
+
+TEST(RunningAnalysisSession, LocusWithoutReadPairs_LowDepthFindingsReported)
+{
+    const RegionCatalog catalog = buildStrCatalog();
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER);
+    AnalysisSession session(catalog, heuristicParams, Sex::kFemale);
+
+    boost::optional<RepeatFindings> observed;
+    session.finish(
+        [&](const LocusSpecification&, LocusFindings locusFindings)
+        { observed = *dynamic_cast<RepeatFindings*>(locusFindings.findingsForEachVariant["repeat"].get()); });
+
+    ASSERT_TRUE(observed);
+    EXPECT_EQ(GenotypeFilter::kLowDepth, observed->genotypeFilter());
+    EXPECT_FALSE(observed->optionalGenotype());
+}
+
+TEST(RunningAnalysisSession, GenomeWideDepthGiven_UsedOnlyBySmnLoci)
+{
+    RegionCatalog catalog = buildStrCatalog();
+    catalog.push_back(buildSmnLocusSpec());
+    HeuristicParameters heuristicParams(1000, 10, 20, true, AlignerType::DAG_ALIGNER);
+    AnalysisSession session(catalog, heuristicParams, Sex::kFemale);
+
+    std::map<string, LocusStats> observedStats;
+    session.finish(
+        [&](const LocusSpecification& locusSpec, LocusFindings locusFindings)
+        { observedStats.emplace(locusSpec.locusId(), locusFindings.stats); },
+        30.0);
+
+    ASSERT_EQ(2ul, observedStats.size());
+    EXPECT_DOUBLE_EQ(30.0, observedStats.at("smn").depth());
+    EXPECT_DOUBLE_EQ(0.0, observedStats.at("locus").depth());
+    EXPECT_FALSE(observedStats.at("locus").indexDepth());
+}
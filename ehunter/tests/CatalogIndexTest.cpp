@@ -0,0 +1,76 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "io/CatalogIndex.hh"
+
+#include "gtest/gtest.h"
+
+using namespace ehunter;
+using std::string;
+using std::vector;
+
+static const ReferenceContigInfo kContigInfo({ { "chr1", 100000 }, { "chr2", 100000 } });
+
+TEST(IndexingCatalog, CatalogWithSeveralLoci_LociFoundByIdAndRegion)
+{
+    const string catalogText = R"([
+        {"LocusId": "Locus1", "LocusStructure": "(CAG)*", "ReferenceRegion": "chr1:1000-1030", "VariantType": "Repeat"},
+        {"LocusId": "Locus{2}", "LocusStructure": "(A)*(C)*", "VariantType": ["Repeat", "Repeat"],
+         "ReferenceRegion": ["chr2:500-510", "chr2:510-520"], "Note": "[\"}"},
+        {"LocusId": "Locus3", "LocusStructure": "(G)*", "ReferenceRegion": "chr1:5000-5010", "VariantType": "Repeat"}
+    ])";
+
+    const CatalogIndex index(catalogText, kContigInfo);
+
+    ASSERT_EQ(3u, index.entries().size());
+    EXPECT_EQ(
+        vector<GenomicRegion>({ GenomicRegion(1, 500, 510), GenomicRegion(1, 510, 520) }),
+        index.entries()[1].referenceRegions);
+    EXPECT_EQ('{', catalogText[index.entries()[1].offset]);
+    EXPECT_EQ('}', catalogText[index.entries()[1].offset + index.entries()[1].length - 1]);
+
+    EXPECT_EQ(2u, *index.findLocus("Locus3"));
+    EXPECT_FALSE(index.findLocus("Locus4"));
+
+    EXPECT_EQ(vector<std::size_t>({ 0, 2 }), index.findOverlappingLoci(GenomicRegion(0, 1010, 5005)));
+    EXPECT_EQ(vector<std::size_t>({ 1 }), index.findOverlappingLoci(GenomicRegion(1, 505, 515)));
+    EXPECT_TRUE(index.findOverlappingLoci(GenomicRegion(0, 2000, 3000)).empty());
+}
+
+TEST(IndexingCatalog, CatalogWithSingleLocusObject_LocusIndexed)
+{
+    const string catalogText = R"({"LocusId": "Locus1", "LocusStructure": "(CAG)*",)"
+                               R"( "ReferenceRegion": "chr1:1000-1030", "VariantType": "Repeat"})";
+
+    const CatalogIndex index(catalogText, kContigInfo);
+
+    ASSERT_EQ(1u, index.entries().size());
+    EXPECT_EQ(0u, index.entries()[0].offset);
+    EXPECT_EQ(catalogText.size(), index.entries()[0].length);
+}
+
+TEST(IndexingCatalog, InvalidCatalogs_ExceptionThrown)
+{
+    EXPECT_ANY_THROW(CatalogIndex(R"([{"LocusId": "Locus1", "ReferenceRegion": "chr1:1-2"})", kContigInfo));
+    EXPECT_ANY_THROW(CatalogIndex(R"([{"LocusId": "Locus1"}])", kContigInfo));
+    EXPECT_ANY_THROW(CatalogIndex(
+        R"([{"LocusId": "Locus1", "ReferenceRegion": "chr1:1-2"},)"
+        R"( {"LocusId": "Locus1", "ReferenceRegion": "chr1:5-6"}])",
+        kContigInfo));
+}
@@ -21,6 +21,10 @@
 
 #include "core/ConcurrentQueue.hh"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "gtest/gtest.h"
 
 using namespace ehunter;
@@ -39,3 +43,29 @@ TEST(ConcurrentQueueTest, SerialOps)
     EXPECT_TRUE(cq.empty());
     EXPECT_EQ(r, 2);
 }
+
+TEST(ConcurrentQueueTest, BoundedQueue_PushBlocksUntilPop)
+{
+    ConcurrentQueue<int> cq(1);
+    cq.push(1);
+
+    std::atomic<bool> isSecondPushDone(false);
+    std::thread producer(
+        [&]()
+        {
+            cq.push(2);
+            isSecondPushDone = true;
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(isSecondPushDone.load());
+
+    int r;
+    cq.pop(r);
+    EXPECT_EQ(r, 1);
+    producer.join();
+    EXPECT_TRUE(isSecondPushDone.load());
+
+    cq.pop(r);
+    EXPECT_EQ(r, 2);
+}
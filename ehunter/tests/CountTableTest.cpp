@@ -22,6 +22,9 @@
 
 #include "core/CountTable.hh"
 
+#include <cstdlib>
+#include <utility>
+
 #include "gtest/gtest.h"
 
 using std::map;
@@ -78,3 +81,70 @@ TEST(TruncatingCounts, TypicalCountTables_CountsTruncated)
         EXPECT_EQ(expectedCountTable, collapseTopElements(countTable, 3));
     }
 }
+
+TEST(IteratingOverCountTable, ElementsAddedOutOfOrder_ElementsVisitedInIncreasingOrder)
+{
+    CountTable countTable;
+    countTable.incrementCountOf(12, 3);
+    countTable.incrementCountOf(-2);
+    countTable.incrementCountOf(5, 2);
+    countTable.setCountOf(8, 4);
+    countTable.setCountOf(8, 0);
+
+    vector<std::pair<int32_t, int32_t>> elementsAndCounts(countTable.begin(), countTable.end());
+    const vector<std::pair<int32_t, int32_t>> expectedElementsAndCounts = { { -2, 1 }, { 5, 2 }, { 12, 3 } };
+    EXPECT_EQ(expectedElementsAndCounts, elementsAndCounts);
+}
+
+TEST(ComparingCountTables, TablesWithSameNonzeroCounts_TablesEqual)
+{
+    CountTable countTable(map<int32_t, int32_t>({ { 2, 1 }, { 9, 3 } }));
+    countTable.incrementCountOf(20);
+    countTable.setCountOf(20, 0);
+
+    EXPECT_EQ(CountTable(map<int32_t, int32_t>({ { 2, 1 }, { 9, 3 } })), countTable);
+    EXPECT_FALSE(CountTable(map<int32_t, int32_t>({ { 2, 1 } })) == countTable);
+}
+
+TEST(SummingCounts, TypicalCountTable_CountsOfElementsUpToBoundSummed)
+{
+    const CountTable countTable(map<int32_t, int32_t>({ { 1, 2 }, { 3, 5 }, { 7, 15 } }));
+
+    EXPECT_EQ(0, countTable.countOfElementsUpTo(0));
+    EXPECT_EQ(7, countTable.countOfElementsUpTo(6));
+    EXPECT_EQ(22, countTable.countOfElementsUpTo(7));
+    EXPECT_EQ(22, countTable.countOfElementsUpTo(100));
+    EXPECT_EQ(0, CountTable().countOfElementsUpTo(100));
+}
+
+TEST(ManipulatingCountTable, RandomOperations_ResultMatchesOrderedMap)
+{
+    std::srand(7);
+    CountTable countTable;
+    map<int32_t, int32_t> expectedCounts;
+
+    for (int operationIndex = 0; operationIndex != 2000; ++operationIndex)
+    {
+        const int32_t element = std::rand() % 150 - 20;
+        if (std::rand() % 4 == 0)
+        {
+            const int32_t count = std::rand() % 3;
+            countTable.setCountOf(element, count);
+            expectedCounts[element] = count;
+            if (count == 0)
+            {
+                expectedCounts.erase(element);
+            }
+        }
+        else
+        {
+            countTable.incrementCountOf(element);
+            ++expectedCounts[element];
+        }
+    }
+
+    EXPECT_EQ(CountTable(expectedCounts), countTable);
+    const vector<std::pair<int32_t, int32_t>> expectedElementsAndCounts(expectedCounts.begin(), expectedCounts.end());
+    const vector<std::pair<int32_t, int32_t>> elementsAndCounts(countTable.begin(), countTable.end());
+    EXPECT_EQ(expectedElementsAndCounts, elementsAndCounts);
+}
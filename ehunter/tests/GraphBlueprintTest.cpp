@@ -21,13 +21,117 @@
 
 #include "io/GraphBlueprint.hh"
 
+#include <fstream>
+#include <regex>
+
+#include <boost/filesystem.hpp>
+
 #include "gtest/gtest.h"
+#include "thirdparty/json/json.hpp"
 
+using graphtools::NodeId;
 using std::string;
 using std::vector;
 
 using namespace ehunter;
 
+using Json = nlohmann::json;
+
+namespace
+{
+
+// Regex-based decoder that the locus structure parser replaced; serves as the reference implementation
+GraphBlueprint decodeFeaturesWithRegexes(const string& structure)
+{
+    const std::regex skippableRepeatRegex("^\\([ACGTBDHKMNSRVWY]+\\)\\*$");
+    const std::regex unskippableRepeatRegex("^\\([ACGTBDHKMNSRVWY]+\\)\\+$");
+    const std::regex insertionOrDeletionRegex("^\\([ACGTBDHKMNSRVWY]+\\)\\?$");
+    const std::regex swapRegex("^\\([ACGTBDHKMNSRVWY]+\\|[ACGTBDHKMNSRVWY]+\\)$");
+    const std::regex interruptionRegex("^[ACGTBDHKMNSRVWY]+$");
+
+    const auto tokens = tokenizeRegex(structure);
+    GraphBlueprint blueprint;
+    NodeId firstUnusedNodeId = 0;
+    for (int index = 0; index != static_cast<int>(tokens.size()); ++index)
+    {
+        const string& token = tokens[index];
+        GraphBlueprintFeatureType featureType;
+        vector<string> sequences;
+        if (std::regex_match(token, insertionOrDeletionRegex))
+        {
+            featureType = GraphBlueprintFeatureType::kInsertionOrDeletion;
+            sequences = { token.substr(1, token.size() - 3) };
+        }
+        else if (std::regex_match(token, skippableRepeatRegex))
+        {
+            featureType = GraphBlueprintFeatureType::kSkippableRepeat;
+            sequences = { token.substr(1, token.size() - 3) };
+        }
+        else if (std::regex_match(token, unskippableRepeatRegex))
+        {
+            featureType = GraphBlueprintFeatureType::kUnskippableRepeat;
+            sequences = { token.substr(1, token.size() - 3) };
+        }
+        else if (std::regex_match(token, swapRegex))
+        {
+            const auto pipePosition = token.find('|');
+            featureType = GraphBlueprintFeatureType::kSwap;
+            sequences = { token.substr(1, pipePosition - 1),
+                          token.substr(pipePosition + 1, token.size() - pipePosition - 2) };
+        }
+        else if (std::regex_match(token, interruptionRegex))
+        {
+            featureType = GraphBlueprintFeatureType::kInterruption;
+            sequences = { token };
+        }
+        else
+        {
+            throw std::logic_error("Could not parse the token " + token);
+        }
+
+        const bool isFlank = index == 0 || index == static_cast<int>(tokens.size()) - 1;
+        if (isFlank && featureType == GraphBlueprintFeatureType::kInterruption)
+        {
+            featureType = index == 0 ? GraphBlueprintFeatureType::kLeftFlank : GraphBlueprintFeatureType::kRightFlank;
+        }
+
+        vector<NodeId> nodeIds;
+        const int nodeCount = isFlank ? 1 : static_cast<int>(sequences.size());
+        for (int nodeIndex = 0; nodeIndex != nodeCount; ++nodeIndex)
+        {
+            nodeIds.push_back(firstUnusedNodeId++);
+        }
+        blueprint.emplace_back(featureType, sequences, nodeIds);
+    }
+
+    return blueprint;
+}
+
+void expectSameDecoding(const string& structure)
+{
+    GraphBlueprint expectedBlueprint;
+    bool isRejectedByReference = false;
+    try
+    {
+        expectedBlueprint = decodeFeaturesWithRegexes(structure);
+    }
+    catch (const std::logic_error&)
+    {
+        isRejectedByReference = true;
+    }
+
+    if (isRejectedByReference)
+    {
+        EXPECT_THROW(decodeFeaturesFromRegex(structure), std::logic_error) << structure;
+    }
+    else
+    {
+        EXPECT_EQ(expectedBlueprint, decodeFeaturesFromRegex(structure)) << structure;
+    }
+}
+
+}
+
 TEST(SplittingStringsIntoTokens, ValidStrings_Split)
 {
     const string regex = "ATGC(CAG)+GTCG(AAA|TTT)(AGTC)?(CAG)*";
@@ -61,3 +165,62 @@ TEST(ParsingTokens, TypicalTokens_Parsed)
         EXPECT_EQ(expectedResult, parser.parse("(AAA|TTT)"));
     }
 }
+
+TEST(DecodingLocusStructures, ShippedCatalogs_SameBlueprintsAsRegexDecoding)
+{
+    const boost::filesystem::path repositoryDir(EH_REPOSITORY_DIR);
+    vector<boost::filesystem::path> catalogPaths = { repositoryDir / "example" / "input" / "variants.json" };
+    for (const auto& entry : boost::filesystem::recursive_directory_iterator(repositoryDir / "variant_catalog"))
+    {
+        if (entry.path().extension() == ".json")
+        {
+            catalogPaths.push_back(entry.path());
+        }
+    }
+
+    int structureCount = 0;
+    for (const auto& catalogPath : catalogPaths)
+    {
+        std::ifstream catalogFile(catalogPath.string());
+        ASSERT_TRUE(catalogFile.is_open()) << catalogPath;
+        Json catalogJson;
+        catalogFile >> catalogJson;
+
+        for (const auto& locusJson : catalogJson)
+        {
+            // Flanks are added during catalog loading
+            const string structure = "ATCGATCG" + locusJson["LocusStructure"].get<string>() + "GCTAGCTA";
+            expectSameDecoding(structure);
+            expectSameDecoding(locusJson["LocusStructure"].get<string>());
+            ++structureCount;
+        }
+    }
+
+    EXPECT_LT(0, structureCount);
+}
+
+TEST(DecodingLocusStructures, MalformedStructures_RejectedLikeRegexDecoding)
+{
+    const vector<string> structures
+        = { "",          "ATCG",        "(CAG)*",    "AT(CAG)AT",  "AT(CAG)*+AT", "AT(CA*G)*AT", "AT(A|T|G)AT",
+            "AT(A|T)*AT", "AT()*AT",    "AT(CAG*AT", "ATCAG)*AT",  "AT(CAG)?",    "AT(cag)*AT",  "(A|T)ATC",
+            "AT*",       "AT(CAG)*(",   "AT|GC",     "AT(|T)GC",   "AT(A|)GC",    "AT((CAG)*)*" };
+
+    for (const auto& structure : structures)
+    {
+        expectSameDecoding(structure);
+    }
+}
+
+TEST(DecodingLocusStructures, MalformedStructure_ErrorPositionReported)
+{
+    try
+    {
+        decodeFeaturesFromRegex("ATCG(CAG)*CA(CCG)GCTA");
+        FAIL() << "Expected a malformed structure to be rejected";
+    }
+    catch (const std::logic_error& error)
+    {
+        EXPECT_NE(string::npos, string(error.what()).find("but found 'G' at position 17")) << error.what();
+    }
+}
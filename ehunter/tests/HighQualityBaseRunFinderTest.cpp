@@ -21,6 +21,7 @@
 
 #include "alignment/HighQualityBaseRunFinder.hh"
 
+#include <random>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -30,6 +31,36 @@ using std::string;
 
 using namespace ehunter;
 
+// Reference implementation that rescans both runs at every candidate change point
+template <typename Iter>
+static Iter findTopChangePointByRescanning(double firstRunProb, double secondRunProb, Iter start, Iter end)
+{
+    auto calculateRunProb = [](double goodBaseProb, Iter begin, Iter end)
+    {
+        int numGoodBases = 0;
+        for (auto baseIter = begin; baseIter != end; ++baseIter)
+        {
+            numGoodBases += isupper(*baseIter) ? 1 : 0;
+        }
+        const int numBadBases = static_cast<int>(end - begin) - numGoodBases;
+        return numGoodBases * goodBaseProb + numBadBases * (1.0 - goodBaseProb);
+    };
+
+    double topRunProb = 0;
+    auto topChangePoint = start;
+    for (auto changePoint = start; changePoint != end; ++changePoint)
+    {
+        const double currentRunProb
+            = calculateRunProb(firstRunProb, start, changePoint) + calculateRunProb(secondRunProb, changePoint, end);
+        if (topRunProb < currentRunProb)
+        {
+            topRunProb = currentRunProb;
+            topChangePoint = changePoint;
+        }
+    }
+    return topChangePoint;
+}
+
 TEST(SearchingForHighQualityBaseRuns, AllBasesHighQuality_FullRangeReturned)
 {
     string sequence = "ATCGATCG";
@@ -128,3 +159,29 @@ TEST(SearchingForHighQualityBaseRuns, QueryWithLowQualityEnds_CorrectRangeReturn
     string expectedBases = string(sequence.begin() + 27, sequence.end() - 54);
     ASSERT_EQ(expectedBases, goodBases);
 }
+
+TEST(SearchingForHighQualityBaseRuns, RandomQueries_SameRangeAsRescanningEveryChangePoint)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> lengthDistribution(0, 150);
+    std::bernoulli_distribution isLowQualityBase(0.3);
+
+    for (int queryIndex = 0; queryIndex != 500; ++queryIndex)
+    {
+        string query(lengthDistribution(generator), 'A');
+        for (auto& base : query)
+        {
+            base = isLowQualityBase(generator) ? 'a' : 'A';
+        }
+
+        const string& constQuery = query;
+        const auto goodBasesRange = findHighQualityBaseRun(constQuery);
+
+        const auto halfLength = constQuery.length() / 2;
+        const auto expectedStart
+            = findTopChangePointByRescanning(0.1, 0.8, constQuery.begin(), constQuery.begin() + halfLength);
+        const auto expectedEnd
+            = findTopChangePointByRescanning(0.1, 0.8, constQuery.rbegin(), constQuery.rbegin() + halfLength).base();
+        ASSERT_EQ(make_pair(expectedStart, expectedEnd), goodBasesRange) << query;
+    }
+}
@@ -0,0 +1,60 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/HtsBlockPrefetcher.hh"
+
+#include "gtest/gtest.h"
+
+using namespace ehunter;
+using namespace htshelpers;
+using std::vector;
+
+static uint64_t makeVirtualOffset(uint64_t blockOffset, uint64_t offsetInBlock)
+{
+    return (blockOffset << 16) | offsetInBlock;
+}
+
+TEST(ComputingBlockRanges, SingleChunk_RangeCoversLastBlock)
+{
+    const vector<FileRange> ranges
+        = computeBlockRanges({ { makeVirtualOffset(1000, 20), makeVirtualOffset(5000, 300) } });
+
+    EXPECT_EQ(vector<FileRange>({ { 1000, 5000 + 65536 } }), ranges);
+}
+
+TEST(ComputingBlockRanges, OverlappingChunks_RangesMerged)
+{
+    const vector<FileRange> ranges = computeBlockRanges(
+        { { makeVirtualOffset(500000, 0), makeVirtualOffset(500000, 100) },
+          { makeVirtualOffset(1000, 20), makeVirtualOffset(5000, 300) },
+          { makeVirtualOffset(60000, 10), makeVirtualOffset(80000, 0) } });
+
+    EXPECT_EQ(vector<FileRange>({ { 1000, 80000 + 65536 }, { 500000, 500000 + 65536 } }), ranges);
+}
+
+TEST(ComputingBlockRanges, NoChunks_NoRanges)
+{
+    EXPECT_TRUE(computeBlockRanges({}).empty());
+}
+
+TEST(PrefetchingBlocks, RemoteFile_PrefetchingDisabled)
+{
+    HtsBlockPrefetcher prefetcher("https://example.com/sample.bam");
+    EXPECT_FALSE(prefetcher.isEnabled());
+}
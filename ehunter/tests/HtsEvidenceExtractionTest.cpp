@@ -0,0 +1,128 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/HtsEvidenceExtraction.hh"
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using namespace ehunter;
+using std::string;
+using std::vector;
+
+static LocusSpecification buildLocusSpec(
+    const string& locusId, const vector<GenomicRegion>& targetRegions, const vector<GenomicRegion>& offtargetRegions)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    LocusSpecification locusSpec(locusId, ChromType::kAutosome, targetRegions, graph, dummyAssociation, params, false);
+    locusSpec.setOfftargetReadExtractionRegions(offtargetRegions);
+    return locusSpec;
+}
+
+static LinearAlignmentStats
+makeAlignmentStats(int32_t chromId, int32_t pos, int32_t mateChromId, int32_t matePos, bool isPaired = true)
+{
+    LinearAlignmentStats alignmentStats;
+    alignmentStats.chromId = chromId;
+    alignmentStats.pos = pos;
+    alignmentStats.mateChromId = mateChromId;
+    alignmentStats.matePos = matePos;
+    alignmentStats.isPaired = isPaired;
+    alignmentStats.isMapped = true;
+    alignmentStats.isMateMapped = mateChromId >= 0;
+    return alignmentStats;
+}
+
+TEST(CollectingEvidenceRegions, TargetAndOfftargetRegions_MergedInGenomicOrder)
+{
+    const RegionCatalog catalog
+        = { buildLocusSpec("locus1", { GenomicRegion(1, 1000, 2000) }, { GenomicRegion(0, 5000, 6000) }),
+            buildLocusSpec("locus2", { GenomicRegion(0, 100, 200) }, {}),
+            buildLocusSpec("locus3", { GenomicRegion(1, 1800, 2500) }, { GenomicRegion(0, 150, 300) }) };
+
+    const vector<GenomicRegion> expectedRegions
+        = { GenomicRegion(0, 100, 300), GenomicRegion(0, 5000, 6000), GenomicRegion(1, 1000, 2500) };
+    EXPECT_EQ(expectedRegions, computeEvidenceRegions(catalog));
+}
+
+TEST(CollectingEvidenceRegions, EmptyCatalog_NoRegions)
+{
+    EXPECT_TRUE(computeEvidenceRegions(RegionCatalog()).empty());
+}
+
+TEST(CollectingMates, MateMappedNearby_NotRecovered)
+{
+    EXPECT_FALSE(isMateRecoveryNeeded(makeAlignmentStats(0, 1000, 0, 1500)));
+    EXPECT_FALSE(isMateRecoveryNeeded(makeAlignmentStats(0, 1500, 0, 1000)));
+}
+
+TEST(CollectingMates, MateMappedFarAway_Recovered)
+{
+    EXPECT_TRUE(isMateRecoveryNeeded(makeAlignmentStats(0, 1000, 0, 2000)));
+    EXPECT_TRUE(isMateRecoveryNeeded(makeAlignmentStats(0, 1000, 0, 100000)));
+    EXPECT_TRUE(isMateRecoveryNeeded(makeAlignmentStats(0, 1000, 1, 1000)));
+}
+
+TEST(CollectingMates, UnpairedReadOrUnplacedMate_NotRecovered)
+{
+    EXPECT_FALSE(isMateRecoveryNeeded(makeAlignmentStats(0, 1000, 1, 1000, false)));
+    EXPECT_FALSE(isMateRecoveryNeeded(makeAlignmentStats(0, 1000, -1, -1)));
+}
+
+TEST(CollectingMates, NearbyMatePositions_RecoveredWithOneQuery)
+{
+    const vector<GenomicRegion> matePositions
+        = { GenomicRegion(1, 500, 501), GenomicRegion(0, 9000, 9001), GenomicRegion(0, 100, 101),
+            GenomicRegion(0, 600, 601), GenomicRegion(0, 100, 101) };
+
+    const vector<GenomicRegion> expectedRegions
+        = { GenomicRegion(0, 100, 601), GenomicRegion(0, 9000, 9001), GenomicRegion(1, 500, 501) };
+    EXPECT_EQ(expectedRegions, computeMateQueryRegions(matePositions, 1000));
+}
+
+TEST(CollectingMates, DistantMatePositions_RecoveredWithSeparateQueries)
+{
+    const vector<GenomicRegion> matePositions = { GenomicRegion(0, 5000, 5001), GenomicRegion(0, 100, 101) };
+
+    const vector<GenomicRegion> expectedRegions = { GenomicRegion(0, 100, 101), GenomicRegion(0, 5000, 5001) };
+    EXPECT_EQ(expectedRegions, computeMateQueryRegions(matePositions, 1000));
+}
+
+TEST(OrderingEvidenceRecords, RecordsOnSameContig_OrderedByPosition)
+{
+    EXPECT_TRUE(isBeforeInEvidenceFile(0, 100, 0, 200));
+    EXPECT_FALSE(isBeforeInEvidenceFile(0, 200, 0, 100));
+    EXPECT_FALSE(isBeforeInEvidenceFile(0, 100, 0, 100));
+}
+
+TEST(OrderingEvidenceRecords, RecordsOnDifferentContigs_OrderedByContigIndex)
+{
+    EXPECT_TRUE(isBeforeInEvidenceFile(0, 5000, 1, 100));
+    EXPECT_FALSE(isBeforeInEvidenceFile(2, 100, 1, 5000));
+}
+
+TEST(OrderingEvidenceRecords, UnplacedRecords_OrderedLast)
+{
+    EXPECT_TRUE(isBeforeInEvidenceFile(25, 100, -1, -1));
+    EXPECT_FALSE(isBeforeInEvidenceFile(-1, -1, 0, 100));
+}
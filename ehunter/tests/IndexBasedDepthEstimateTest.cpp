@@ -0,0 +1,83 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/IndexBasedDepthEstimate.hh"
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using namespace ehunter;
+using std::vector;
+
+static LocusSpecification buildLocusSpec(int32_t contigIndex, bool isSmnLocus = false)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C|T)ATGTCG"));
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    const GenomicRegion region(contigIndex, 100, 101);
+    LocusSpecification locusSpec("locus", ChromType::kAutosome, { region }, graph, dummyAssociation, params, false);
+    const VariantSubtype subtype = isSmnLocus ? VariantSubtype::kSMN : VariantSubtype::kSwap;
+    VariantClassification classification(VariantType::kSmallVariant, subtype);
+    locusSpec.addVariantSpecification("variant", classification, region, { 1, 2 }, 1);
+    return locusSpec;
+}
+
+TEST(EstimatingDepthFromIndex, TypicalReadCounts_ContigAndGenomeWideDepthsComputed)
+{
+    ReferenceContigInfo contigInfo({ { "chr1", 1000 }, { "chr2", 2000 }, { "chr3", 1000 }, { "chrX", 1000 } });
+    const vector<uint64_t> mappedReadCounts = { 300, 400, 200, 100 };
+
+    const IndexDepthEstimate depthEstimate = computeIndexDepthEstimate(contigInfo, mappedReadCounts, 100);
+
+    EXPECT_DOUBLE_EQ(30.0, depthEstimate.contigDepth(0));
+    EXPECT_DOUBLE_EQ(20.0, depthEstimate.contigDepth(1));
+    EXPECT_DOUBLE_EQ(20.0, depthEstimate.contigDepth(2));
+    EXPECT_DOUBLE_EQ(10.0, depthEstimate.contigDepth(3));
+    EXPECT_NEAR(20.0, depthEstimate.genomeWideDepth(), 5.0);
+}
+
+TEST(EstimatingDepthFromIndex, ReferenceWithoutAutosomes_ExceptionThrown)
+{
+    ReferenceContigInfo contigInfo({ { "chrX", 1000 }, { "chrY", 1000 } });
+    EXPECT_THROW(computeIndexDepthEstimate(contigInfo, { 100, 100 }, 100), std::runtime_error);
+}
+
+TEST(EstimatingDepthFromIndex, MismatchedReadCounts_ExceptionThrown)
+{
+    ReferenceContigInfo contigInfo({ { "chr1", 1000 }, { "chr2", 1000 } });
+    EXPECT_THROW(computeIndexDepthEstimate(contigInfo, { 100 }, 100), std::logic_error);
+}
+
+TEST(GettingLocusDepth, TypicalLocus_DepthOfLocusContigReturned)
+{
+    const IndexDepthEstimate depthEstimate(25.0, { 30.0, 12.0 });
+
+    EXPECT_DOUBLE_EQ(12.0, depthEstimate.getLocusDepth(buildLocusSpec(1)));
+    EXPECT_DOUBLE_EQ(25.0, depthEstimate.getLocusDepth(buildLocusSpec(1, true)));
+}
+
+TEST(GettingLocusDepth, NoDepthEstimate_NoDepthReturned)
+{
+    EXPECT_FALSE(getIndexBasedLocusDepth(nullptr, buildLocusSpec(0)));
+
+    const IndexDepthEstimate depthEstimate(25.0, { 30.0 });
+    EXPECT_EQ(30.0, *getIndexBasedLocusDepth(&depthEstimate, buildLocusSpec(0)));
+}
@@ -0,0 +1,117 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "sample/LocusRetirementTracker.hh"
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using namespace ehunter;
+using std::vector;
+
+static LocusSpecification
+buildLocusSpec(const std::string& locusId, vector<GenomicRegion> targetRegions, vector<GenomicRegion> offtargetRegions)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex("ATTCGA(C)*ATGTCG"));
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    LocusSpecification locusSpec(
+        locusId, ChromType::kAutosome, std::move(targetRegions), graph, dummyAssociation, params, false);
+    locusSpec.setOfftargetReadExtractionRegions(offtargetRegions);
+    return locusSpec;
+}
+
+TEST(RetiringLoci, CursorMovesPastLoci_LociRetiredInCoordinateOrder)
+{
+    RegionCatalog catalog;
+    catalog.push_back(buildLocusSpec("locus1", { GenomicRegion(1, 500, 600) }, {}));
+    catalog.push_back(buildLocusSpec("locus2", { GenomicRegion(0, 100, 200) }, {}));
+
+    LocusRetirementTracker tracker(catalog, 10);
+    vector<unsigned> retiredLoci;
+
+    tracker.advance(0, 210, retiredLoci);
+    EXPECT_TRUE(retiredLoci.empty());
+
+    tracker.advance(0, 211, retiredLoci);
+    EXPECT_EQ(vector<unsigned>({ 1 }), retiredLoci);
+
+    retiredLoci.clear();
+    tracker.advance(2, 0, retiredLoci);
+    EXPECT_EQ(vector<unsigned>({ 0 }), retiredLoci);
+}
+
+TEST(RetiringLoci, LocusWithOfftargetRegions_NeverRetired)
+{
+    RegionCatalog catalog;
+    catalog.push_back(buildLocusSpec("locus", { GenomicRegion(0, 100, 200) }, { GenomicRegion(3, 100, 200) }));
+
+    LocusRetirementTracker tracker(catalog, 10);
+    vector<unsigned> retiredLoci;
+    tracker.advance(5, 1000, retiredLoci);
+
+    EXPECT_EQ(0u, tracker.numRetirableLoci());
+    EXPECT_TRUE(retiredLoci.empty());
+}
+
+TEST(RetiringLoci, LocusWithPendingRead_RetiredOnceReadIsPaired)
+{
+    RegionCatalog catalog;
+    catalog.push_back(buildLocusSpec("locus", { GenomicRegion(0, 100, 200) }, {}));
+
+    LocusRetirementTracker tracker(catalog, 10);
+    vector<unsigned> retiredLoci;
+
+    tracker.addPendingRead("frag1", { 0 });
+    tracker.advance(1, 50, retiredLoci);
+    EXPECT_TRUE(retiredLoci.empty());
+
+    tracker.removePendingRead("frag2", retiredLoci);
+    EXPECT_TRUE(retiredLoci.empty());
+
+    tracker.removePendingRead("frag1", retiredLoci);
+    EXPECT_EQ(vector<unsigned>({ 0 }), retiredLoci);
+}
+
+TEST(RetiringLoci, UnsortedPositions_ExceptionThrown)
+{
+    RegionCatalog catalog;
+    LocusRetirementTracker tracker(catalog, 10);
+    vector<unsigned> retiredLoci;
+
+    tracker.advance(1, 100, retiredLoci);
+    EXPECT_ANY_THROW(tracker.advance(1, 99, retiredLoci));
+    EXPECT_ANY_THROW(tracker.advance(0, 500, retiredLoci));
+}
+
+TEST(RetiringLoci, LocusKeptOpen_NeverRetired)
+{
+    RegionCatalog catalog;
+    catalog.push_back(buildLocusSpec("locus1", { GenomicRegion(0, 100, 200) }, {}));
+    catalog.push_back(buildLocusSpec("locus2", { GenomicRegion(0, 300, 400) }, {}));
+
+    LocusRetirementTracker tracker(catalog, 10, { 0 });
+    vector<unsigned> retiredLoci;
+    tracker.advance(5, 1000, retiredLoci);
+
+    EXPECT_EQ(1u, tracker.numRetirableLoci());
+    EXPECT_EQ(vector<unsigned>({ 1 }), retiredLoci);
+}
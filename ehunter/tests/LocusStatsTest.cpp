@@ -64,3 +64,49 @@ TEST(LocusStatsCalculator, TypicalReadLengths_StatsCalculated)
 
     ASSERT_EQ(LocusStats(AlleleCount::kTwo, 3, 0, 18), statsCalculator.estimate(Sex::kFemale));
 }
+
+TEST(ReconcilingLocusDepth, PlausibleLocalDepth_Kept)
+{
+    EXPECT_DOUBLE_EQ(25.0, reconcileLocusDepth(25.0, 30.0));
+    EXPECT_DOUBLE_EQ(3.0, reconcileLocusDepth(3.0, 30.0));
+    EXPECT_DOUBLE_EQ(2500.0, reconcileLocusDepth(2500.0, 30.0));
+}
+
+TEST(ReconcilingLocusDepth, LowLocalDepth_NotRaised)
+{
+    EXPECT_DOUBLE_EQ(0.0, reconcileLocusDepth(0.0, 30.0));
+    EXPECT_DOUBLE_EQ(2.0, reconcileLocusDepth(2.0, 30.0));
+    EXPECT_LT(reconcileLocusDepth(2.9, 30.0), reconcileLocusDepth(3.1, 30.0));
+}
+
+TEST(ReconcilingLocusDepth, ImplausiblyHighLocalDepth_Clamped)
+{
+    EXPECT_DOUBLE_EQ(3000.0, reconcileLocusDepth(50000.0, 30.0));
+}
+
+TEST(ReconcilingLocusDepth, IndexDepthUnavailable_LocalDepthKept)
+{
+    EXPECT_DOUBLE_EQ(25.0, reconcileLocusDepth(25.0, 0.0));
+}
+
+TEST(ReconcilingLocusDepth, IndexDepthSet_BothDepthsReported)
+{
+    LocusStats stats(AlleleCount::kTwo, 150, 400, 2.0);
+    stats.setIndexDepth(30.0);
+
+    EXPECT_DOUBLE_EQ(2.0, stats.depth());
+    EXPECT_DOUBLE_EQ(2.0, stats.localDepth());
+    ASSERT_TRUE(stats.indexDepth());
+    EXPECT_DOUBLE_EQ(30.0, *stats.indexDepth());
+}
+
+TEST(ReconcilingLocusDepth, IndexDepthUsed_LocalDepthReplaced)
+{
+    LocusStats stats(AlleleCount::kTwo, 150, 400, 2.0);
+    stats.useIndexDepth(30.0);
+
+    EXPECT_DOUBLE_EQ(30.0, stats.depth());
+    EXPECT_DOUBLE_EQ(2.0, stats.localDepth());
+    ASSERT_TRUE(stats.indexDepth());
+    EXPECT_DOUBLE_EQ(30.0, *stats.indexDepth());
+}
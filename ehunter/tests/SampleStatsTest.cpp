@@ -0,0 +1,116 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "io/SampleStats.hh"
+
+#include "gtest/gtest.h"
+
+using namespace ehunter;
+
+static void addWindows(SampleQcAccumulator& accumulator, ChromType chromType, const std::vector<int>& readCounts)
+{
+    for (const int readCount : readCounts)
+    {
+        accumulator.addWindow(chromType, readCount);
+    }
+}
+
+TEST(SummarizingSampleQc, MixedReadLengths_ReadLengthDistributionSummarized)
+{
+    SampleQcAccumulator accumulator;
+    for (const int readLength : { 150, 151, 151, 120, 151 })
+    {
+        accumulator.addRead(readLength);
+    }
+    for (const int fragmentLength : { 400, 350, 500 })
+    {
+        accumulator.addFragment(fragmentLength);
+    }
+    addWindows(accumulator, ChromType::kAutosome, { 400, 410, 390 });
+
+    const SampleQcSummary summary = accumulator.summarize();
+    EXPECT_EQ(5, summary.sampledReadCount);
+    EXPECT_EQ(120, summary.minReadLength);
+    EXPECT_EQ(151, summary.medianReadLength);
+    EXPECT_EQ(151, summary.maxReadLength);
+    EXPECT_EQ(400, summary.medianFragmentLength);
+    EXPECT_FALSE(summary.xDepthRatio);
+    EXPECT_FALSE(summary.yDepthRatio);
+}
+
+TEST(SummarizingSampleQc, HalfDepthOnChromosomeX_MaleInferred)
+{
+    SampleQcAccumulator accumulator;
+    accumulator.addRead(150);
+    addWindows(accumulator, ChromType::kAutosome, { 400, 0, 380, 420, 0 });
+    addWindows(accumulator, ChromType::kX, { 200, 190, 0, 210 });
+    addWindows(accumulator, ChromType::kY, { 200, 0, 0, 200 });
+
+    const SampleQcSummary summary = accumulator.summarize();
+    EXPECT_DOUBLE_EQ(0.5, *summary.xDepthRatio);
+    EXPECT_DOUBLE_EQ(0.25, *summary.yDepthRatio);
+    EXPECT_EQ(Sex::kMale, *summary.inferredSex);
+}
+
+TEST(SummarizingSampleQc, FullDepthOnChromosomeX_FemaleInferred)
+{
+    SampleQcAccumulator accumulator;
+    accumulator.addRead(150);
+    addWindows(accumulator, ChromType::kAutosome, { 400, 380, 420 });
+    addWindows(accumulator, ChromType::kX, { 390, 400, 410 });
+    addWindows(accumulator, ChromType::kY, { 0, 0, 4, 0 });
+
+    const SampleQcSummary summary = accumulator.summarize();
+    EXPECT_DOUBLE_EQ(1.0, *summary.xDepthRatio);
+    EXPECT_EQ(Sex::kFemale, *summary.inferredSex);
+}
+
+TEST(SummarizingSampleQc, NoCoveredWindowsOnChromosomeX_SexUndetermined)
+{
+    SampleQcAccumulator accumulator;
+    accumulator.addRead(150);
+    addWindows(accumulator, ChromType::kAutosome, { 400, 380, 420 });
+    addWindows(accumulator, ChromType::kX, { 0, 0, 0 });
+    addWindows(accumulator, ChromType::kY, { 0, 0 });
+
+    const SampleQcSummary summary = accumulator.summarize();
+    EXPECT_FALSE(summary.xDepthRatio);
+    EXPECT_DOUBLE_EQ(0.0, *summary.yDepthRatio);
+    EXPECT_FALSE(summary.inferredSex);
+}
+
+TEST(SummarizingSampleQc, NoChromosomeX_SexUndetermined)
+{
+    SampleQcAccumulator accumulator;
+    accumulator.addRead(150);
+    addWindows(accumulator, ChromType::kAutosome, { 400, 380, 420 });
+
+    const SampleQcSummary summary = accumulator.summarize();
+    EXPECT_FALSE(summary.xDepthRatio);
+    EXPECT_FALSE(summary.inferredSex);
+}
+
+TEST(SummarizingSampleQc, NoAutosomalReads_ExceptionThrown)
+{
+    SampleQcAccumulator accumulator;
+    addWindows(accumulator, ChromType::kAutosome, { 0, 0 });
+    addWindows(accumulator, ChromType::kX, { 200 });
+
+    EXPECT_THROW(accumulator.summarize(), std::runtime_error);
+}
@@ -91,3 +91,53 @@ TEST_P(AligningReads, RealReadEndingInManyLowQualityBases_Aligned)
 INSTANTIATE_TEST_CASE_P(
     AlignerTestsInst, AligningReads, ::testing::Values(std::string("path-aligner"), std::string("dag-aligner")), );
 */
+
+TEST(AligningWithoutTrimming, TypicalRead_SameAlignmentsAsGappedAligner)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATCGATCGATCGATCG(CAG)*CAACAG(CCG)*GCTAGCTAGCTAGCTA"));
+    graphtools::AlignerSelector alignerSelector(graphtools::AlignerType::DAG_ALIGNER);
+    SoftclippingAligner aligner(&graph, 14, 10, 5);
+    GappedGraphAligner gappedAligner(&graph, 14, 10, 5);
+
+    const string query = "gatcgatCGCAGCAGCAGCAACAGCCGCCGCCGGCTAGCTagcta";
+    EXPECT_EQ(gappedAligner.align(query, alignerSelector), aligner.align(query, alignerSelector));
+}
+
+TEST(AligningWithTrimming, ReadWithLowQualityEnds_EndsSoftclipped)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATCGATCGATCGATCG(CAG)*CAACAG(CCG)*GCTAGCTAGCTAGCTA"));
+    graphtools::AlignerSelector alignerSelector(graphtools::AlignerType::DAG_ALIGNER);
+    SoftclippingAligner aligner(&graph, 14, 10, 5, true);
+
+    // The low-quality ends do not match the flanks
+    const string query = "ttgcaggtacATCGATCGCAGCAGCAGCAACAGCCGCCGCCGGCTAGCTAccgtgtacca";
+    const list<GraphAlignment> expectedAlignments
+        = { decodeGraphAlignment(8, "0[10S8M]1[3M]1[3M]1[3M]2[6M]3[3M]3[3M]3[3M]4[8M10S]", &graph) };
+    EXPECT_EQ(expectedAlignments, aligner.align(query, alignerSelector));
+}
+
+TEST(AligningWithTrimming, HighQualityReads_SameAlignmentsAsWithoutTrimming)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATCGATCGATCGATCG(CAG)*CAACAG(CCG)*GCTAGCTAGCTAGCTA"));
+    graphtools::AlignerSelector alignerSelector(graphtools::AlignerType::DAG_ALIGNER);
+    SoftclippingAligner trimmingAligner(&graph, 14, 10, 5, true);
+    SoftclippingAligner aligner(&graph, 14, 10, 5);
+
+    const list<string> queries = { "ATCGATCGCAGCAGCAGCAACAGCCGCCGCCGGCTAGCTA", "CGATCGATCGCAGCAGCAGCAGCAG",
+                                   "CCGCCGCCGCCGCCGCCGGCTAGCTAGCTA", "ATCGATCGCAGCAGCtGCAACAGCCGCCGCCGGCTAGCTA" };
+    for (const auto& query : queries)
+    {
+        EXPECT_EQ(aligner.align(query, alignerSelector), trimmingAligner.align(query, alignerSelector)) << query;
+    }
+}
+
+TEST(AligningWithTrimming, ShortHighQualityCore_ReadAlignedInFull)
+{
+    Graph graph = makeRegionGraph(decodeFeaturesFromRegex("ATCGATCGATCGATCG(CAG)*CAACAG(CCG)*GCTAGCTAGCTAGCTA"));
+    graphtools::AlignerSelector alignerSelector(graphtools::AlignerType::DAG_ALIGNER);
+    SoftclippingAligner trimmingAligner(&graph, 14, 10, 5, true);
+    SoftclippingAligner aligner(&graph, 14, 10, 5);
+
+    const string query = "atcgatcgCAGCAGcagcaacagccg";
+    EXPECT_EQ(aligner.align(query, alignerSelector), trimmingAligner.align(query, alignerSelector));
+}
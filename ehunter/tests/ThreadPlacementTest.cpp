@@ -0,0 +1,101 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "core/ThreadPlacement.hh"
+
+#include "gtest/gtest.h"
+
+using namespace ehunter;
+
+using std::vector;
+
+TEST(ParsingCpuLists, TypicalLists_Parsed)
+{
+    EXPECT_EQ(vector<int>({ 0, 1, 2, 3, 8, 10, 11 }), parseCpuList("0-3,8,10-11\n"));
+    EXPECT_EQ(vector<int>({ 5 }), parseCpuList("5"));
+    EXPECT_TRUE(parseCpuList("").empty());
+}
+
+TEST(ParsingCpuLists, MalformedLists_ExceptionThrown)
+{
+    EXPECT_THROW(parseCpuList("0-"), std::invalid_argument);
+    EXPECT_THROW(parseCpuList("3-1"), std::invalid_argument);
+    EXPECT_THROW(parseCpuList("a,b"), std::invalid_argument);
+    EXPECT_THROW(parseCpuList("1-2-3"), std::invalid_argument);
+}
+
+TEST(PlacingThreads, UnpinnedThreads_SingleDomain)
+{
+    const ThreadPlacement placement(4);
+    EXPECT_EQ(1, placement.domainCount());
+    EXPECT_EQ(4, placement.threadCountOfDomain(0));
+    EXPECT_EQ(-1, placement.cpuOfThread(3));
+}
+
+TEST(PlacingThreads, TwoEqualNodes_ThreadsSplitEvenly)
+{
+    const CpuTopology topology({ { 0, 1, 2, 3 }, { 4, 5, 6, 7 } });
+    const ThreadPlacement placement(6, topology);
+
+    ASSERT_EQ(2, placement.domainCount());
+    EXPECT_EQ(0, placement.firstThreadOfDomain(0));
+    EXPECT_EQ(3, placement.threadCountOfDomain(0));
+    EXPECT_EQ(3, placement.firstThreadOfDomain(1));
+    EXPECT_EQ(3, placement.threadCountOfDomain(1));
+
+    const vector<int> expectedCpus = { 0, 1, 2, 4, 5, 6 };
+    for (int threadIndex = 0; threadIndex != 6; ++threadIndex)
+    {
+        EXPECT_EQ(expectedCpus[threadIndex], placement.cpuOfThread(threadIndex));
+    }
+}
+
+TEST(PlacingThreads, UnequalNodes_ThreadsSplitByNodeSize)
+{
+    const CpuTopology topology({ { 0 }, {}, { 1, 2, 3 } });
+    const ThreadPlacement placement(4, topology);
+
+    ASSERT_EQ(2, placement.domainCount());
+    EXPECT_EQ(1, placement.threadCountOfDomain(0));
+    EXPECT_EQ(3, placement.threadCountOfDomain(1));
+}
+
+TEST(PlacingThreads, MoreThreadsThanCpus_CpusShared)
+{
+    const CpuTopology topology({ { 0, 1 } });
+    const ThreadPlacement placement(3, topology);
+
+    ASSERT_EQ(1, placement.domainCount());
+    EXPECT_EQ(0, placement.cpuOfThread(2));
+}
+
+TEST(PlacingThreads, FewerThreadsThanNodes_EmptyDomainsDropped)
+{
+    const CpuTopology topology({ { 0, 1 }, { 2, 3 }, { 4, 5 } });
+    const ThreadPlacement placement(2, topology);
+    EXPECT_EQ(2, placement.domainCount());
+}
+
+TEST(DetectingCpuTopology, CurrentMachine_CpusFound)
+{
+    const CpuTopology topology = CpuTopology::detect();
+    ASSERT_FALSE(topology.nodeCpus().empty());
+    EXPECT_FALSE(topology.nodeCpus().front().empty());
+}
@@ -0,0 +1,119 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "sample/UnmappedIrrScreen.hh"
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using namespace ehunter;
+
+using std::string;
+using std::vector;
+
+static LocusSpecification
+buildLocusSpec(const string& locusId, const string& structure, VariantSubtype subtype, int32_t contigIndex)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex(structure));
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    LocusSpecification locusSpec(
+        locusId, ChromType::kAutosome, { GenomicRegion(contigIndex, 0, 1000) }, graph, dummyAssociation, params,
+        false);
+    VariantClassification classification(VariantType::kRepeat, subtype);
+    locusSpec.addVariantSpecification("repeat", classification, GenomicRegion(contigIndex, 500, 510), { 1 }, 1);
+    return locusSpec;
+}
+
+static RegionCatalog buildCatalog()
+{
+    RegionCatalog catalog;
+    catalog.push_back(buildLocusSpec("common", "ATTCGA(CAG)*ATGTCG", VariantSubtype::kCommonRepeat, 0));
+    catalog.push_back(buildLocusSpec("rare1", "ATTCGA(AAGGG)*ATGTCG", VariantSubtype::kRareRepeat, 1));
+    catalog.push_back(buildLocusSpec("rare2", "ATTCGA(AAGGG)*ATGTCG", VariantSubtype::kRareRepeat, 2));
+    catalog.push_back(buildLocusSpec("rare3", "ATTCGA(CCG)*ATGTCG", VariantSubtype::kRareRepeat, 3));
+    return catalog;
+}
+
+static string repeat(const string& unit, int length)
+{
+    string sequence;
+    while (static_cast<int>(sequence.length()) < length)
+    {
+        sequence += unit;
+    }
+    sequence.resize(length);
+    return sequence;
+}
+
+TEST(ScreeningUnmappedReads, TypicalCatalog_RareRepeatLociTargeted)
+{
+    const UnmappedIrrScreen screen(buildCatalog());
+    EXPECT_FALSE(screen.empty());
+    EXPECT_EQ(vector<unsigned>({ 1, 2, 3 }), screen.targetLoci());
+}
+
+TEST(ScreeningUnmappedReads, InrepeatPairOnEitherStrand_MatchingLociFound)
+{
+    const UnmappedIrrScreen screen(buildCatalog());
+
+    const string read = repeat("GGGAA", 150);
+    const string mate = repeat("CCCTT", 150);
+    EXPECT_TRUE(screen.isCandidateRead(read));
+    EXPECT_EQ(vector<unsigned>({ 1, 2 }), screen.findCandidateLoci(read, mate));
+    EXPECT_EQ(vector<unsigned>({ 3 }), screen.findCandidateLoci(repeat("CGG", 150), repeat("GCC", 100)));
+}
+
+TEST(ScreeningUnmappedReads, ImpureOrMixedPairs_NoLociFound)
+{
+    const UnmappedIrrScreen screen(buildCatalog());
+
+    const string irr = repeat("AAGGG", 150);
+    const string nonRepeatRead = "ATGCTTGACCATGGTCAGTTACGGATCCAAGTGGCTAGCATTGACGTAGCATCGATGGCAATCTGAC";
+    EXPECT_FALSE(screen.isCandidateRead(nonRepeatRead));
+    EXPECT_FALSE(screen.isCandidateRead(repeat("CAG", 150)));
+    EXPECT_TRUE(screen.findCandidateLoci(irr, nonRepeatRead).empty());
+    EXPECT_TRUE(screen.findCandidateLoci(irr, repeat("CCG", 150)).empty());
+}
+
+TEST(ScreeningUnmappedReads, InrepeatReadWithErrors_ReadPassesScreen)
+{
+    const UnmappedIrrScreen screen(buildCatalog());
+
+    string read = repeat("AAGGG", 150);
+    for (int position = 7; position < 150; position += 20)
+    {
+        read[position] = 'T';
+    }
+    read[60] = 'N';
+    read[100] = 'g';
+    EXPECT_TRUE(screen.isCandidateRead(read));
+}
+
+TEST(ScreeningUnmappedReads, CatalogWithoutRareRepeats_ScreenEmpty)
+{
+    RegionCatalog catalog;
+    catalog.push_back(buildLocusSpec("common", "ATTCGA(CAG)*ATGTCG", VariantSubtype::kCommonRepeat, 0));
+    const UnmappedIrrScreen screen(catalog);
+    EXPECT_TRUE(screen.empty());
+    EXPECT_TRUE(screen.findCandidateLoci(repeat("CAG", 150), repeat("CAG", 150)).empty());
+}
@@ -0,0 +1,112 @@
+//
+// ExpansionHunter
+// Copyright 2016-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+
+#include "io/VariantRecordTemplates.hh"
+
+#include "gtest/gtest.h"
+
+#include "io/GraphBlueprint.hh"
+#include "io/RegionGraph.hh"
+
+using namespace ehunter;
+
+using std::string;
+
+namespace
+{
+
+// Reference consisting of a single contig with a fixed sequence
+class SingleContigReference : public Reference
+{
+public:
+    explicit SingleContigReference(string sequence)
+        : sequence_(std::move(sequence))
+        , contigInfo_({ { "chr1", static_cast<int64_t>(sequence_.length()) } })
+    {
+    }
+
+    string getSequence(const string&, int64_t start, int64_t end) const override
+    {
+        return sequence_.substr(start, end - start);
+    }
+
+    string getSequence(const GenomicRegion& region) const override
+    {
+        return getSequence("chr1", region.start(), region.end());
+    }
+
+    const ReferenceContigInfo& contigInfo() const override { return contigInfo_; }
+
+private:
+    string sequence_;
+    ReferenceContigInfo contigInfo_;
+};
+
+LocusSpecification makeLocusSpec(const string& locusId, const string& structure)
+{
+    auto graph = makeRegionGraph(decodeFeaturesFromRegex(structure));
+    NodeToRegionAssociation dummyAssociation;
+    GenotyperParameters params(10);
+    return LocusSpecification(
+        locusId, ChromType::kAutosome, { GenomicRegion(0, 0, 20) }, graph, dummyAssociation, params, false);
+}
+
+}
+
+TEST(RenderingRecordTemplates, RepeatVariant_StaticFieldsRendered)
+{
+    SingleContigReference reference("AAAAAGCAGCAGCAGTTTTT");
+    LocusSpecification locusSpec = makeLocusSpec("locus", "AAAAA(GCA)*GTTTTT");
+    VariantClassification classification(VariantType::kRepeat, VariantSubtype::kCommonRepeat);
+    locusSpec.addVariantSpecification("repeat", classification, GenomicRegion(0, 5, 14), { 1 }, boost::none);
+
+    const VariantRecordTemplates recordTemplates(reference, { locusSpec });
+    const VariantRecordTemplate& recordTemplate = recordTemplates.get("locus", "repeat");
+
+    EXPECT_EQ("chr1\t5\t.\tA", recordTemplate.vcfLeadingColumns);
+    EXPECT_EQ("END=14;REF=3;RL=9;RU=GCA;VARID=repeat;REPID=repeat", recordTemplate.vcfInfoColumn);
+    EXPECT_EQ(3, recordTemplate.referenceSizeInUnits);
+    EXPECT_EQ("chr1:5-14", recordTemplate.jsonRecord["ReferenceRegion"]);
+    EXPECT_EQ("GCA", recordTemplate.jsonRecord["RepeatUnit"]);
+    EXPECT_EQ("repeat", recordTemplate.jsonRecord["VariantId"]);
+}
+
+TEST(RenderingRecordTemplates, DeletionVariant_RefAndAltColumnsIncludeFlankingBase)
+{
+    SingleContigReference reference("AAAAAGCAGCAGCAGTTTTT");
+    LocusSpecification locusSpec = makeLocusSpec("locus", "AAAAA(GCA)?GCAGCAGTTTTT");
+    VariantClassification classification(VariantType::kSmallVariant, VariantSubtype::kDeletion);
+    locusSpec.addVariantSpecification("deletion", classification, GenomicRegion(0, 5, 8), { 1 }, 1);
+
+    const VariantRecordTemplates recordTemplates(reference, { locusSpec });
+    const VariantRecordTemplate& recordTemplate = recordTemplates.get("locus", "deletion");
+
+    EXPECT_EQ("chr1\t5\t.\tAGCA", recordTemplate.vcfLeadingColumns);
+    EXPECT_EQ("A", recordTemplate.vcfAltColumn);
+    EXPECT_EQ("VARID=deletion", recordTemplate.vcfInfoColumn);
+    EXPECT_EQ("SmallVariant", recordTemplate.jsonRecord["VariantType"]);
+}
+
+TEST(RenderingRecordTemplates, VariantAbsentFromCatalog_ExceptionThrown)
+{
+    SingleContigReference reference("AAAAAGCAGCAGCAGTTTTT");
+    const VariantRecordTemplates recordTemplates(reference, {});
+    EXPECT_ANY_THROW(recordTemplates.get("locus", "repeat"));
+}
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "graphalign/LinearAlignment.hh"
+#include "graphalign/ValidationLevel.hh"
 #include "graphcore/Graph.hh"
 #include "graphcore/Path.hh"
 
@@ -50,7 +51,10 @@ public:
         : path_(path)
         , alignments_(alignments)
     {
-        assertValidity();
+        if (shouldValidate())
+        {
+            assertValidity();
+        }
     }
 
     uint32_t queryLength() const;
@@ -85,8 +89,10 @@ public:
 
     friend std::ostream& operator<<(std::ostream& os, const GraphAlignment& graph_alignment);
 
-private:
+    // Throws if the path is incompatible with the node alignments; performed on construction at full validation level
     void assertValidity() const;
+
+private:
     Path path_;
     std::vector<Alignment> alignments_;
 };
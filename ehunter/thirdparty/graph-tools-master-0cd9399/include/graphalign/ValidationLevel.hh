@@ -0,0 +1,47 @@
+//
+// GraphTools library
+// Copyright 2017-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+namespace graphtools
+{
+/**
+ * Controls how often internal consistency checks run on the alignment hot path
+ *
+ * These checks verify invariants that hold for any correct aligner (e.g. that an extension agrees with the sequence
+ * of its path), so they only detect programming errors. Full validation runs every check, sampled validation runs
+ * every 64th check on each thread, and no checks run when validation is off.
+ *
+ * The level in effect at startup is full unless the library is built with GRAPHTOOLS_VALIDATION_LEVEL defined as
+ * 0 (off), 1 (sampled), or 2 (full).
+ */
+enum class ValidationLevel
+{
+    kOff,
+    kSampled,
+    kFull
+};
+
+// Sets the process-wide validation level; thread safe
+void setValidationLevel(ValidationLevel level);
+
+ValidationLevel getValidationLevel();
+
+// Returns true if the next consistency check should be performed at the current validation level
+bool shouldValidate();
+}
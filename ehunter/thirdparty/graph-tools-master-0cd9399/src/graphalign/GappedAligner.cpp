@@ -29,6 +29,7 @@
 
 #include "graphalign/GraphAlignmentOperations.hh"
 #include "graphalign/LinearAlignmentOperations.hh"
+#include "graphalign/ValidationLevel.hh"
 #include "graphcore/PathOperations.hh"
 
 using boost::optional;
@@ -311,7 +312,7 @@ list<PathAndAlignment> GappedGraphAligner::extendAlignmentPrefix(
         const int32_t overhang = path.length() - alignment.referenceLength();
         path.shrinkStartBy(overhang);
 
-        if (!checkConsistency(path_and_alignment.second, path.seq(), query_piece))
+        if (shouldValidate() && !checkConsistency(path_and_alignment.second, path.seq(), query_piece))
         {
             throw std::logic_error("Inconsistent prefix");
         }
@@ -331,7 +332,8 @@ list<PathAndAlignment> GappedGraphAligner::extendAlignmentSuffix(
 
     for (PathAndAlignment& path_and_alignment : top_paths_and_alignments)
     {
-        if (!checkConsistency(path_and_alignment.second, path_and_alignment.first.seq(), query_piece))
+        if (shouldValidate()
+            && !checkConsistency(path_and_alignment.second, path_and_alignment.first.seq(), query_piece))
         {
             throw std::logic_error("Inconsistent suffix");
         }
@@ -137,7 +137,10 @@ GraphAlignment decodeGraphAlignment(int32_t first_node_start, const string& grap
     // Convert to 0-based coordinates
     int32_t last_node_end = alignments.back().referenceStart() + alignments.back().referenceLength();
     Path path(graph_ptr, first_node_start, node_ids, last_node_end);
-    return GraphAlignment(path, alignments);
+    GraphAlignment graph_alignment(path, alignments);
+    // Decoded alignments do not come from the aligner, so they are validated regardless of the validation level
+    graph_alignment.assertValidity();
+    return graph_alignment;
 }
 
 void splitNodeCigar(const string& node_cigar, string& cigar, NodeId& node_id)
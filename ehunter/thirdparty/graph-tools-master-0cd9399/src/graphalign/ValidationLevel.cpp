@@ -0,0 +1,68 @@
+//
+// GraphTools library
+// Copyright 2017-2021 Illumina, Inc.
+// All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "graphalign/ValidationLevel.hh"
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef GRAPHTOOLS_VALIDATION_LEVEL
+#define GRAPHTOOLS_VALIDATION_LEVEL 2
+#endif
+
+namespace graphtools
+{
+namespace
+{
+static_assert(
+    GRAPHTOOLS_VALIDATION_LEVEL >= 0 && GRAPHTOOLS_VALIDATION_LEVEL <= 2,
+    "GRAPHTOOLS_VALIDATION_LEVEL must be 0 (off), 1 (sampled), or 2 (full)");
+
+std::atomic<ValidationLevel> validation_level(static_cast<ValidationLevel>(GRAPHTOOLS_VALIDATION_LEVEL));
+
+const uint32_t kSamplingPeriod = 64;
+}
+
+void setValidationLevel(ValidationLevel level)
+{
+    validation_level.store(level, std::memory_order_relaxed);
+}
+
+ValidationLevel getValidationLevel()
+{
+    return validation_level.load(std::memory_order_relaxed);
+}
+
+bool shouldValidate()
+{
+    switch (validation_level.load(std::memory_order_relaxed))
+    {
+    case ValidationLevel::kOff:
+        return false;
+    case ValidationLevel::kSampled:
+    {
+        thread_local uint32_t check_count = 0;
+        return check_count++ % kSamplingPeriod == 0;
+    }
+    case ValidationLevel::kFull:
+        return true;
+    }
+
+    return true;
+}
+}